@@ -0,0 +1,1093 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#  define _DEFAULT_SOURCE
+#endif
+#if defined(_MSC_VER) && !defined(_CRT_SECURE_NO_WARNINGS)
+#  define _CRT_SECURE_NO_WARNINGS /* fopen, gmtime, and strncpy are used portably. */
+#endif
+
+#include "classical_rng.h"
+#include "classical_rng/game_rng_inline.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <sys/utsname.h>
+#  include <unistd.h>
+#endif
+#if defined(__linux__)
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  define CRNG_BENCH_HAVE_PERF 1
+#endif
+
+#ifndef CRNG_BENCH_REVISION
+#  define CRNG_BENCH_REVISION "unknown"
+#endif
+#ifndef CRNG_BENCH_BUILD
+#  define CRNG_BENCH_BUILD "unknown"
+#endif
+
+#define CRNG_BENCH_INPUTS 1024U
+#define CRNG_BENCH_MAX_TRIALS 101U
+#define CRNG_BENCH_PRIME_ATTEMPTS UINT64_C(100000)
+#define CRNG_BENCH_PERF_MAX 6U
+
+/*
+ * One throughput case. The body performs `iterations` operations and returns
+ * a value derived from every result, which the harness folds into a volatile
+ * sink so no generation can be optimized away.
+ */
+typedef struct crng_bench_case {
+    const char *family;
+    const char *name;
+    uint64_t parameter;
+    uint64_t bytes_per_op;
+    uint64_t (*body)(const struct crng_bench_case *bench, uint64_t iterations);
+} crng_bench_case;
+
+/* One latency-distribution case: each call is timed individually. */
+typedef struct crng_bench_latency_case {
+    const char *name;
+    const char *method;
+    crng_u128 minimum;
+    crng_u128 maximum;
+} crng_bench_latency_case;
+
+typedef struct crng_bench_options {
+    unsigned int trials;
+    uint64_t target_ns;
+    uint64_t latency_calls;
+    const char *filter;
+    int perf;
+    const char *perf_raw_name;
+    uint64_t perf_raw_config;
+} crng_bench_options;
+
+/*
+ * Optional hardware counters, opened as one perf_event_open group so every
+ * member counts over the same interval. Counters that cannot be opened are
+ * reported with their reason and the remaining ones still run.
+ */
+typedef struct crng_bench_perf {
+    size_t count;
+    int descriptors[CRNG_BENCH_PERF_MAX];
+    const char *names[CRNG_BENCH_PERF_MAX];
+    size_t missing_count;
+    const char *missing[CRNG_BENCH_PERF_MAX];
+    /* Copied, since the next strerror call may reuse its buffer. */
+    char reasons[CRNG_BENCH_PERF_MAX][128];
+} crng_bench_perf;
+
+static volatile uint64_t crng_bench_sink;
+static crng_status crng_bench_failure = CRNG_OK;
+static crng_game_rng crng_bench_rng;
+static unsigned char crng_bench_buffer[1U << 16];
+static char crng_bench_uuid_text[1024U * CRNG_UUID_STRING_LENGTH];
+static uint64_t crng_bench_values[CRNG_BENCH_INPUTS];
+static bool crng_bench_flags[CRNG_BENCH_INPUTS];
+static uint64_t crng_bench_prime_u32[CRNG_BENCH_INPUTS];
+static uint64_t crng_bench_prime_u64[CRNG_BENCH_INPUTS];
+static uint64_t crng_bench_odd_u64[CRNG_BENCH_INPUTS];
+static crng_u128 crng_bench_prime_u128[64];
+static crng_bench_perf crng_bench_counters;
+
+/* Strong base-2 pseudoprimes: the slowest composites for the exact test. */
+static const uint64_t crng_bench_pseudoprimes[] = {
+    UINT64_C(3215031751), UINT64_C(2152302898747), UINT64_C(3474749660383),
+    UINT64_C(341550071728321), UINT64_C(3825123056546413051)
+};
+
+static uint64_t crng_bench_now_ns(void) {
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)counter.QuadPart / (uint64_t)frequency.QuadPart * UINT64_C(1000000000) +
+           (uint64_t)counter.QuadPart % (uint64_t)frequency.QuadPart * UINT64_C(1000000000) /
+               (uint64_t)frequency.QuadPart;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * UINT64_C(1000000000) + (uint64_t)now.tv_nsec;
+#endif
+}
+
+static uint64_t crng_bench_timer_resolution_ns(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER frequency;
+
+    QueryPerformanceFrequency(&frequency);
+    return (UINT64_C(1000000000) + (uint64_t)frequency.QuadPart - 1U) /
+           (uint64_t)frequency.QuadPart;
+#else
+    struct timespec resolution;
+
+    if (clock_getres(CLOCK_MONOTONIC, &resolution) != 0) {
+        return 0;
+    }
+    return (uint64_t)resolution.tv_sec * UINT64_C(1000000000) + (uint64_t)resolution.tv_nsec;
+#endif
+}
+
+static void crng_bench_fail(crng_status status) {
+    if (crng_bench_failure == CRNG_OK) {
+        crng_bench_failure = status;
+    }
+}
+
+/* Harness baseline: the loop and sink with no generator call. */
+static uint64_t crng_bench_empty(const crng_bench_case *bench, uint64_t iterations) {
+    uint64_t checksum = 0;
+    uint64_t index;
+
+    (void)bench;
+    for (index = 0; index < iterations; ++index) {
+        checksum += index ^ crng_bench_sink;
+    }
+    return checksum;
+}
+
+static uint64_t crng_bench_next_u64(const crng_bench_case *bench, uint64_t iterations) {
+    uint64_t checksum = 0;
+    uint64_t index;
+
+    (void)bench;
+    for (index = 0; index < iterations; ++index) {
+        checksum ^= crng_game_rng_next_u64(&crng_bench_rng);
+    }
+    return checksum;
+}
+
+/* The parameter is a crng_game_rng_algorithm; each tier keeps its own stream. */
+static uint64_t crng_bench_next_u64_tier(const crng_bench_case *bench, uint64_t iterations) {
+    static crng_game_rng tiers[4];
+    crng_game_rng *rng = &tiers[bench->parameter & 3U];
+    uint64_t checksum = 0;
+    uint64_t index;
+
+    if (rng->algorithm != (crng_game_rng_algorithm)bench->parameter) {
+        (void)crng_game_rng_seed_algorithm(
+            rng, UINT64_C(1), (crng_game_rng_algorithm)bench->parameter);
+    }
+    for (index = 0; index < iterations; ++index) {
+        checksum ^= crng_game_rng_next_u64(rng);
+    }
+    return checksum;
+}
+
+static uint64_t crng_bench_fill(const crng_bench_case *bench, uint64_t iterations) {
+    const size_t size = (size_t)bench->parameter;
+    uint64_t checksum = 0;
+    uint64_t index;
+
+    for (index = 0; index < iterations; ++index) {
+        crng_status status = crng_game_rng_fill(&crng_bench_rng, crng_bench_buffer, size);
+        if (status != CRNG_OK) {
+            crng_bench_fail(status);
+            break;
+        }
+        checksum += crng_bench_buffer[0] ^ crng_bench_buffer[size - 1U];
+    }
+    return checksum;
+}
+
+static uint64_t crng_bench_uniform_u64(const crng_bench_case *bench, uint64_t iterations) {
+    uint64_t checksum = 0;
+    uint64_t index;
+    uint64_t value;
+
+    for (index = 0; index < iterations; ++index) {
+        crng_status status =
+            crng_game_rng_uniform_u64(&crng_bench_rng, bench->parameter, &value);
+        if (status != CRNG_OK) {
+            crng_bench_fail(status);
+            break;
+        }
+        checksum ^= value;
+    }
+    return checksum;
+}
+
+/* The parameter selects a compile-time bound; the loop body has no division. */
+static uint64_t crng_bench_uniform_constant(const crng_bench_case *bench, uint64_t iterations) {
+    uint64_t checksum = 0;
+    uint64_t index;
+
+    for (index = 0; index < iterations; ++index) {
+        checksum ^= bench->parameter == 6U
+                        ? CRNG_GAME_RNG_UNIFORM_CONSTANT(&crng_bench_rng, 6U)
+                        : CRNG_GAME_RNG_UNIFORM_CONSTANT(&crng_bench_rng, 52U);
+    }
+    return checksum;
+}
+
+static uint64_t crng_bench_secure_bytes(const crng_bench_case *bench, uint64_t iterations) {
+    const size_t size = (size_t)bench->parameter;
+    uint64_t checksum = 0;
+    uint64_t index;
+
+    for (index = 0; index < iterations; ++index) {
+        crng_status status = crng_secure_bytes(crng_bench_buffer, size);
+        if (status != CRNG_OK) {
+            crng_bench_fail(status);
+            break;
+        }
+        checksum += crng_bench_buffer[0] ^ crng_bench_buffer[size - 1U];
+    }
+    return checksum;
+}
+
+static uint64_t crng_bench_secure_uniform_u64(
+    const crng_bench_case *bench,
+    uint64_t iterations
+) {
+    uint64_t checksum = 0;
+    uint64_t index;
+    uint64_t value;
+
+    for (index = 0; index < iterations; ++index) {
+        crng_status status = crng_secure_uniform_u64(bench->parameter, &value);
+        if (status != CRNG_OK) {
+            crng_bench_fail(status);
+            break;
+        }
+        checksum ^= value;
+    }
+    return checksum;
+}
+
+/* Parameter selects version 4 or 7; each operation is one 1024-UUID batch. */
+static uint64_t crng_bench_uuid(const crng_bench_case *bench, uint64_t iterations) {
+    uint64_t checksum = 0;
+    uint64_t index;
+
+    for (index = 0; index < iterations; ++index) {
+        crng_status status = bench->parameter == 4U
+            ? crng_secure_uuid_v4_array(crng_bench_buffer, 1024U)
+            : crng_secure_uuid_v7_array(crng_bench_buffer, 1024U);
+        if (status != CRNG_OK) {
+            crng_bench_fail(status);
+            break;
+        }
+        checksum += crng_bench_buffer[15] ^ crng_bench_buffer[1024U * CRNG_UUID_BYTES - 1U];
+    }
+    return checksum;
+}
+
+static uint64_t crng_bench_uuid_format(const crng_bench_case *bench, uint64_t iterations) {
+    uint64_t checksum = 0;
+    uint64_t index;
+
+    (void)bench;
+    for (index = 0; index < iterations; ++index) {
+        crng_bench_buffer[index % (1024U * CRNG_UUID_BYTES)] ^= (unsigned char)index;
+        (void)crng_uuid_format_array(crng_bench_buffer, crng_bench_uuid_text, 1024U);
+        checksum += (unsigned char)crng_bench_uuid_text[index % sizeof(crng_bench_uuid_text)];
+    }
+    return checksum;
+}
+
+/* Primality cases cycle through a precomputed input class. */
+static uint64_t crng_bench_is_prime(const crng_bench_case *bench, uint64_t iterations) {
+    const uint64_t *inputs;
+    uint64_t count = CRNG_BENCH_INPUTS;
+    uint64_t checksum = 0;
+    uint64_t index;
+
+    switch (bench->parameter) {
+    case 0:
+        inputs = crng_bench_prime_u32;
+        break;
+    case 1:
+        inputs = crng_bench_prime_u64;
+        break;
+    case 2:
+        inputs = crng_bench_odd_u64;
+        break;
+    default:
+        inputs = crng_bench_pseudoprimes;
+        count = sizeof(crng_bench_pseudoprimes) / sizeof(crng_bench_pseudoprimes[0]);
+        break;
+    }
+    for (index = 0; index < iterations; ++index) {
+        checksum += crng_crypto_is_prime_u64(inputs[index % count]) ? index : 1U;
+    }
+    return checksum;
+}
+
+static uint64_t crng_bench_is_prime_array(const crng_bench_case *bench, uint64_t iterations) {
+    uint64_t checksum = 0;
+    uint64_t index;
+
+    (void)bench;
+    memcpy(crng_bench_values, crng_bench_odd_u64, sizeof(crng_bench_values));
+    for (index = 0; index < iterations; index += CRNG_BENCH_INPUTS) {
+        const uint64_t remaining = iterations - index;
+        const size_t count =
+            remaining < CRNG_BENCH_INPUTS ? (size_t)remaining : CRNG_BENCH_INPUTS;
+        crng_status status =
+            crng_crypto_is_prime_u64_array(crng_bench_values, crng_bench_flags, count);
+
+        if (status != CRNG_OK) {
+            crng_bench_fail(status);
+            break;
+        }
+        checksum += crng_bench_flags[count - 1U] ? index : 1U;
+    }
+    return checksum;
+}
+
+static uint64_t crng_bench_is_prime_u128(const crng_bench_case *bench, uint64_t iterations) {
+    const size_t count = sizeof(crng_bench_prime_u128) / sizeof(crng_bench_prime_u128[0]);
+    uint64_t checksum = 0;
+    uint64_t index;
+
+    (void)bench;
+    for (index = 0; index < iterations; ++index) {
+        checksum += crng_crypto_is_prime_u128(crng_bench_prime_u128[index % count]) ? index : 1U;
+    }
+    return checksum;
+}
+
+static const crng_bench_case crng_bench_cases[] = {
+    {"harness", "empty_loop", 0, 0, crng_bench_empty},
+    {"next_u64", "next_u64", 0, 8, crng_bench_next_u64},
+    {"next_u64", "next_u64/roundoff-18", CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_18, 8,
+     crng_bench_next_u64_tier},
+    {"next_u64", "next_u64/xoshiro256**", CRNG_GAME_RNG_ALGORITHM_XOSHIRO256SS, 8,
+     crng_bench_next_u64_tier},
+    {"fill", "fill/8", 8, 8, crng_bench_fill},
+    {"fill", "fill/61", 61, 61, crng_bench_fill},
+    {"fill", "fill/4096", 4096, 4096, crng_bench_fill},
+    {"fill", "fill/65536", 65536, 65536, crng_bench_fill},
+    {"uniform_u64", "uniform_u64/1", 1, 0, crng_bench_uniform_u64},
+    {"uniform_u64", "uniform_u64/6", 6, 0, crng_bench_uniform_u64},
+    {"uniform_u64", "uniform_u64/2^32", UINT64_C(1) << 32, 0, crng_bench_uniform_u64},
+    {"uniform_u64", "uniform_u64/2^63", UINT64_C(1) << 63, 0, crng_bench_uniform_u64},
+    {"uniform_u64", "uniform_u64/2^63+1", (UINT64_C(1) << 63) + 1U, 0, crng_bench_uniform_u64},
+    {"uniform_u64", "uniform_u64/52", 52, 0, crng_bench_uniform_u64},
+    {"uniform_u64", "uniform_constant/6", 6, 0, crng_bench_uniform_constant},
+    {"uniform_u64", "uniform_constant/52", 52, 0, crng_bench_uniform_constant},
+    {"secure_bytes", "secure_bytes/16", 16, 16, crng_bench_secure_bytes},
+    {"secure_bytes", "secure_bytes/32", 32, 32, crng_bench_secure_bytes},
+    {"secure_bytes", "secure_bytes/256", 256, 256, crng_bench_secure_bytes},
+    {"secure_bytes", "secure_bytes/4096", 4096, 4096, crng_bench_secure_bytes},
+    {"secure_bytes", "secure_bytes/65536", 65536, 65536, crng_bench_secure_bytes},
+    {"secure_uniform_u64", "secure_uniform_u64/6", 6, 0, crng_bench_secure_uniform_u64},
+    {"secure_uniform_u64", "secure_uniform_u64/2^63+1", (UINT64_C(1) << 63) + 1U, 0,
+     crng_bench_secure_uniform_u64},
+    {"uuid", "uuid_v4_array/1024", 4, 1024U * CRNG_UUID_BYTES, crng_bench_uuid},
+    {"uuid", "uuid_v7_array/1024", 7, 1024U * CRNG_UUID_BYTES, crng_bench_uuid},
+    {"uuid", "uuid_format_array/1024", 0, 1024U * CRNG_UUID_STRING_LENGTH,
+     crng_bench_uuid_format},
+    {"primality", "is_prime_u64/prime_below_2^32", 0, 0, crng_bench_is_prime},
+    {"primality", "is_prime_u64/prime_near_2^64", 1, 0, crng_bench_is_prime},
+    {"primality", "is_prime_u64/random_odd_u64", 2, 0, crng_bench_is_prime},
+    {"primality", "is_prime_u64/strong_pseudoprime", 3, 0, crng_bench_is_prime},
+    {"primality", "is_prime_u64_array/random_odd_u64", 0, 0, crng_bench_is_prime_array},
+    {"primality", "is_prime_u128/prime_near_2^128", 0, 0, crng_bench_is_prime_u128}
+};
+
+static const crng_bench_latency_case crng_bench_latency_cases[] = {
+    {"random_prime/uniform/[2^32,2^33]", "uniform",
+     {UINT64_C(1) << 32, 0}, {UINT64_C(1) << 33, 0}},
+    {"random_prime/sieved/[2^32,2^33]", "sieved",
+     {UINT64_C(1) << 32, 0}, {UINT64_C(1) << 33, 0}},
+    {"random_prime/uniform/[2^63,2^64)", "uniform",
+     {UINT64_C(1) << 63, 0}, {UINT64_MAX, 0}},
+    {"random_prime/sieved/[2^63,2^64)", "sieved",
+     {UINT64_C(1) << 63, 0}, {UINT64_MAX, 0}},
+    {"random_prime/safe/[2^63,2^64)", "safe",
+     {UINT64_C(1) << 63, 0}, {UINT64_MAX, 0}},
+    {"random_prime/uniform/[2^127,2^128)", "uniform_u128",
+     {0, UINT64_C(1) << 63}, {UINT64_MAX, UINT64_MAX}}
+};
+
+/* Deterministic inputs so every run classifies the same values. */
+static void crng_bench_prepare_inputs(void) {
+    crng_game_rng inputs;
+    size_t index;
+
+    crng_game_rng_seed(&inputs, UINT64_C(0x62656e6368));
+    for (index = 0; index < CRNG_BENCH_INPUTS; ++index) {
+        uint64_t value = (crng_game_rng_next_u64(&inputs) >> 32) | 1U;
+
+        while (!crng_crypto_is_prime_u64(value)) {
+            value += 2U;
+        }
+        crng_bench_prime_u32[index] = value;
+
+        value = crng_game_rng_next_u64(&inputs) | (UINT64_C(1) << 63) | 1U;
+        crng_bench_odd_u64[index] = value;
+        while (value < UINT64_MAX - 2U && !crng_crypto_is_prime_u64(value)) {
+            value += 2U;
+        }
+        crng_bench_prime_u64[index] = value;
+    }
+    for (index = 0; index < sizeof(crng_bench_prime_u128) / sizeof(crng_bench_prime_u128[0]);
+         ++index) {
+        crng_u128 value;
+
+        value.low = crng_game_rng_next_u64(&inputs) | 1U;
+        value.high = crng_game_rng_next_u64(&inputs) | (UINT64_C(1) << 63);
+        while (!crng_crypto_is_prime_u128(value) && value.low < UINT64_MAX - 2U) {
+            value.low += 2U;
+        }
+        crng_bench_prime_u128[index] = value;
+    }
+}
+
+static int crng_bench_compare_double(const void *left, const void *right) {
+    const double a = *(const double *)left;
+    const double b = *(const double *)right;
+
+    return (a > b) - (a < b);
+}
+
+static double crng_bench_quantile(const double *sorted, size_t count, double fraction) {
+    const double position = fraction * (double)(count - 1U);
+    const size_t lower = (size_t)position;
+
+    if (lower + 1U >= count) {
+        return sorted[count - 1U];
+    }
+    return sorted[lower] + (position - (double)lower) * (sorted[lower + 1U] - sorted[lower]);
+}
+
+/* Median absolute deviation of sorted[0..count) about its median. */
+static double crng_bench_mad(const double *sorted, size_t count, double median) {
+    double *deviations = (double *)malloc(count * sizeof(*deviations));
+    double result;
+    size_t index;
+
+    if (deviations == NULL) {
+        return 0.0;
+    }
+    for (index = 0; index < count; ++index) {
+        deviations[index] =
+            sorted[index] > median ? sorted[index] - median : median - sorted[index];
+    }
+    qsort(deviations, count, sizeof(*deviations), crng_bench_compare_double);
+    result = crng_bench_quantile(deviations, count, 0.5);
+    free(deviations);
+    return result;
+}
+
+/*
+ * Distribution-free 95% interval for the median: order statistics at
+ * n/2 -+ 0.98 sqrt(n), from the normal approximation to Binomial(n, 1/2).
+ */
+static void crng_bench_median_interval(
+    const double *sorted,
+    size_t count,
+    double *low,
+    double *high
+) {
+    size_t root = 0;
+    size_t spread;
+
+    while ((root + 1U) * (root + 1U) <= count) {
+        ++root;
+    }
+    spread = (98U * root + 99U) / 100U;
+    *low = sorted[count / 2U > spread ? count / 2U - spread : 0U];
+    *high = sorted[count / 2U + spread < count ? count / 2U + spread : count - 1U];
+}
+
+#if defined(CRNG_BENCH_HAVE_PERF)
+static void crng_bench_perf_add(const char *name, uint32_t type, uint64_t config) {
+    struct perf_event_attr attributes;
+    const int leader = crng_bench_counters.count == 0 ? -1 : crng_bench_counters.descriptors[0];
+    long descriptor;
+
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = type;
+    attributes.config = config;
+    attributes.disabled = leader == -1 ? 1U : 0U;
+    /* User-space counts only: permitted at the default paranoid level 2. */
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                             PERF_FORMAT_TOTAL_TIME_RUNNING;
+    descriptor = syscall(SYS_perf_event_open, &attributes, 0, -1, leader, 0UL);
+    if (descriptor >= 0) {
+        crng_bench_counters.descriptors[crng_bench_counters.count] = (int)descriptor;
+        crng_bench_counters.names[crng_bench_counters.count++] = name;
+    } else {
+        const int error = errno;
+
+        crng_bench_counters.missing[crng_bench_counters.missing_count] = name;
+        (void)snprintf(crng_bench_counters.reasons[crng_bench_counters.missing_count++],
+                       sizeof(crng_bench_counters.reasons[0]),
+                       "%s",
+                       strerror(error));
+    }
+}
+#endif
+
+/*
+ * Open cycles, instructions, branch misses, backend stall cycles, an optional
+ * raw model-specific event such as a divider-active count, and task clock.
+ * The first event that opens leads the group.
+ */
+static void crng_bench_perf_open(const crng_bench_options *options) {
+#if defined(CRNG_BENCH_HAVE_PERF)
+    crng_bench_perf_add("cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    crng_bench_perf_add("instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    crng_bench_perf_add("branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    crng_bench_perf_add("stalled_cycles_backend", PERF_TYPE_HARDWARE,
+                        PERF_COUNT_HW_STALLED_CYCLES_BACKEND);
+    if (options->perf_raw_name != NULL) {
+        crng_bench_perf_add(options->perf_raw_name, PERF_TYPE_RAW, options->perf_raw_config);
+    }
+    crng_bench_perf_add("task_clock_ns", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK);
+#else
+    (void)options;
+    crng_bench_counters.missing[0] = "all";
+    (void)snprintf(crng_bench_counters.reasons[0],
+                   sizeof(crng_bench_counters.reasons[0]),
+                   "%s",
+                   "perf_event_open is available only on Linux");
+    crng_bench_counters.missing_count = 1;
+#endif
+}
+
+static void crng_bench_perf_start(void) {
+#if defined(CRNG_BENCH_HAVE_PERF)
+    if (crng_bench_counters.count != 0) {
+        ioctl(crng_bench_counters.descriptors[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(crng_bench_counters.descriptors[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+}
+
+/*
+ * Stop the group and write each count into values, scaled up when the kernel
+ * multiplexed the group. Returns zero when no counter ran.
+ */
+static int crng_bench_perf_stop(double *values) {
+#if defined(CRNG_BENCH_HAVE_PERF)
+    uint64_t data[3U + CRNG_BENCH_PERF_MAX];
+    size_t index;
+
+    if (crng_bench_counters.count == 0) {
+        return 0;
+    }
+    ioctl(crng_bench_counters.descriptors[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    if (read(crng_bench_counters.descriptors[0], data, sizeof(data)) <
+            (long)((3U + crng_bench_counters.count) * sizeof(data[0])) ||
+        data[0] != crng_bench_counters.count || data[2] == 0) {
+        return 0;
+    }
+    for (index = 0; index < crng_bench_counters.count; ++index) {
+        values[index] = (double)data[3U + index] * ((double)data[1] / (double)data[2]);
+    }
+    return 1;
+#else
+    (void)values;
+    return 0;
+#endif
+}
+
+static void crng_bench_perf_print(
+    const char *label,
+    double (*samples)[CRNG_BENCH_PERF_MAX],
+    size_t count,
+    double divisor
+) {
+    double sorted[CRNG_BENCH_MAX_TRIALS];
+    double medians[CRNG_BENCH_PERF_MAX];
+    size_t event;
+    size_t index;
+
+    printf(",\n     \"%s\": {", label);
+    for (event = 0; event < crng_bench_counters.count; ++event) {
+        for (index = 0; index < count; ++index) {
+            sorted[index] = samples[index][event] / divisor;
+        }
+        qsort(sorted, count, sizeof(sorted[0]), crng_bench_compare_double);
+        medians[event] = crng_bench_quantile(sorted, count, 0.5);
+        printf("%s\"%s\": %.4f", event == 0 ? "" : ", ", crng_bench_counters.names[event],
+               medians[event]);
+    }
+    if (crng_bench_counters.count >= 2U &&
+        strcmp(crng_bench_counters.names[0], "cycles") == 0 &&
+        strcmp(crng_bench_counters.names[1], "instructions") == 0 && medians[0] > 0.0) {
+        printf(", \"instructions_per_cycle\": %.4f", medians[1] / medians[0]);
+    }
+    printf("}");
+}
+
+static void crng_bench_json_string(const char *text) {
+    putchar('"');
+    for (; *text != '\0'; ++text) {
+        const unsigned char byte = (unsigned char)*text;
+
+        if (byte == '"' || byte == '\\') {
+            printf("\\%c", byte);
+        } else if (byte < 0x20U) {
+            printf("\\u%04x", byte);
+        } else {
+            putchar(byte);
+        }
+    }
+    putchar('"');
+}
+
+/* Copy the value of the first "key<space|tab>*: value" line, if any. */
+static int crng_bench_read_field(
+    const char *path,
+    const char *key,
+    char *out,
+    size_t size
+) {
+    char line[256];
+    FILE *file = fopen(path, "r");
+    int found = 0;
+
+    if (file == NULL) {
+        return 0;
+    }
+    while (!found && fgets(line, sizeof(line), file) != NULL) {
+        const size_t key_length = strlen(key);
+        char *value = line + key_length;
+
+        if (key_length != 0 && strncmp(line, key, key_length) != 0) {
+            continue;
+        }
+        if (key_length != 0) {
+            while (*value == ' ' || *value == '\t') {
+                ++value;
+            }
+            if (*value != ':') {
+                continue;
+            }
+            ++value;
+            while (*value == ' ') {
+                ++value;
+            }
+        } else {
+            value = line;
+        }
+        value[strcspn(value, "\r\n")] = '\0';
+        strncpy(out, value, size - 1U);
+        out[size - 1U] = '\0';
+        found = 1;
+    }
+    fclose(file);
+    return found;
+}
+
+static void crng_bench_print_environment(const crng_bench_options *options) {
+    char text[256];
+    char stamp[32];
+    time_t now = time(NULL);
+    const struct tm *utc = gmtime(&now);
+
+    printf("  \"environment\": {\n");
+    printf("    \"library_version\": \"%s\",\n", CRNG_VERSION_STRING);
+    printf("    \"revision\": ");
+    crng_bench_json_string(CRNG_BENCH_REVISION);
+    printf(",\n    \"build\": ");
+    crng_bench_json_string(CRNG_BENCH_BUILD);
+#if defined(__clang__)
+    snprintf(text, sizeof(text), "clang %s", __clang_version__);
+#elif defined(__GNUC__)
+    snprintf(text, sizeof(text), "gcc %s", __VERSION__);
+#elif defined(_MSC_VER)
+    snprintf(text, sizeof(text), "msvc %d", _MSC_VER);
+#else
+    snprintf(text, sizeof(text), "unknown");
+#endif
+    printf(",\n    \"compiler\": ");
+    crng_bench_json_string(text);
+#if defined(CRNG_PORTABLE_MULMOD)
+    printf(",\n    \"portable_mulmod\": true");
+#else
+    printf(",\n    \"portable_mulmod\": false");
+#endif
+#if defined(_WIN32)
+    printf(",\n    \"os\": \"windows\"");
+#else
+    {
+        struct utsname host;
+
+        if (uname(&host) == 0) {
+            snprintf(text, sizeof(text), "%s %s %s", host.sysname, host.release, host.machine);
+            printf(",\n    \"os\": ");
+            crng_bench_json_string(text);
+        }
+    }
+#endif
+    if (crng_bench_read_field("/proc/cpuinfo", "model name", text, sizeof(text))) {
+        printf(",\n    \"cpu\": ");
+        crng_bench_json_string(text);
+    }
+    if (crng_bench_read_field("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor", "",
+                              text, sizeof(text))) {
+        printf(",\n    \"cpu_governor\": ");
+        crng_bench_json_string(text);
+    }
+#if defined(_SC_NPROCESSORS_ONLN)
+    printf(",\n    \"online_cpus\": %ld", sysconf(_SC_NPROCESSORS_ONLN));
+#endif
+    printf(",\n    \"secure_backend\": ");
+    crng_bench_json_string(crng_secure_backend_name(crng_secure_backend_active()));
+    printf(",\n    \"timer\": \"%s\"",
+#if defined(_WIN32)
+           "QueryPerformanceCounter"
+#else
+           "CLOCK_MONOTONIC"
+#endif
+    );
+    printf(",\n    \"timer_resolution_ns\": %" PRIu64, crng_bench_timer_resolution_ns());
+    if (utc != NULL && strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", utc) != 0) {
+        printf(",\n    \"timestamp\": \"%s\"", stamp);
+    }
+    printf(",\n    \"trials\": %u", options->trials);
+    printf(",\n    \"target_trial_ns\": %" PRIu64, options->target_ns);
+    printf(",\n    \"latency_calls\": %" PRIu64, options->latency_calls);
+    if (options->perf) {
+        size_t index;
+
+        printf(",\n    \"perf_counters\": {\"scope\": \"user\", \"events\": [");
+        for (index = 0; index < crng_bench_counters.count; ++index) {
+            printf("%s", index == 0 ? "" : ", ");
+            crng_bench_json_string(crng_bench_counters.names[index]);
+        }
+        printf("], \"unavailable\": {");
+        for (index = 0; index < crng_bench_counters.missing_count; ++index) {
+            printf("%s", index == 0 ? "" : ", ");
+            crng_bench_json_string(crng_bench_counters.missing[index]);
+            printf(": ");
+            crng_bench_json_string(crng_bench_counters.reasons[index]);
+        }
+        printf("}}");
+    }
+    printf("\n  },\n");
+}
+
+/* Expected source words per bounded result: 2^64 / (2^64 - (2^64 mod b)). */
+static double crng_bench_expected_draws(uint64_t bound) {
+    const uint64_t threshold = (0U - bound) % bound;
+    const double two64 = 18446744073709551616.0;
+
+    return two64 / (two64 - (double)threshold);
+}
+
+static int crng_bench_selected(const crng_bench_options *options, const char *name) {
+    return options->filter == NULL || strstr(name, options->filter) != NULL;
+}
+
+/*
+ * Double the iteration count until one pass reaches the target duration.
+ * The calibration passes double as warmup for caches and the branch
+ * predictor; one further untimed pass precedes the recorded trials.
+ */
+static uint64_t crng_bench_calibrate(const crng_bench_case *bench, uint64_t target_ns) {
+    uint64_t iterations = 1;
+
+    for (;;) {
+        const uint64_t start = crng_bench_now_ns();
+        uint64_t elapsed;
+
+        crng_bench_sink ^= bench->body(bench, iterations);
+        elapsed = crng_bench_now_ns() - start;
+        if (crng_bench_failure != CRNG_OK || elapsed >= target_ns ||
+            iterations >= (UINT64_C(1) << 40)) {
+            break;
+        }
+        iterations *= elapsed * 4U < target_ns ? 4U : 2U;
+    }
+    crng_bench_sink ^= bench->body(bench, iterations);
+    return iterations;
+}
+
+static void crng_bench_run_case(
+    const crng_bench_case *bench,
+    const crng_bench_options *options,
+    int first
+) {
+    double samples[CRNG_BENCH_MAX_TRIALS];
+    double sorted[CRNG_BENCH_MAX_TRIALS];
+    double counters[CRNG_BENCH_MAX_TRIALS][CRNG_BENCH_PERF_MAX];
+    int counted = crng_bench_counters.count != 0;
+    double median;
+    double low;
+    double high;
+    uint64_t iterations;
+    unsigned int trial;
+
+    crng_bench_failure = CRNG_OK;
+    crng_game_rng_seed(&crng_bench_rng, UINT64_C(1));
+    iterations = crng_bench_calibrate(bench, options->target_ns);
+    for (trial = 0; trial < options->trials && crng_bench_failure == CRNG_OK; ++trial) {
+        uint64_t start;
+        uint64_t elapsed;
+
+        crng_bench_perf_start();
+        start = crng_bench_now_ns();
+        crng_bench_sink ^= bench->body(bench, iterations);
+        elapsed = crng_bench_now_ns() - start;
+        counted &= crng_bench_perf_stop(counters[trial]);
+        samples[trial] = (double)elapsed / (double)iterations;
+    }
+
+    printf("%s    {\"family\": \"%s\", \"name\": \"%s\"", first ? "" : ",\n",
+           bench->family, bench->name);
+    if (crng_bench_failure != CRNG_OK) {
+        printf(", \"error\": \"%s\"}", crng_status_string(crng_bench_failure));
+        return;
+    }
+    memcpy(sorted, samples, options->trials * sizeof(samples[0]));
+    qsort(sorted, options->trials, sizeof(sorted[0]), crng_bench_compare_double);
+    median = crng_bench_quantile(sorted, options->trials, 0.5);
+    crng_bench_median_interval(sorted, options->trials, &low, &high);
+
+    printf(",\n     \"iterations_per_trial\": %" PRIu64, iterations);
+    printf(", \"ns_per_op\": {\"median\": %.4f, \"mad\": %.4f, \"min\": %.4f, \"max\": %.4f"
+           ", \"median_ci95\": [%.4f, %.4f]}",
+           median, crng_bench_mad(sorted, options->trials, median), sorted[0],
+           sorted[options->trials - 1U], low, high);
+    if (median > 0.0) {
+        printf(",\n     \"ops_per_second\": %.0f", 1e9 / median);
+    }
+    if (bench->bytes_per_op != 0 && median > 0.0) {
+        printf(", \"bytes_per_second\": %.0f", (double)bench->bytes_per_op * 1e9 / median);
+    }
+    if (bench->body == crng_bench_uniform_u64 || bench->body == crng_bench_secure_uniform_u64) {
+        printf(", \"bound\": %" PRIu64 ", \"expected_draws_per_result\": %.6f",
+               bench->parameter, crng_bench_expected_draws(bench->parameter));
+    }
+#if defined(CRNG_ENABLE_STATS)
+    /* The library counters give the realized rate over every pass. */
+    if (bench->body == crng_bench_uniform_u64) {
+        crng_game_rng_stats stats;
+
+        if (crng_game_rng_read_stats(&crng_bench_rng, &stats) == CRNG_OK &&
+            stats.uniform_results != 0) {
+            printf(", \"observed_draws_per_result\": %.6f",
+                   (double)stats.draws / (double)stats.uniform_results);
+        }
+    }
+#endif
+    printf(",\n     \"samples_ns_per_op\": [");
+    for (trial = 0; trial < options->trials; ++trial) {
+        printf("%s%.4f", trial == 0 ? "" : ", ", samples[trial]);
+    }
+    printf("]");
+    if (counted) {
+        crng_bench_perf_print("counters_per_op", counters, options->trials, (double)iterations);
+    }
+    printf("}");
+}
+
+static crng_status crng_bench_prime_call(const crng_bench_latency_case *bench, uint64_t *sink) {
+    uint64_t value = 0;
+    crng_u128 wide;
+    crng_status status;
+
+    if (strcmp(bench->method, "uniform") == 0) {
+        status = crng_crypto_random_prime_u64(bench->minimum.low, bench->maximum.low,
+                                              CRNG_BENCH_PRIME_ATTEMPTS, &value);
+    } else if (strcmp(bench->method, "sieved") == 0) {
+        status = crng_crypto_random_prime_u64_sieved(bench->minimum.low, bench->maximum.low,
+                                                     CRNG_BENCH_PRIME_ATTEMPTS, &value);
+    } else if (strcmp(bench->method, "safe") == 0) {
+        status = crng_crypto_random_safe_prime_u64(bench->minimum.low, bench->maximum.low,
+                                                   CRNG_BENCH_PRIME_ATTEMPTS, &value);
+    } else {
+        status = crng_crypto_random_prime_u128(bench->minimum, bench->maximum,
+                                               CRNG_BENCH_PRIME_ATTEMPTS, &wide);
+        value = wide.low ^ wide.high;
+    }
+    *sink ^= value;
+    return status;
+}
+
+static void crng_bench_run_latency(
+    const crng_bench_latency_case *bench,
+    const crng_bench_options *options,
+    int first
+) {
+    double *samples = (double *)malloc((size_t)options->latency_calls * sizeof(*samples));
+    double counters[1][CRNG_BENCH_PERF_MAX];
+    int counted;
+    uint64_t sink = 0;
+    uint64_t failures = 0;
+    crng_status error = CRNG_OK;
+    size_t count = 0;
+    uint64_t call;
+
+    printf("%s    {\"family\": \"random_prime\", \"name\": \"%s\"", first ? "" : ",\n",
+           bench->name);
+    if (samples == NULL) {
+        printf(", \"error\": \"%s\"}", crng_status_string(CRNG_ERR_NO_MEMORY));
+        return;
+    }
+    /* Warm caches and the entropy backend outside the recorded calls. */
+    for (call = 0; call < 8U; ++call) {
+        (void)crng_bench_prime_call(bench, &sink);
+    }
+    crng_bench_perf_start();
+    for (call = 0; call < options->latency_calls; ++call) {
+        const uint64_t start = crng_bench_now_ns();
+        const crng_status status = crng_bench_prime_call(bench, &sink);
+        const uint64_t elapsed = crng_bench_now_ns() - start;
+
+        if (status == CRNG_OK) {
+            samples[count++] = (double)elapsed;
+        } else if (status == CRNG_ERR_NOT_FOUND) {
+            ++failures;
+        } else {
+            error = status;
+            break;
+        }
+    }
+    counted = crng_bench_perf_stop(counters[0]);
+    crng_bench_sink ^= sink;
+
+    if (error != CRNG_OK || count == 0) {
+        printf(", \"error\": \"%s\"}",
+               crng_status_string(error != CRNG_OK ? error : CRNG_ERR_NOT_FOUND));
+        free(samples);
+        return;
+    }
+    qsort(samples, count, sizeof(*samples), crng_bench_compare_double);
+    printf(",\n     \"attempt_budget\": %" PRIu64 ", \"successes\": %zu, \"failures\": %" PRIu64,
+           CRNG_BENCH_PRIME_ATTEMPTS, count, failures);
+    printf(",\n     \"latency_ns\": {\"min\": %.0f, \"p50\": %.0f, \"p90\": %.0f, \"p99\": %.0f"
+           ", \"p99.9\": %.0f, \"max\": %.0f, \"mad\": %.0f}",
+           samples[0], crng_bench_quantile(samples, count, 0.5),
+           crng_bench_quantile(samples, count, 0.9), crng_bench_quantile(samples, count, 0.99),
+           crng_bench_quantile(samples, count, 0.999), samples[count - 1U],
+           crng_bench_mad(samples, count, crng_bench_quantile(samples, count, 0.5)));
+    if (counted) {
+        /* Totals over every recorded call, including timer reads. */
+        crng_bench_perf_print("counters_per_call", counters, 1U, (double)call);
+    }
+    printf("}");
+    free(samples);
+}
+
+static void crng_bench_usage(const char *program) {
+    fprintf(stderr,
+            "usage: %s [--quick] [--trials N] [--calls N] [--filter TEXT]\n"
+            "       [--perf] [--perf-raw NAME=CONFIG]\n",
+            program);
+}
+
+static int crng_bench_parse_u64(const char *text, uint64_t *out) {
+    char *end = NULL;
+    unsigned long long value;
+
+    if (text[0] == '-') {
+        return 0;
+    }
+    errno = 0;
+    value = strtoull(text, &end, 0);
+    if (errno != 0 || end == text || *end != '\0') {
+        return 0;
+    }
+    *out = (uint64_t)value;
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    crng_bench_options options;
+    uint64_t value;
+    size_t index;
+    int first = 1;
+    int argument;
+
+    options.trials = 21;
+    options.target_ns = UINT64_C(20000000);
+    options.latency_calls = 2000;
+    options.filter = NULL;
+    options.perf = 0;
+    options.perf_raw_name = NULL;
+    options.perf_raw_config = 0;
+
+    for (argument = 1; argument < argc; ++argument) {
+        if (strcmp(argv[argument], "--quick") == 0) {
+            options.trials = 5;
+            options.target_ns = UINT64_C(1000000);
+            options.latency_calls = 50;
+        } else if (strcmp(argv[argument], "--trials") == 0 && argument + 1 < argc) {
+            if (!crng_bench_parse_u64(argv[++argument], &value) || value == 0 ||
+                value > CRNG_BENCH_MAX_TRIALS) {
+                crng_bench_usage(argv[0]);
+                return 2;
+            }
+            options.trials = (unsigned int)value;
+        } else if (strcmp(argv[argument], "--calls") == 0 && argument + 1 < argc) {
+            if (!crng_bench_parse_u64(argv[++argument], &value) || value == 0 ||
+                value > UINT64_C(10000000)) {
+                crng_bench_usage(argv[0]);
+                return 2;
+            }
+            options.latency_calls = value;
+        } else if (strcmp(argv[argument], "--filter") == 0 && argument + 1 < argc) {
+            options.filter = argv[++argument];
+        } else if (strcmp(argv[argument], "--perf") == 0) {
+            options.perf = 1;
+        } else if (strcmp(argv[argument], "--perf-raw") == 0 && argument + 1 < argc) {
+            char *separator = strchr(argv[++argument], '=');
+
+            if (separator == NULL || separator == argv[argument] ||
+                !crng_bench_parse_u64(separator + 1, &options.perf_raw_config)) {
+                crng_bench_usage(argv[0]);
+                return 2;
+            }
+            *separator = '\0';
+            options.perf_raw_name = argv[argument];
+            options.perf = 1;
+        } else if (strcmp(argv[argument], "--help") == 0) {
+            crng_bench_usage(argv[0]);
+            return 0;
+        } else {
+            crng_bench_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    crng_bench_prepare_inputs();
+    if (options.perf) {
+        crng_bench_perf_open(&options);
+    }
+    printf("{\n  \"schema\": \"classical_rng-bench-1\",\n");
+    crng_bench_print_environment(&options);
+    printf("  \"results\": [\n");
+    for (index = 0; index < sizeof(crng_bench_cases) / sizeof(crng_bench_cases[0]); ++index) {
+        if (crng_bench_selected(&options, crng_bench_cases[index].name)) {
+            crng_bench_run_case(&crng_bench_cases[index], &options, first);
+            first = 0;
+            fflush(stdout);
+        }
+    }
+    for (index = 0;
+         index < sizeof(crng_bench_latency_cases) / sizeof(crng_bench_latency_cases[0]);
+         ++index) {
+        if (crng_bench_selected(&options, crng_bench_latency_cases[index].name)) {
+            crng_bench_run_latency(&crng_bench_latency_cases[index], &options, first);
+            first = 0;
+            fflush(stdout);
+        }
+    }
+    printf("\n  ],\n  \"checksum\": \"%016" PRIx64 "\"\n}\n", (uint64_t)crng_bench_sink);
+    return 0;
+}
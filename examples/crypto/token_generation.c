@@ -3,18 +3,30 @@
 #include <stdio.h>
 
 int main(void) {
-    unsigned char token[32];
+    /* 22 base62 symbols carry about 131 bits; 43 base64url symbols carry 258. */
+    char session[22];
+    char api_key[43];
+    char invites[4][10];
     size_t index;
-    crng_status status = crng_secure_bytes(token, sizeof(token));
+    crng_status status = crng_secure_token(
+        CRNG_TOKEN_ALPHANUMERIC, 62, session, sizeof(session));
 
+    if (status == CRNG_OK) {
+        status = crng_secure_token(CRNG_TOKEN_BASE64URL, 64, api_key, sizeof(api_key));
+    }
+    if (status == CRNG_OK) {
+        /* One OS request mints every invite code. */
+        status = crng_secure_token_array(
+            CRNG_TOKEN_BASE32, 32, invites[0], sizeof(invites[0]), 4);
+    }
     if (status != CRNG_OK) {
         fprintf(stderr, "token generation failed: %s\n", crng_status_string(status));
         return 1;
     }
-    printf("256-bit token: ");
-    for (index = 0; index < sizeof(token); ++index) {
-        printf("%02x", (unsigned int)token[index]);
+    printf("session id: %.*s\n", (int)sizeof(session), session);
+    printf("api key:    %.*s\n", (int)sizeof(api_key), api_key);
+    for (index = 0; index < 4; ++index) {
+        printf("invite:     %.*s\n", (int)sizeof(invites[index]), invites[index]);
     }
-    putchar('\n');
     return 0;
 }
@@ -1,7 +1,7 @@
 #ifndef CLASSICAL_RNG_H
 #define CLASSICAL_RNG_H
 
-/* Umbrella header for the three version 2 modules. */
+/* Umbrella header for the three version 3 modules. */
 #include "classical_rng/common.h"
 #include "classical_rng/game_rng.h"
 #include "classical_rng/crypto_rng.h"
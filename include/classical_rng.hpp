@@ -0,0 +1,361 @@
+#ifndef CLASSICAL_RNG_HPP
+#define CLASSICAL_RNG_HPP
+
+/*
+ * Header-only C++20 layer over the C API. Every engine models
+ * std::uniform_random_bit_generator, so it plugs into <random>
+ * distributions, and serves single words from a small block refilled by
+ * the library's bulk paths instead of one library call per word. Failures
+ * of the secure engines are thrown as crng::error.
+ */
+#include "classical_rng.h"
+
+#if !((defined(_MSVC_LANG) && _MSVC_LANG >= 202002L) || __cplusplus >= 202002L)
+#  error "classical_rng.hpp requires C++20; C++ code may include classical_rng.h directly"
+#endif
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <stdexcept>
+
+namespace crng {
+
+/** A failed library call, carrying its crng_status. */
+class error : public std::runtime_error {
+public:
+    explicit error(crng_status status)
+        : std::runtime_error(crng_status_string(status)), status_(status) {}
+
+    crng_status status() const noexcept { return status_; }
+
+private:
+    crng_status status_;
+};
+
+namespace detail {
+
+inline void check(crng_status status) {
+    if (status != CRNG_OK) {
+        throw error(status);
+    }
+}
+
+/* Erase secret words through volatile stores the compiler keeps. */
+inline void wipe(void *data, std::size_t size) noexcept {
+    volatile unsigned char *bytes = static_cast<volatile unsigned char *>(data);
+
+    while (size != 0) {
+        *bytes++ = 0;
+        --size;
+    }
+}
+
+/* The game generator's byte order is little-endian; words are native. */
+inline void words_from_little_endian(std::span<std::uint64_t> words) noexcept {
+    if constexpr (std::endian::native == std::endian::big) {
+        for (std::uint64_t &word : words) {
+            const auto *bytes = reinterpret_cast<const unsigned char *>(&word);
+            std::uint64_t value = 0;
+
+            for (int index = 7; index >= 0; --index) {
+                value = (value << 8) | bytes[index];
+            }
+            word = value;
+        }
+    }
+}
+
+} // namespace detail
+
+/** Words served per block refill in the engines' operator(). */
+inline constexpr std::size_t engine_block_words = 32;
+
+/**
+ * The deterministic game generator. Its output sequence is exactly that of
+ * crng_game_rng_next_u64 for the same seed, however calls to operator(),
+ * generate, fill, and discard are interleaved. Not for secrets.
+ */
+class game_engine {
+public:
+    using result_type = std::uint64_t;
+
+    static constexpr std::uint64_t default_seed = 2026;
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    game_engine() noexcept : game_engine(default_seed) {}
+    explicit game_engine(std::uint64_t seed_value) noexcept { seed(seed_value); }
+
+    /** Seed under a registered algorithm tier; throws crng::error if unknown. */
+    game_engine(std::uint64_t seed_value, crng_game_rng_algorithm algorithm) {
+        seed(seed_value, algorithm);
+    }
+
+    void seed(std::uint64_t seed_value) noexcept {
+        crng_game_rng_seed(&rng_, seed_value);
+        next_ = engine_block_words;
+    }
+
+    void seed(std::uint64_t seed_value, crng_game_rng_algorithm algorithm) {
+        detail::check(crng_game_rng_seed_algorithm(&rng_, seed_value, algorithm));
+        next_ = engine_block_words;
+    }
+
+    result_type operator()() noexcept {
+        if (next_ == engine_block_words) {
+            refill();
+        }
+        return block_[next_++];
+    }
+
+    /** Advance past `count` outputs. */
+    void discard(unsigned long long count) noexcept {
+        const std::size_t buffered = engine_block_words - next_;
+
+        if (count <= buffered) {
+            next_ += static_cast<std::size_t>(count);
+            return;
+        }
+        count -= buffered;
+        next_ = engine_block_words;
+        while (count-- != 0) {
+            (void)crng_game_rng_next_u64(&rng_);
+        }
+    }
+
+    /** Write the next out.size() outputs, filling directly from the library. */
+    void generate(std::span<std::uint64_t> out) noexcept {
+        const std::size_t taken = drain(out);
+        const std::span<std::uint64_t> rest = out.subspan(taken);
+
+        (void)crng_game_rng_fill(&rng_, rest.data(), rest.size_bytes());
+        detail::words_from_little_endian(rest);
+    }
+
+    /**
+     * Write bytes exactly as crng_game_rng_fill does from this position:
+     * little-endian words, with a partial final word's high bytes dropped.
+     */
+    void fill(std::span<std::byte> out) noexcept {
+        while (next_ != engine_block_words && !out.empty()) {
+            std::uint64_t word = block_[next_++];
+            const std::size_t chunk = out.size() < 8 ? out.size() : 8;
+
+            for (std::size_t index = 0; index < chunk; ++index) {
+                out[index] = static_cast<std::byte>(word & 0xffU);
+                word >>= 8;
+            }
+            out = out.subspan(chunk);
+        }
+        (void)crng_game_rng_fill(&rng_, out.data(), out.size());
+    }
+
+    /** Undo the latest `count` outputs; false when that passes the seed. */
+    bool rewind(std::uint64_t count) noexcept {
+        crng_game_rng position = state();
+
+        if (crng_game_rng_rewind(&position, count) != CRNG_OK) {
+            return false;
+        }
+        rng_ = position;
+        next_ = engine_block_words;
+        return true;
+    }
+
+    /** The C generator at this engine's position, excluding buffered words. */
+    crng_game_rng state() const noexcept {
+        crng_game_rng position = rng_;
+
+        (void)crng_game_rng_rewind(&position, engine_block_words - next_);
+        return position;
+    }
+
+    std::array<unsigned char, CRNG_GAME_RNG_RECORD_BYTES> serialize() const noexcept {
+        std::array<unsigned char, CRNG_GAME_RNG_RECORD_BYTES> record{};
+        const crng_game_rng position = state();
+
+        (void)crng_game_rng_serialize(&position, record.data());
+        return record;
+    }
+
+    /** Restore from a crng_game_rng_serialize record; throws crng::error. */
+    void deserialize(std::span<const unsigned char, CRNG_GAME_RNG_RECORD_BYTES> record) {
+        detail::check(crng_game_rng_deserialize(&rng_, record.data()));
+        next_ = engine_block_words;
+    }
+
+    friend bool operator==(const game_engine &left, const game_engine &right) noexcept {
+        return left.serialize() == right.serialize();
+    }
+
+private:
+    void refill() noexcept {
+        (void)crng_game_rng_fill(&rng_, block_.data(), sizeof(block_));
+        detail::words_from_little_endian(block_);
+        next_ = 0;
+    }
+
+    std::size_t drain(std::span<std::uint64_t> out) noexcept {
+        std::size_t taken = 0;
+
+        while (next_ != engine_block_words && taken != out.size()) {
+            out[taken++] = block_[next_++];
+        }
+        return taken;
+    }
+
+    crng_game_rng rng_;
+    std::array<std::uint64_t, engine_block_words> block_{};
+    std::size_t next_ = engine_block_words;
+};
+
+/**
+ * Operating-system randomness through crng_secure_bytes. Words are served
+ * from a block fetched in one request and erased as they are handed out.
+ */
+class secure_engine {
+public:
+    using result_type = std::uint64_t;
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    secure_engine() noexcept = default;
+    secure_engine(const secure_engine &) = delete;
+    secure_engine &operator=(const secure_engine &) = delete;
+    ~secure_engine() { detail::wipe(block_.data(), sizeof(block_)); }
+
+    result_type operator()() {
+        result_type value;
+
+        if (next_ == engine_block_words) {
+            detail::check(crng_secure_bytes(block_.data(), sizeof(block_)));
+            next_ = 0;
+        }
+        value = block_[next_];
+        block_[next_++] = 0;
+        return value;
+    }
+
+    void generate(std::span<std::uint64_t> out) {
+        detail::check(crng_secure_bytes(out.data(), out.size_bytes()));
+    }
+
+    void fill(std::span<std::byte> out) {
+        detail::check(crng_secure_bytes(out.data(), out.size()));
+    }
+
+private:
+    std::array<std::uint64_t, engine_block_words> block_{};
+    std::size_t next_ = engine_block_words;
+};
+
+/**
+ * An owned crng_secure_pool: keyed on construction, wiped on destruction.
+ * Copying would duplicate the output stream, so pools only move; the
+ * moved-from pool is wiped and keys itself again if it is used.
+ */
+class secure_pool {
+public:
+    using result_type = std::uint64_t;
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    secure_pool() { detail::check(crng_secure_pool_init(&pool_)); }
+    secure_pool(const secure_pool &) = delete;
+    secure_pool &operator=(const secure_pool &) = delete;
+
+    secure_pool(secure_pool &&other) noexcept : pool_(other.pool_) {
+        crng_secure_pool_wipe(&other.pool_);
+    }
+
+    secure_pool &operator=(secure_pool &&other) noexcept {
+        if (this != &other) {
+            crng_secure_pool_wipe(&pool_);
+            pool_ = other.pool_;
+            crng_secure_pool_wipe(&other.pool_);
+        }
+        return *this;
+    }
+
+    ~secure_pool() { crng_secure_pool_wipe(&pool_); }
+
+    result_type operator()() {
+        result_type value;
+
+        detail::check(crng_secure_pool_u64(&pool_, &value));
+        return value;
+    }
+
+    void generate(std::span<std::uint64_t> out) {
+        detail::check(crng_secure_pool_bytes(&pool_, out.data(), out.size_bytes()));
+    }
+
+    void fill(std::span<std::byte> out) {
+        detail::check(crng_secure_pool_bytes(&pool_, out.data(), out.size()));
+    }
+
+    /** The underlying pool, for the C functions without a wrapper. */
+    crng_secure_pool *native() noexcept { return &pool_; }
+
+private:
+    crng_secure_pool pool_;
+};
+
+/**
+ * A full-range 64-bit engine: any of the above, or a standard engine such as
+ * std::mt19937_64, whose outputs cover every uint64_t value.
+ */
+template <class Engine>
+concept full_range_engine =
+    std::uniform_random_bit_generator<Engine> &&
+    std::same_as<typename Engine::result_type, std::uint64_t> &&
+    Engine::min() == 0 && Engine::max() == std::numeric_limits<std::uint64_t>::max();
+
+/**
+ * Uniform value in [0, Bound) for a bound fixed at compile time. This is the
+ * rejection rule of crng_game_rng_uniform_u64 with the threshold computed by
+ * the compiler and `% Bound` reduced to a multiply and shift, or a mask for a
+ * power of two, which never rejects. Given the same engine outputs it returns
+ * what the C function returns, so a game_engine reproduces the C stream.
+ */
+template <std::uint64_t Bound, full_range_engine Engine>
+    requires(Bound != 0)
+std::uint64_t uniform(Engine &engine) {
+    constexpr std::uint64_t threshold = (std::uint64_t{0} - Bound) % Bound;
+    std::uint64_t value;
+
+    do {
+        value = engine();
+    } while (value < threshold);
+    return value % Bound;
+}
+
+/** Uniform value in inclusive [Minimum, Maximum], as crng_game_rng_range_i32. */
+template <std::int32_t Minimum, std::int32_t Maximum, full_range_engine Engine>
+    requires(Minimum <= Maximum)
+std::int32_t uniform(Engine &engine) {
+    constexpr std::uint64_t span =
+        static_cast<std::uint64_t>(std::int64_t{Maximum} - std::int64_t{Minimum}) + 1U;
+
+    return static_cast<std::int32_t>(
+        std::int64_t{Minimum} + static_cast<std::int64_t>(uniform<span>(engine)));
+}
+
+} // namespace crng
+
+#endif /* CLASSICAL_RNG_HPP */
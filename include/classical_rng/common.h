@@ -12,10 +12,10 @@
 #  error "classical_rng requires double with at least 53 significant bits"
 #endif
 
-#define CRNG_VERSION_MAJOR 2
+#define CRNG_VERSION_MAJOR 3
 #define CRNG_VERSION_MINOR 0
 #define CRNG_VERSION_PATCH 0
-#define CRNG_VERSION_STRING "2.0.0"
+#define CRNG_VERSION_STRING "3.0.0"
 
 #if defined(_WIN32) && defined(CRNG_SHARED)
 #  if defined(CRNG_BUILDING_LIBRARY)
@@ -46,7 +46,13 @@ typedef enum crng_status {
     /** Reserved for a platform capability that is not implemented. */
     CRNG_ERR_UNSUPPORTED = -4,
     /** A bounded search exhausted its attempt budget. */
-    CRNG_ERR_NOT_FOUND = -5
+    CRNG_ERR_NOT_FOUND = -5,
+    /** A file could not be opened, read, written, or mapped. */
+    CRNG_ERR_IO = -6,
+    /** Stored data was malformed or written by an incompatible version. */
+    CRNG_ERR_FORMAT = -7,
+    /** A memory allocation failed. */
+    CRNG_ERR_NO_MEMORY = -8
 } crng_status;
 
 /**
@@ -11,6 +11,34 @@
 extern "C" {
 #endif
 
+#define CRNG_SECURE_BATCH_WORDS 64
+
+/** Native entropy source behind crng_secure_bytes. */
+typedef enum crng_secure_backend {
+    /** Windows BCryptGenRandom with the system-preferred RNG. */
+    CRNG_SECURE_BACKEND_BCRYPT = 1,
+    /** Apple and BSD arc4random_buf. */
+    CRNG_SECURE_BACKEND_ARC4RANDOM = 2,
+    /** The Linux/Android getrandom system call. */
+    CRNG_SECURE_BACKEND_GETRANDOM = 3,
+    /** The kernel's vDSO getrandom, called directly or through libc. */
+    CRNG_SECURE_BACKEND_GETRANDOM_VDSO = 4,
+    /** A cached close-on-exec /dev/urandom descriptor. */
+    CRNG_SECURE_BACKEND_URANDOM = 5
+} crng_secure_backend;
+
+/**
+ * Report the backend crng_secure_bytes uses. Linux probes once on first use
+ * and caches the result; other targets select their backend at compile time.
+ */
+CRNG_API crng_secure_backend crng_secure_backend_active(void);
+
+/**
+ * Return static text naming a backend. Unknown values map to a stable
+ * fallback string. The result must not be freed.
+ */
+CRNG_API const char *crng_secure_backend_name(crng_secure_backend backend);
+
 /**
  * Fill a buffer with randomness from the native operating-system CSPRNG.
  * `(NULL, 0)` succeeds. Source failures are reported without fallback.
@@ -40,11 +68,281 @@ CRNG_API crng_status crng_secure_range_i32(
 );
 
 /**
- * Deterministic Miller-Rabin classification valid over all uint64_t values.
+ * Fill `out[0..count)` with independent uniform draws from [0, upper_bound).
+ * OS randomness is requested in batches of up to CRNG_SECURE_BATCH_WORDS
+ * words and rejection consumes words from the batch. A null `out` is valid
+ * only when count is zero. On failure every element of `out` is zeroed.
+ */
+CRNG_API crng_status crng_secure_uniform_u64_array(
+    uint64_t upper_bound,
+    uint64_t *out,
+    size_t count
+);
+
+/**
+ * Fill `out[0..count)` with independent uniform draws from inclusive
+ * [minimum, maximum]. Each 64-bit OS word supplies two 32-bit candidates.
+ * On failure every element of `out` is zeroed.
+ */
+CRNG_API crng_status crng_secure_range_i32_array(
+    int32_t minimum,
+    int32_t maximum,
+    int32_t *out,
+    size_t count
+);
+
+/** Common token alphabets for crng_secure_token. */
+#define CRNG_TOKEN_HEX "0123456789abcdef"
+#define CRNG_TOKEN_BASE32 "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567"
+#define CRNG_TOKEN_BASE64URL \
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+#define CRNG_TOKEN_ALPHANUMERIC \
+    "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+
+/**
+ * Write `length` symbols drawn independently and uniformly from
+ * `alphabet[0..alphabet_length)` to `out`. No terminator is written. The
+ * alphabet holds 2 to 256 symbols; repeated symbols are drawn as often as
+ * they appear. On failure all `length` bytes of `out` are zeroed.
+ */
+CRNG_API crng_status crng_secure_token(
+    const char *alphabet,
+    size_t alphabet_length,
+    char *out,
+    size_t length
+);
+
+/**
+ * Write `count` tokens of `length` symbols back to back, token i at
+ * `out + i * length`, without terminators. Symbols from every token share
+ * each OS request, so many short tokens cost about one native call per
+ * 4 KiB of entropy. On failure all `count * length` bytes are zeroed.
+ */
+CRNG_API crng_status crng_secure_token_array(
+    const char *alphabet,
+    size_t alphabet_length,
+    char *out,
+    size_t length,
+    size_t count
+);
+
+/** Bytes in a binary UUID and characters in its canonical text form. */
+#define CRNG_UUID_BYTES 16
+#define CRNG_UUID_STRING_LENGTH 36
+
+/**
+ * Fill `count` consecutive 16-byte RFC 9562 version 4 UUIDs from one
+ * crng_secure_bytes request. Each carries 122 random bits. A null `out` is
+ * valid only when count is zero. On failure every byte of `out` is zeroed.
+ */
+CRNG_API crng_status crng_secure_uuid_v4_array(unsigned char *out, size_t count);
+
+/**
+ * Fill `count` consecutive version 7 UUIDs: a 48-bit Unix millisecond
+ * timestamp, a 16-bit sequence, and 58 random bits, all random bits from one
+ * crng_secure_bytes request. UUIDs from every call and thread in the process
+ * strictly increase; more than 65536 in one millisecond run the timestamp
+ * ahead of the clock. On failure every byte of `out` is zeroed.
+ */
+CRNG_API crng_status crng_secure_uuid_v7_array(unsigned char *out, size_t count);
+
+/**
+ * Write the lowercase 8-4-4-4-12 text of `count` binary UUIDs back to back,
+ * CRNG_UUID_STRING_LENGTH characters each and without terminators.
+ */
+CRNG_API crng_status crng_uuid_format_array(
+    const unsigned char *uuids,
+    char *out,
+    size_t count
+);
+
+/** Unsigned 128-bit integer as two native 64-bit words. */
+typedef struct crng_u128 {
+    uint64_t low;
+    uint64_t high;
+} crng_u128;
+
+/**
+ * Draw uniformly from [0, upper_bound) using OS randomness. Draws are masked
+ * to the bit length of upper_bound - 1 and rejected above it. A zero bound is
+ * invalid. Write `out` only on success.
+ */
+CRNG_API crng_status crng_secure_uniform_u128(
+    crng_u128 upper_bound,
+    crng_u128 *out
+);
+
+/**
+ * Process-wide counters for the secure call paths, maintained only when the
+ * library is built with CRNG_ENABLE_STATS.
+ */
+typedef struct crng_secure_stats {
+    /** Successful crng_secure_bytes requests, from any caller. */
+    uint64_t entropy_calls;
+    /** Bytes those requests returned. */
+    uint64_t entropy_bytes;
+    /** crng_secure_bytes requests that reported a provider failure. */
+    uint64_t entropy_failures;
+    /** Bounded results from the unbuffered uniform and range functions. */
+    uint64_t uniform_results;
+    /** Candidates those functions discarded by rejection. */
+    uint64_t uniform_rejections;
+    /** Bytes served by crng_secure_pool objects. */
+    uint64_t pool_bytes;
+    /** Pool keyings and reseeds from the operating system. */
+    uint64_t pool_reseeds;
+    /** Bounded results from the pool uniform and range functions. */
+    uint64_t pool_uniform_results;
+    /** Candidates the pool functions discarded by rejection. */
+    uint64_t pool_uniform_rejections;
+    /** Random-prime searches started with valid arguments. */
+    uint64_t prime_searches;
+    /** Candidates those searches consumed from their attempt budgets. */
+    uint64_t prime_attempts;
+    /** Searches that returned CRNG_ERR_NOT_FOUND. */
+    uint64_t prime_not_found;
+} crng_secure_stats;
+
+/**
+ * Copy the secure-path counters. Concurrent updates may land between fields.
+ * Returns CRNG_ERR_UNSUPPORTED when built without CRNG_ENABLE_STATS.
+ */
+CRNG_API crng_status crng_secure_read_stats(crng_secure_stats *out);
+
+/** Zero the secure-path counters; CRNG_ERR_UNSUPPORTED without stats. */
+CRNG_API crng_status crng_secure_reset_stats(void);
+
+#define CRNG_SECURE_POOL_BUFFER_BYTES 512
+#define CRNG_SECURE_POOL_RESEED_BYTES (UINT64_C(1) << 20)
+#define CRNG_SECURE_POOL_RESEED_SECONDS 300
+
+/**
+ * Caller-owned buffered generator for high-rate secure requests.
+ *
+ * ChaCha20 keyed from crng_secure_bytes with fast key erasure: every refill
+ * replaces the key, and served bytes are erased from the buffer. The pool
+ * reseeds from the OS after CRNG_SECURE_POOL_RESEED_BYTES of output, after
+ * CRNG_SECURE_POOL_RESEED_SECONDS, and before first use in a forked child.
+ * Keep one pool per thread; the layout is public only so allocation requires
+ * no library heap, and direct mutation is outside the API contract.
+ */
+typedef struct crng_secure_pool {
+    uint32_t key[8];
+    unsigned char buffer[CRNG_SECURE_POOL_BUFFER_BYTES];
+    size_t position;
+    uint64_t output_since_reseed;
+    int64_t reseed_time;
+    uint64_t fork_token;
+    int seeded;
+} crng_secure_pool;
+
+/**
+ * Key a pool from operating-system randomness. On failure the pool is left
+ * wiped. A wiped or zero-initialized pool keys itself on its next draw.
+ */
+CRNG_API crng_status crng_secure_pool_init(crng_secure_pool *pool);
+
+/** Erase all key and buffered material. A null pointer is ignored. */
+CRNG_API void crng_secure_pool_wipe(crng_secure_pool *pool);
+
+/**
+ * Fill a buffer from a pool. `(pool, NULL, 0)` succeeds. A failed reseed is
+ * reported without fallback and leaves the pool wiped.
+ */
+CRNG_API crng_status crng_secure_pool_bytes(
+    crng_secure_pool *pool,
+    void *buffer,
+    size_t size
+);
+
+/** Generate a native-endian 64-bit value from a pool. */
+CRNG_API crng_status crng_secure_pool_u64(crng_secure_pool *pool, uint64_t *out);
+
+/**
+ * Draw uniformly from [0, upper_bound) using pool output and rejection.
+ * A zero bound is invalid. Write `out` only on success.
+ */
+CRNG_API crng_status crng_secure_pool_uniform_u64(
+    crng_secure_pool *pool,
+    uint64_t upper_bound,
+    uint64_t *out
+);
+
+/**
+ * Draw uniformly from inclusive [minimum, maximum] using pool output.
+ * The entire int32_t domain is supported. Write `out` only on success.
+ */
+CRNG_API crng_status crng_secure_pool_range_i32(
+    crng_secure_pool *pool,
+    int32_t minimum,
+    int32_t maximum,
+    int32_t *out
+);
+
+/**
+ * Deterministic classification valid over all uint64_t values: Miller-Rabin
+ * below 2^32 and Baillie-PSW or seven-witness Miller-Rabin above.
  * This is a number-theory utility, not a large-key prime generator.
  */
 CRNG_API bool crng_crypto_is_prime_u64(uint64_t value);
 
+/**
+ * Classify `values[0..count)` into `out[0..count)` with the same results as
+ * crng_crypto_is_prime_u64. Candidates share a wider small-prime screen and
+ * survivors run their modular exponentiations interleaved. Null pointers are
+ * valid only when count is zero. `values` and `out` must not overlap.
+ */
+CRNG_API crng_status crng_crypto_is_prime_u64_array(
+    const uint64_t *values,
+    bool *out,
+    size_t count
+);
+
+#define CRNG_PRIME_TABLE_MAX_LIMIT (UINT64_C(1) << 32)
+
+/**
+ * Opt-in bitmap of the primes below `limit`, at most 2^32, on a mod-30 wheel:
+ * one byte covers 30 integers with a bit for each of the eight residues
+ * coprime to 30, about 137 MiB at the maximum limit. Tables are built in
+ * memory or mapped from a file written by crng_prime_table_save. The layout
+ * is public so a table can live in caller storage; direct mutation is outside
+ * the API contract. A zero-initialized table is empty.
+ */
+typedef struct crng_prime_table {
+    const unsigned char *bits;
+    uint64_t limit;
+    void *storage;
+    size_t storage_size;
+    int mapped;
+} crng_prime_table;
+
+/**
+ * Sieve the primes below limit, 1 through CRNG_PRIME_TABLE_MAX_LIMIT, into a
+ * heap-allocated table. Any previous contents are overwritten, not released.
+ * On failure the table is left empty.
+ */
+CRNG_API crng_status crng_prime_table_build(crng_prime_table *table, uint64_t limit);
+
+/** Write a table to `path` in the little-endian file format read by map. */
+CRNG_API crng_status crng_prime_table_save(const crng_prime_table *table, const char *path);
+
+/**
+ * Map a saved table read-only; targets without mmap read it into memory.
+ * Returns CRNG_ERR_FORMAT for a bad header or size. On failure the table is
+ * left empty. Any previous contents are overwritten, not released.
+ */
+CRNG_API crng_status crng_prime_table_map(crng_prime_table *table, const char *path);
+
+/** Release a built or mapped table and leave it empty. Null is ignored. */
+CRNG_API void crng_prime_table_free(crng_prime_table *table);
+
+/**
+ * Classify `value` with one bitmap lookup when it is below the table limit,
+ * and with crng_crypto_is_prime_u64 otherwise. A null or empty table always
+ * falls back. The table may be shared by concurrent readers.
+ */
+CRNG_API bool crng_prime_table_is_prime(const crng_prime_table *table, uint64_t value);
+
 /**
  * Search for a prime in inclusive [minimum, maximum] from uniform OS-random
  * candidates. Values below two are excluded. Returns CRNG_ERR_NOT_FOUND after
@@ -58,6 +356,72 @@ CRNG_API crng_status crng_crypto_random_prime_u64(
     uint64_t *out
 );
 
+/**
+ * Search for a prime in inclusive [minimum, maximum] by walking upward from
+ * one uniform OS-random start and wrapping to minimum. Odd candidates are
+ * sieved by small primes before full classification. Each odd candidate
+ * visited consumes one of max_attempts. A prime is chosen with probability
+ * proportional to the gap below it, not uniformly. Write `out` only on
+ * success.
+ */
+CRNG_API crng_status crng_crypto_random_prime_u64_sieved(
+    uint64_t minimum,
+    uint64_t maximum,
+    uint64_t max_attempts,
+    uint64_t *out
+);
+
+/**
+ * Sieved search, as crng_crypto_random_prime_u64_sieved, restricted to primes
+ * p == residue (mod modulus). Requires modulus > 0 and residue < modulus. A
+ * class whose residue shares a factor with the modulus can contain only its
+ * least positive member, which is tested directly. Each class member visited
+ * consumes one of max_attempts. Write `out` only on success.
+ */
+CRNG_API crng_status crng_crypto_random_prime_congruent_u64(
+    uint64_t minimum,
+    uint64_t maximum,
+    uint64_t residue,
+    uint64_t modulus,
+    uint64_t max_attempts,
+    uint64_t *out
+);
+
+/**
+ * Sieved search for a safe prime p, one where (p - 1) / 2 is also prime, in
+ * inclusive [minimum, maximum]. Requires maximum >= 5. Candidates above 7 are
+ * restricted to 11 (mod 12) and sieved for small factors of both p and
+ * (p - 1) / 2. Each candidate visited consumes one of max_attempts; selection
+ * is gap-weighted. Write `out` only on success.
+ */
+CRNG_API crng_status crng_crypto_random_safe_prime_u64(
+    uint64_t minimum,
+    uint64_t maximum,
+    uint64_t max_attempts,
+    uint64_t *out
+);
+
+/**
+ * Classify a 128-bit value. Values below 2^64 get the deterministic
+ * crng_crypto_is_prime_u64 result. Larger values are screened by small primes
+ * and then run Baillie-PSW: no composite is known to pass, but none has been
+ * proven absent, so a true result there means probable prime.
+ */
+CRNG_API bool crng_crypto_is_prime_u128(crng_u128 value);
+
+/**
+ * Search for a prime in inclusive [minimum, maximum] from uniform OS-random
+ * 128-bit candidates, as crng_crypto_random_prime_u64 does for 64 bits.
+ * Candidates at or above 2^64 are classified by crng_crypto_is_prime_u128.
+ * Write `out` only on success.
+ */
+CRNG_API crng_status crng_crypto_random_prime_u128(
+    crng_u128 minimum,
+    crng_u128 maximum,
+    uint64_t max_attempts,
+    crng_u128 *out
+);
+
 #ifdef __cplusplus
 }
 #endif
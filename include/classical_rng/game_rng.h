@@ -41,20 +41,53 @@ typedef struct crng_roundoff_sample {
     uint64_t mixed_residue;
 } crng_roundoff_sample;
 
+/**
+ * Consumption counters for one generator. Every crng_game_rng carries them,
+ * so the structure's layout never depends on the build; they stay zero unless
+ * the library is built with CRNG_ENABLE_STATS.
+ */
+typedef struct crng_game_rng_stats {
+    /** 64-bit outputs generated by every entry point. */
+    uint64_t draws;
+    /** Bounded results from uniform_u64 and range_i32. */
+    uint64_t uniform_results;
+    /** Outputs discarded by rejection in uniform_u64 and range_i32. */
+    uint64_t uniform_rejections;
+    /** Generated bytes dropped from the partial final word of a fill. */
+    uint64_t fill_discarded_bytes;
+} crng_game_rng_stats;
+
+/**
+ * Registered deterministic output functions. Each identifier names one frozen
+ * algorithm: the stream a seed produces under it never changes, and a changed
+ * algorithm is registered under a new identifier. Every tier shares the
+ * xoshiro256 transition, seeding, and the rest of the API.
+ */
+typedef enum crng_game_rng_algorithm {
+    /** xoshiro256** mixed with pi/e remainders at 200 fractional digits; the default. */
+    CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_200 = 1,
+    /** The same roundoff mixing with pi and e cut to 18 fractional digits. */
+    CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_18 = 2,
+    /** Plain xoshiro256** output with no roundoff step. */
+    CRNG_GAME_RNG_ALGORITHM_XOSHIRO256SS = 3
+} crng_game_rng_algorithm;
+
 /**
  * State for the deterministic game/simulation generator.
  *
  * Keep one state per stream. Concurrent access to the same object requires
  * synchronization; different objects may be used concurrently. The layout is
- * public for inspection, but direct mutation and cross-version serialization
- * are outside the API contract.
+ * public for inspection, but direct mutation is outside the API contract;
+ * persist a stream with crng_game_rng_serialize, not its raw bytes.
  */
 typedef struct crng_game_rng {
     uint64_t state[4];
     uint64_t step;
+    crng_game_rng_algorithm algorithm;
     crng_high_precision_decimal pi;
     crng_high_precision_decimal e;
     crng_roundoff_sample last_roundoff;
+    crng_game_rng_stats stats;
 } crng_game_rng;
 
 /**
@@ -65,7 +98,8 @@ CRNG_API const char *crng_game_rng_constant_decimal(const char *name);
 
 /**
  * Copy the exact fixed-point division residues used for the latest output.
- * A freshly seeded generator reports an all-zero sample until its first draw.
+ * A freshly seeded generator reports an all-zero sample until its first draw,
+ * and a CRNG_GAME_RNG_ALGORITHM_XOSHIRO256SS stream always does.
  */
 CRNG_API crng_status crng_game_rng_last_roundoff(
     const crng_game_rng *rng,
@@ -73,11 +107,27 @@ CRNG_API crng_status crng_game_rng_last_roundoff(
 );
 
 /**
- * Initialize a deterministic game/simulation stream from a 64-bit seed.
- * Every seed value is valid. A null pointer is ignored.
+ * Initialize a deterministic game/simulation stream from a 64-bit seed under
+ * CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_200. Every seed value is valid. A null
+ * pointer is ignored.
  */
 CRNG_API void crng_game_rng_seed(crng_game_rng *rng, uint64_t seed);
 
+/**
+ * Initialize a stream from a 64-bit seed under a registered algorithm. The
+ * transition words are those crng_game_rng_seed derives; only the output
+ * function differs. An unknown algorithm returns CRNG_ERR_INVALID_RANGE and
+ * leaves `rng` unchanged.
+ */
+CRNG_API crng_status crng_game_rng_seed_algorithm(
+    crng_game_rng *rng,
+    uint64_t seed,
+    crng_game_rng_algorithm algorithm
+);
+
+/** Return static text naming an algorithm, or "unknown". */
+CRNG_API const char *crng_game_rng_algorithm_name(crng_game_rng_algorithm algorithm);
+
 /**
  * Initialize a game/simulation stream from one OS-random 64-bit seed.
  * The resulting stream remains a noncryptographic deterministic stream.
@@ -124,14 +174,110 @@ CRNG_API crng_status crng_game_rng_range_i32(
     int32_t *out
 );
 
+/**
+ * Undo the latest engine step and return the output it produced, which the
+ * next crng_game_rng_next_u64 call will return again. Step, transition words,
+ * and last roundoff sample become exactly what they were before that step;
+ * counters are not rolled back. At step zero, return zero and change nothing.
+ */
+CRNG_API uint64_t crng_game_rng_prev_u64(crng_game_rng *rng);
+
+/**
+ * Undo `count` engine steps, restoring step, transition words, and the last
+ * roundoff sample exactly. Each step costs a few shifts and XORs; the sample
+ * is recomputed once. A count greater than the current step is invalid.
+ */
+CRNG_API crng_status crng_game_rng_rewind(crng_game_rng *rng, uint64_t count);
+
 /**
  * Generate `k / 2^53` in [0, 1), using the upper 53 output bits.
  * `rng` must point to a seeded object.
  */
 CRNG_API double crng_game_rng_next_double(crng_game_rng *rng);
 
+/**
+ * Copy the counters accumulated since the last seed or reset. Returns
+ * CRNG_ERR_UNSUPPORTED when the library was built without CRNG_ENABLE_STATS.
+ */
+CRNG_API crng_status crng_game_rng_read_stats(
+    const crng_game_rng *rng,
+    crng_game_rng_stats *out
+);
+
+/** Zero a generator's counters; CRNG_ERR_UNSUPPORTED without stats. */
+CRNG_API crng_status crng_game_rng_reset_stats(crng_game_rng *rng);
+
+/**
+ * Identifier of the algorithm crng_game_rng_seed selects, the registry's
+ * CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_200. Records carry the identifier of their
+ * own stream's algorithm, and identifiers this library does not register are
+ * refused.
+ */
+#define CRNG_GAME_RNG_ALGORITHM_REVISION 1
+
+/** Size of one serialized generator record. */
+#define CRNG_GAME_RNG_RECORD_BYTES 48
+
+/**
+ * Write a CRNG_GAME_RNG_RECORD_BYTES record of the stream position: the
+ * transition words and step, tagged with the format version and algorithm
+ * identifier and closed by a CRC-32. The bytes are the same on every
+ * architecture. Counters and the last roundoff sample are not recorded.
+ */
+CRNG_API crng_status crng_game_rng_serialize(
+    const crng_game_rng *rng,
+    unsigned char *out
+);
+
+/**
+ * Restore a generator from a serialized record. The restored stream
+ * continues exactly where the saved one stopped; its last roundoff sample
+ * and counters start at zero, as after seeding. A record with a bad tag,
+ * an unknown algorithm, a checksum mismatch, or an all-zero state returns
+ * CRNG_ERR_FORMAT and leaves `rng` unchanged.
+ */
+CRNG_API crng_status crng_game_rng_deserialize(
+    crng_game_rng *rng,
+    const unsigned char *record
+);
+
+/** Serialize `count` generators into consecutive records. */
+CRNG_API crng_status crng_game_rng_serialize_array(
+    const crng_game_rng *rngs,
+    unsigned char *out,
+    size_t count
+);
+
+/**
+ * Restore `count` generators from consecutive records. Every record is
+ * checked before any generator is written, so CRNG_ERR_FORMAT leaves all of
+ * them unchanged.
+ */
+CRNG_API crng_status crng_game_rng_deserialize_array(
+    crng_game_rng *rngs,
+    const unsigned char *records,
+    size_t count
+);
+
 #ifdef __cplusplus
 }
 #endif
 
+/*
+ * With CRNG_INLINE_IMPL, consuming code draws through the static inline
+ * kernel in game_rng_inline.h instead of exported calls. Outputs are
+ * identical; a parenthesized name such as (crng_game_rng_next_u64)(rng)
+ * still calls the library.
+ */
+#if defined(CRNG_INLINE_IMPL) && !defined(CRNG_BUILDING_LIBRARY)
+#  include "classical_rng/game_rng_inline.h"
+#  define crng_game_rng_next_u64(rng) crng_game_rng_inline_next_u64(rng)
+#  define crng_game_rng_next_u32(rng) crng_game_rng_inline_next_u32(rng)
+#  define crng_game_rng_next_double(rng) crng_game_rng_inline_next_double(rng)
+#  define crng_game_rng_uniform_u64(rng, upper_bound, out) \
+    crng_game_rng_inline_uniform_u64(rng, upper_bound, out)
+#  define crng_game_rng_range_i32(rng, minimum, maximum, out) \
+    crng_game_rng_inline_range_i32(rng, minimum, maximum, out)
+#endif
+
 #endif /* CLASSICAL_RNG_GAME_RNG_H */
@@ -0,0 +1,245 @@
+#ifndef CLASSICAL_RNG_GAME_RNG_INLINE_H
+#define CLASSICAL_RNG_GAME_RNG_INLINE_H
+
+/*
+ * Header-only kernel of the deterministic generator. The library's own
+ * crng_game_rng_next_u64 is built from these functions, so the inline and
+ * exported paths produce the same outputs, roundoff samples, and counters.
+ * Including this header lets a compiler inline a draw into a caller's loop
+ * and hoist the rejection threshold of a loop-invariant bound. The inline
+ * paths fire no static tracepoints.
+ *
+ * Seed through the library; then call these functions, or define
+ * CRNG_INLINE_IMPL before including classical_rng.h to route the ordinary
+ * next_u64, next_u32, next_double, uniform_u64, and range_i32 spellings
+ * here. The exported function stays reachable as, for example,
+ * (crng_game_rng_next_u64)(rng).
+ */
+#include "classical_rng/game_rng.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* The library's mixing constants; undefined again at the end of the header. */
+#define CRNG_INLINE_CONSTANT_E     UINT64_C(0xbf58476d1ce4e5b9)
+#define CRNG_INLINE_CONSTANT_PI    UINT64_C(0x94d049bb133111eb)
+#define CRNG_INLINE_CONSTANT_ROOT2 UINT64_C(0x6a09e667f3bcc909)
+
+static inline uint64_t crng_inline_rotate_left_64(uint64_t value, unsigned int shift) {
+    return (value << shift) | (value >> (64U - shift));
+}
+
+static inline uint64_t crng_inline_avalanche64(uint64_t value) {
+    value = (value ^ (value >> 30)) * CRNG_INLINE_CONSTANT_E;
+    value = (value ^ (value >> 27)) * CRNG_INLINE_CONSTANT_PI;
+    return value ^ (value >> 31);
+}
+
+static inline uint64_t crng_inline_xoshiro_raw(uint64_t word) {
+    return crng_inline_rotate_left_64(word * UINT64_C(5), 7U) * UINT64_C(9);
+}
+
+static inline uint32_t crng_inline_roundoff_divisor(uint64_t value) {
+    uint32_t divisor = (uint32_t)(value ^ (value >> 32));
+    divisor |= UINT32_C(1);
+    return divisor < UINT32_C(3) ? UINT32_C(3) : divisor;
+}
+
+/*
+ * Euclidean remainders of pi and e by their divisors. Only the remainders
+ * are needed, so no quotient is stored, and the two independent division
+ * chains share one loop. Each partial value stays below divisor * 10^9.
+ */
+static inline void crng_inline_constant_remainders(
+    const crng_game_rng *rng,
+    uint32_t pi_divisor,
+    uint32_t e_divisor,
+    uint32_t *pi_remainder,
+    uint32_t *e_remainder
+) {
+    const size_t limbs = rng->pi.used > rng->e.used ? rng->pi.used : rng->e.used;
+    uint64_t pi_value = 0;
+    uint64_t e_value = 0;
+    size_t index;
+
+    for (index = limbs; index > 0; --index) {
+        const uint32_t pi_limb = index <= rng->pi.used ? rng->pi.limbs[index - 1] : 0U;
+        const uint32_t e_limb = index <= rng->e.used ? rng->e.limbs[index - 1] : 0U;
+
+        pi_value = (pi_value * UINT64_C(1000000000) + pi_limb) % pi_divisor;
+        e_value = (e_value * UINT64_C(1000000000) + e_limb) % e_divisor;
+    }
+    *pi_remainder = (uint32_t)pi_value;
+    *e_remainder = (uint32_t)e_value;
+}
+
+/*
+ * The roundoff kernel: derive both divisors from the raw xoshiro output and
+ * the advanced state, record the sample in last_roundoff, and return its
+ * mixed residue.
+ */
+static inline uint64_t crng_inline_collect_roundoff(crng_game_rng *rng, uint64_t raw) {
+    const uint32_t pi_divisor = crng_inline_roundoff_divisor(
+        raw ^ rng->state[0] ^ rng->step
+    );
+    const uint32_t e_divisor = crng_inline_roundoff_divisor(
+        crng_inline_rotate_left_64(raw, 29U) ^ rng->state[3]
+        ^ (rng->step * CRNG_INLINE_CONSTANT_E)
+    );
+    uint32_t pi_remainder;
+    uint32_t e_remainder;
+    uint64_t residue_word;
+
+    crng_inline_constant_remainders(rng, pi_divisor, e_divisor, &pi_remainder, &e_remainder);
+    rng->last_roundoff.step = rng->step;
+    rng->last_roundoff.pi.divisor = pi_divisor;
+    rng->last_roundoff.pi.remainder = pi_remainder;
+    rng->last_roundoff.e.divisor = e_divisor;
+    rng->last_roundoff.e.remainder = e_remainder;
+
+    residue_word = ((uint64_t)pi_remainder << 32) | e_remainder;
+    residue_word ^= ((uint64_t)pi_divisor << 17);
+    residue_word ^= crng_inline_rotate_left_64((uint64_t)e_divisor, 43U);
+    rng->last_roundoff.mixed_residue = crng_inline_avalanche64(residue_word);
+    return rng->last_roundoff.mixed_residue;
+}
+
+/**
+ * Inline crng_game_rng_next_u64. The two roundoff tiers differ only in the
+ * precision of the pi/e tables loaded at seeding; xoshiro256** skips the
+ * roundoff step.
+ */
+static inline uint64_t crng_game_rng_inline_next_u64(crng_game_rng *rng) {
+    const uint64_t raw = crng_inline_xoshiro_raw(rng->state[1]);
+    const uint64_t temporary = rng->state[1] << 17;
+    uint64_t roundoff;
+
+    rng->state[2] ^= rng->state[0];
+    rng->state[3] ^= rng->state[1];
+    rng->state[1] ^= rng->state[2];
+    rng->state[0] ^= rng->state[3];
+    rng->state[2] ^= temporary;
+    rng->state[3] = crng_inline_rotate_left_64(rng->state[3], 45U);
+
+    ++rng->step;
+#if defined(CRNG_ENABLE_STATS)
+    ++rng->stats.draws;
+#endif
+    if (rng->algorithm == CRNG_GAME_RNG_ALGORITHM_XOSHIRO256SS) {
+        return raw;
+    }
+    roundoff = crng_inline_collect_roundoff(rng, raw);
+    return crng_inline_avalanche64(raw ^ roundoff ^ (rng->step * CRNG_INLINE_CONSTANT_ROOT2));
+}
+
+/** Inline crng_game_rng_next_u32. */
+static inline uint32_t crng_game_rng_inline_next_u32(crng_game_rng *rng) {
+    return (uint32_t)(crng_game_rng_inline_next_u64(rng) >> 32);
+}
+
+/** Inline crng_game_rng_next_double. */
+static inline double crng_game_rng_inline_next_double(crng_game_rng *rng) {
+    /* 2^-53, spelled without a hexadecimal literal for C++11 callers. */
+    return (double)(crng_game_rng_inline_next_u64(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/*
+ * Draw until an output is at least `threshold`, the rejection step shared by
+ * every bounded form. The caller reduces the accepted output modulo its bound.
+ */
+static inline uint64_t crng_game_rng_inline_accept(crng_game_rng *rng, uint64_t threshold) {
+    uint64_t value;
+
+    do {
+        value = crng_game_rng_inline_next_u64(rng);
+#if defined(CRNG_ENABLE_STATS)
+        if (value < threshold) {
+            ++rng->stats.uniform_rejections;
+        }
+#endif
+    } while (value < threshold);
+
+#if defined(CRNG_ENABLE_STATS)
+    ++rng->stats.uniform_results;
+#endif
+    return value;
+}
+
+/** Inline crng_game_rng_uniform_u64, with the same statuses. */
+static inline crng_status crng_game_rng_inline_uniform_u64(
+    crng_game_rng *rng,
+    uint64_t upper_bound,
+    uint64_t *out
+) {
+    if (rng == NULL || out == NULL) {
+        return CRNG_ERR_NULL;
+    }
+    if (upper_bound == 0) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+
+    *out = crng_game_rng_inline_accept(rng, (UINT64_C(0) - upper_bound) % upper_bound)
+           % upper_bound;
+    return CRNG_OK;
+}
+
+/** Inline crng_game_rng_range_i32, with the same statuses. */
+static inline crng_status crng_game_rng_inline_range_i32(
+    crng_game_rng *rng,
+    int32_t minimum,
+    int32_t maximum,
+    int32_t *out
+) {
+    uint64_t offset;
+    uint64_t span;
+    crng_status status;
+
+    if (rng == NULL || out == NULL) {
+        return CRNG_ERR_NULL;
+    }
+    if (minimum > maximum) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+
+    span = (uint64_t)((int64_t)maximum - (int64_t)minimum) + UINT64_C(1);
+    status = crng_game_rng_inline_uniform_u64(rng, span, &offset);
+    if (status != CRNG_OK) {
+        return status;
+    }
+
+    *out = (int32_t)((int64_t)minimum + (int64_t)offset);
+    return CRNG_OK;
+}
+
+/*
+ * Bounded draws for bounds known at compile time, in C. The rejection
+ * threshold is folded into a constant and `% bound` compiles to a multiply
+ * and shift, or to a mask for a power of two, which also never rejects, so
+ * no division runs. Results, consumption, and counters equal
+ * crng_game_rng_uniform_u64 and crng_game_rng_range_i32 with the same
+ * arguments. `rng` must be seeded; it is evaluated once. A bound that is
+ * zero or not an integer constant expression is a compile-time error. C++
+ * code uses crng::uniform<N> from classical_rng.hpp instead.
+ */
+#define CRNG_GAME_RNG_CONSTANT_THRESHOLD(bound) \
+    ((UINT64_C(0) - (uint64_t)(bound)) % (uint64_t)(bound))
+#define CRNG_GAME_RNG_REQUIRE_CONSTANT(condition) \
+    ((void)sizeof(struct { int crng_constant_bound_check : (condition) ? 1 : -1; }))
+
+/** A uint64_t uniform in [0, bound). */
+#define CRNG_GAME_RNG_UNIFORM_CONSTANT(rng, bound) \
+    (CRNG_GAME_RNG_REQUIRE_CONSTANT((bound) != 0), \
+     crng_game_rng_inline_accept((rng), CRNG_GAME_RNG_CONSTANT_THRESHOLD(bound)) \
+         % (uint64_t)(bound))
+
+/** An int32_t uniform in inclusive [minimum, maximum], both int32_t constants. */
+#define CRNG_GAME_RNG_RANGE_CONSTANT(rng, minimum, maximum) \
+    (CRNG_GAME_RNG_REQUIRE_CONSTANT((minimum) <= (maximum)), \
+     (int32_t)((int64_t)(minimum) + (int64_t)CRNG_GAME_RNG_UNIFORM_CONSTANT( \
+         (rng), (uint64_t)((int64_t)(maximum) - (int64_t)(minimum)) + UINT64_C(1))))
+
+#undef CRNG_INLINE_CONSTANT_E
+#undef CRNG_INLINE_CONSTANT_PI
+#undef CRNG_INLINE_CONSTANT_ROOT2
+
+#endif /* CLASSICAL_RNG_GAME_RNG_INLINE_H */
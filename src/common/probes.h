@@ -0,0 +1,22 @@
+#ifndef CLASSICAL_RNG_INTERNAL_PROBES_H
+#define CLASSICAL_RNG_INTERNAL_PROBES_H
+
+/*
+ * Static tracepoints in the "classical_rng" provider. With CRNG_ENABLE_USDT
+ * the probes come from the header-only <sys/sdt.h>: each site is a single
+ * nop plus an ELF note naming it and locating its arguments, and nothing
+ * runs until a tracer such as bpftrace attaches. Without the option every
+ * probe expands to nothing and its arguments are not evaluated.
+ */
+#if defined(CRNG_ENABLE_USDT)
+#  include <sys/sdt.h>
+#  define CRNG_PROBE1(name, a) DTRACE_PROBE1(classical_rng, name, a)
+#  define CRNG_PROBE2(name, a, b) DTRACE_PROBE2(classical_rng, name, a, b)
+#  define CRNG_PROBE3(name, a, b, c) DTRACE_PROBE3(classical_rng, name, a, b, c)
+#else
+#  define CRNG_PROBE1(name, a) ((void)0)
+#  define CRNG_PROBE2(name, a, b) ((void)0)
+#  define CRNG_PROBE3(name, a, b, c) ((void)0)
+#endif
+
+#endif /* CLASSICAL_RNG_INTERNAL_PROBES_H */
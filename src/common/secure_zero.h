@@ -0,0 +1,16 @@
+#ifndef CLASSICAL_RNG_INTERNAL_SECURE_ZERO_H
+#define CLASSICAL_RNG_INTERNAL_SECURE_ZERO_H
+
+#include <stddef.h>
+
+/* Erase secret scratch memory through volatile stores the compiler keeps. */
+static inline void crng_secure_zero(void *buffer, size_t size) {
+    volatile unsigned char *bytes = (volatile unsigned char *)buffer;
+
+    while (size != 0) {
+        *bytes++ = 0;
+        --size;
+    }
+}
+
+#endif /* CLASSICAL_RNG_INTERNAL_SECURE_ZERO_H */
@@ -0,0 +1,52 @@
+#include "classical_rng/crypto_rng.h"
+#include "stats.h"
+
+#include <stddef.h>
+
+#if defined(CRNG_ENABLE_STATS)
+crng_secure_counter_set crng_secure_counters;
+#endif
+
+crng_status crng_secure_read_stats(crng_secure_stats *out) {
+    if (out == NULL) {
+        return CRNG_ERR_NULL;
+    }
+#if defined(CRNG_ENABLE_STATS)
+    out->entropy_calls = crng_stat_load(&crng_secure_counters.entropy_calls);
+    out->entropy_bytes = crng_stat_load(&crng_secure_counters.entropy_bytes);
+    out->entropy_failures = crng_stat_load(&crng_secure_counters.entropy_failures);
+    out->uniform_results = crng_stat_load(&crng_secure_counters.uniform_results);
+    out->uniform_rejections = crng_stat_load(&crng_secure_counters.uniform_rejections);
+    out->pool_bytes = crng_stat_load(&crng_secure_counters.pool_bytes);
+    out->pool_reseeds = crng_stat_load(&crng_secure_counters.pool_reseeds);
+    out->pool_uniform_results = crng_stat_load(&crng_secure_counters.pool_uniform_results);
+    out->pool_uniform_rejections =
+        crng_stat_load(&crng_secure_counters.pool_uniform_rejections);
+    out->prime_searches = crng_stat_load(&crng_secure_counters.prime_searches);
+    out->prime_attempts = crng_stat_load(&crng_secure_counters.prime_attempts);
+    out->prime_not_found = crng_stat_load(&crng_secure_counters.prime_not_found);
+    return CRNG_OK;
+#else
+    return CRNG_ERR_UNSUPPORTED;
+#endif
+}
+
+crng_status crng_secure_reset_stats(void) {
+#if defined(CRNG_ENABLE_STATS)
+    (void)crng_stat_exchange(&crng_secure_counters.entropy_calls);
+    (void)crng_stat_exchange(&crng_secure_counters.entropy_bytes);
+    (void)crng_stat_exchange(&crng_secure_counters.entropy_failures);
+    (void)crng_stat_exchange(&crng_secure_counters.uniform_results);
+    (void)crng_stat_exchange(&crng_secure_counters.uniform_rejections);
+    (void)crng_stat_exchange(&crng_secure_counters.pool_bytes);
+    (void)crng_stat_exchange(&crng_secure_counters.pool_reseeds);
+    (void)crng_stat_exchange(&crng_secure_counters.pool_uniform_results);
+    (void)crng_stat_exchange(&crng_secure_counters.pool_uniform_rejections);
+    (void)crng_stat_exchange(&crng_secure_counters.prime_searches);
+    (void)crng_stat_exchange(&crng_secure_counters.prime_attempts);
+    (void)crng_stat_exchange(&crng_secure_counters.prime_not_found);
+    return CRNG_OK;
+#else
+    return CRNG_ERR_UNSUPPORTED;
+#endif
+}
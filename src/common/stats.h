@@ -0,0 +1,74 @@
+#ifndef CLASSICAL_RNG_INTERNAL_STATS_H
+#define CLASSICAL_RNG_INTERNAL_STATS_H
+
+#include <stdint.h>
+
+/*
+ * Instrumentation hooks. Without CRNG_ENABLE_STATS every hook expands to
+ * nothing and its arguments are not evaluated. With it, per-generator counts
+ * live in crng_game_rng and secure-path counts are process-wide relaxed
+ * atomics: totals are exact, but a concurrent read is not a snapshot.
+ */
+#if defined(CRNG_ENABLE_STATS)
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+typedef volatile __int64 crng_stat_counter;
+
+static inline void crng_stat_add(crng_stat_counter *counter, uint64_t amount) {
+    (void)_InterlockedExchangeAdd64(counter, (__int64)amount);
+}
+
+static inline uint64_t crng_stat_exchange(crng_stat_counter *counter) {
+    return (uint64_t)_InterlockedExchange64(counter, 0);
+}
+
+static inline uint64_t crng_stat_load(crng_stat_counter *counter) {
+    return (uint64_t)_InterlockedCompareExchange64(counter, 0, 0);
+}
+#  elif !defined(__STDC_NO_ATOMICS__)
+#    include <stdatomic.h>
+typedef atomic_uint_fast64_t crng_stat_counter;
+
+static inline void crng_stat_add(crng_stat_counter *counter, uint64_t amount) {
+    (void)atomic_fetch_add_explicit(counter, (uint_fast64_t)amount, memory_order_relaxed);
+}
+
+static inline uint64_t crng_stat_exchange(crng_stat_counter *counter) {
+    return (uint64_t)atomic_exchange_explicit(counter, 0U, memory_order_relaxed);
+}
+
+static inline uint64_t crng_stat_load(crng_stat_counter *counter) {
+    return (uint64_t)atomic_load_explicit(counter, memory_order_relaxed);
+}
+#  else
+#    error "CRNG_ENABLE_STATS requires C11 atomics or MSVC interlocked intrinsics"
+#  endif
+
+/* Field-for-field counterpart of the public crng_secure_stats. */
+typedef struct crng_secure_counter_set {
+    crng_stat_counter entropy_calls;
+    crng_stat_counter entropy_bytes;
+    crng_stat_counter entropy_failures;
+    crng_stat_counter uniform_results;
+    crng_stat_counter uniform_rejections;
+    crng_stat_counter pool_bytes;
+    crng_stat_counter pool_reseeds;
+    crng_stat_counter pool_uniform_results;
+    crng_stat_counter pool_uniform_rejections;
+    crng_stat_counter prime_searches;
+    crng_stat_counter prime_attempts;
+    crng_stat_counter prime_not_found;
+} crng_secure_counter_set;
+
+extern crng_secure_counter_set crng_secure_counters;
+
+#  define CRNG_SECURE_STAT_ADD(field, amount) \
+    crng_stat_add(&crng_secure_counters.field, (uint64_t)(amount))
+#  define CRNG_GAME_STAT_ADD(rng, field, amount) \
+    ((rng)->stats.field += (uint64_t)(amount))
+#else
+#  define CRNG_SECURE_STAT_ADD(field, amount) ((void)0)
+#  define CRNG_GAME_STAT_ADD(rng, field, amount) ((void)0)
+#endif
+
+#endif /* CLASSICAL_RNG_INTERNAL_STATS_H */
@@ -14,6 +14,12 @@ const char *crng_status_string(crng_status status) {
             return "platform is not supported";
         case CRNG_ERR_NOT_FOUND:
             return "no matching value found within the attempt limit";
+        case CRNG_ERR_IO:
+            return "file input or output failed";
+        case CRNG_ERR_FORMAT:
+            return "malformed or incompatible data";
+        case CRNG_ERR_NO_MEMORY:
+            return "memory allocation failed";
         default:
             return "unknown classical_rng status";
     }
@@ -0,0 +1,162 @@
+#ifndef CLASSICAL_RNG_INTERNAL_CHACHA20_H
+#define CLASSICAL_RNG_INTERNAL_CHACHA20_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * ChaCha20 block functions for the secure pool, kept in a header so the unit
+ * tests can check both against RFC 8439. The scalar form is always defined;
+ * GCC and Clang also get the four-lane vector form, which the pool prefers.
+ */
+#define CRNG_CHACHA20_BLOCK_BYTES 64U
+
+/* A macro so the same quarter round serves scalar words and GNU vectors. */
+#define CRNG_CHACHA20_ROTATE(value, shift) \
+    (((value) << (shift)) | ((value) >> (32 - (shift))))
+
+static inline uint32_t crng_chacha20_load_le32(const unsigned char *bytes) {
+    return (uint32_t)bytes[0]
+           | ((uint32_t)bytes[1] << 8)
+           | ((uint32_t)bytes[2] << 16)
+           | ((uint32_t)bytes[3] << 24);
+}
+
+static inline void crng_chacha20_store_le32(unsigned char *bytes, uint32_t value) {
+    bytes[0] = (unsigned char)value;
+    bytes[1] = (unsigned char)(value >> 8);
+    bytes[2] = (unsigned char)(value >> 16);
+    bytes[3] = (unsigned char)(value >> 24);
+}
+
+#define CRNG_CHACHA20_QUARTER(a, b, c, d)          \
+    do {                                           \
+        (a) += (b);                                \
+        (d) = CRNG_CHACHA20_ROTATE((d) ^ (a), 16); \
+        (c) += (d);                                \
+        (b) = CRNG_CHACHA20_ROTATE((b) ^ (c), 12); \
+        (a) += (b);                                \
+        (d) = CRNG_CHACHA20_ROTATE((d) ^ (a), 8);  \
+        (c) += (d);                                \
+        (b) = CRNG_CHACHA20_ROTATE((b) ^ (c), 7);  \
+    } while (0)
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define CRNG_CHACHA20_LANES 4U
+
+typedef uint32_t crng_chacha20_vector __attribute__((vector_size(16)));
+
+/*
+ * The RFC 8439 block function for four consecutive counters, which run in
+ * the lanes of one GNU vector per word.
+ */
+static inline void crng_chacha20_blocks4(
+    const uint32_t key[8],
+    uint32_t counter,
+    const uint32_t nonce[3],
+    unsigned char out[CRNG_CHACHA20_BLOCK_BYTES * CRNG_CHACHA20_LANES]
+) {
+    static const uint32_t sigma[4] = {
+        UINT32_C(0x61707865), UINT32_C(0x3320646e),
+        UINT32_C(0x79622d32), UINT32_C(0x6b206574)
+    };
+    crng_chacha20_vector input[16];
+    crng_chacha20_vector state[16];
+    size_t index;
+    size_t lane;
+    int round;
+
+    for (index = 0; index < 4; ++index) {
+        const crng_chacha20_vector word = {
+            sigma[index], sigma[index], sigma[index], sigma[index]
+        };
+        input[index] = word;
+    }
+    for (index = 0; index < 8; ++index) {
+        const crng_chacha20_vector word = {
+            key[index], key[index], key[index], key[index]
+        };
+        input[4 + index] = word;
+    }
+    {
+        const crng_chacha20_vector counters = {
+            counter, counter + 1U, counter + 2U, counter + 3U
+        };
+        input[12] = counters;
+    }
+    for (index = 0; index < 3; ++index) {
+        const crng_chacha20_vector word = {
+            nonce[index], nonce[index], nonce[index], nonce[index]
+        };
+        input[13 + index] = word;
+    }
+    memcpy(state, input, sizeof(state));
+
+    for (round = 0; round < 10; ++round) {
+        CRNG_CHACHA20_QUARTER(state[0], state[4], state[8], state[12]);
+        CRNG_CHACHA20_QUARTER(state[1], state[5], state[9], state[13]);
+        CRNG_CHACHA20_QUARTER(state[2], state[6], state[10], state[14]);
+        CRNG_CHACHA20_QUARTER(state[3], state[7], state[11], state[15]);
+        CRNG_CHACHA20_QUARTER(state[0], state[5], state[10], state[15]);
+        CRNG_CHACHA20_QUARTER(state[1], state[6], state[11], state[12]);
+        CRNG_CHACHA20_QUARTER(state[2], state[7], state[8], state[13]);
+        CRNG_CHACHA20_QUARTER(state[3], state[4], state[9], state[14]);
+    }
+
+    for (index = 0; index < 16; ++index) {
+        state[index] += input[index];
+    }
+    for (lane = 0; lane < CRNG_CHACHA20_LANES; ++lane) {
+        for (index = 0; index < 16; ++index) {
+            crng_chacha20_store_le32(
+                out + lane * CRNG_CHACHA20_BLOCK_BYTES + index * 4U,
+                state[index][lane]
+            );
+        }
+    }
+}
+#endif
+
+/* The RFC 8439 block function, one counter at a time. */
+static inline void crng_chacha20_block(
+    const uint32_t key[8],
+    uint32_t counter,
+    const uint32_t nonce[3],
+    unsigned char out[CRNG_CHACHA20_BLOCK_BYTES]
+) {
+    uint32_t input[16];
+    uint32_t state[16];
+    size_t index;
+    int round;
+
+    input[0] = UINT32_C(0x61707865);
+    input[1] = UINT32_C(0x3320646e);
+    input[2] = UINT32_C(0x79622d32);
+    input[3] = UINT32_C(0x6b206574);
+    for (index = 0; index < 8; ++index) {
+        input[4 + index] = key[index];
+    }
+    input[12] = counter;
+    input[13] = nonce[0];
+    input[14] = nonce[1];
+    input[15] = nonce[2];
+    memcpy(state, input, sizeof(state));
+
+    for (round = 0; round < 10; ++round) {
+        CRNG_CHACHA20_QUARTER(state[0], state[4], state[8], state[12]);
+        CRNG_CHACHA20_QUARTER(state[1], state[5], state[9], state[13]);
+        CRNG_CHACHA20_QUARTER(state[2], state[6], state[10], state[14]);
+        CRNG_CHACHA20_QUARTER(state[3], state[7], state[11], state[15]);
+        CRNG_CHACHA20_QUARTER(state[0], state[5], state[10], state[15]);
+        CRNG_CHACHA20_QUARTER(state[1], state[6], state[11], state[12]);
+        CRNG_CHACHA20_QUARTER(state[2], state[7], state[8], state[13]);
+        CRNG_CHACHA20_QUARTER(state[3], state[4], state[9], state[14]);
+    }
+
+    for (index = 0; index < 16; ++index) {
+        crng_chacha20_store_le32(out + index * 4U, state[index] + input[index]);
+    }
+}
+
+#endif /* CLASSICAL_RNG_INTERNAL_CHACHA20_H */
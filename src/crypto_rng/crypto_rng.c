@@ -1,7 +1,12 @@
 #include "classical_rng/crypto_rng.h"
+#include "../common/probes.h"
+#include "../common/secure_zero.h"
+#include "../common/stats.h"
+#include "small_primes.h"
 
 #include <errno.h>
 #include <limits.h>
+#include <string.h>
 
 #if defined(_WIN32)
 #  define WIN32_LEAN_AND_MEAN
@@ -12,10 +17,27 @@
 #  include <stdlib.h>
 #else
 #  include <fcntl.h>
+#  include <sys/stat.h>
 #  include <unistd.h>
+#  if !defined(__STDC_NO_ATOMICS__)
+#    include <stdatomic.h>
+#    define CRNG_USE_BACKEND_CACHE 1
+#  endif
 #  if defined(__linux__) && !defined(__ANDROID__)
 #    include <sys/random.h>
 #    define CRNG_USE_GETRANDOM 1
+#    if defined(CRNG_USE_BACKEND_CACHE)
+#      include <elf.h>
+#      include <pthread.h>
+#      include <sys/auxv.h>
+#      include <sys/mman.h>
+#      define CRNG_USE_VDSO_GETRANDOM 1
+#      if defined(__GLIBC__) && \
+          (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 41))
+/* glibc 2.41 and newer already route getrandom() through the vDSO. */
+#        define CRNG_LIBC_VDSO_GETRANDOM 1
+#      endif
+#    endif
 #  elif defined(__ANDROID__) && defined(__ANDROID_API__) && \
         __ANDROID_API__ >= 28
 #    include <sys/random.h>
@@ -25,47 +47,425 @@
 
 #if !defined(_WIN32) && !defined(__APPLE__) && !defined(__FreeBSD__) && \
     !defined(__OpenBSD__) && !defined(__NetBSD__) && !defined(__DragonFly__)
-static crng_status crng_read_urandom(unsigned char *buffer, size_t size) {
-    int descriptor;
+static int crng_urandom_open(void) {
     int flags = O_RDONLY;
 
 #  if defined(O_CLOEXEC)
     flags |= O_CLOEXEC;
 #  endif
-    descriptor = open("/dev/urandom", flags);
-    if (descriptor < 0) {
-        return CRNG_ERR_SYSTEM;
-    }
+    return open("/dev/urandom", flags);
+}
 
-    while (size != 0) {
-        const size_t chunk = size > (size_t)1048576 ? (size_t)1048576 : size;
-        ssize_t count = read(descriptor, buffer, chunk);
+/* Read until done; return zero or the errno value that stopped the loop. */
+static int crng_read_descriptor(int descriptor, unsigned char **buffer, size_t *size) {
+    while (*size != 0) {
+        const size_t chunk = *size > (size_t)1048576 ? (size_t)1048576 : *size;
+        ssize_t count = read(descriptor, *buffer, chunk);
         if (count > 0) {
-            buffer += (size_t)count;
-            size -= (size_t)count;
+            *buffer += (size_t)count;
+            *size -= (size_t)count;
         } else if (count < 0 && errno == EINTR) {
             continue;
         } else {
-            (void)close(descriptor);
-            return CRNG_ERR_SYSTEM;
+            return count < 0 ? errno : EIO;
+        }
+    }
+    return 0;
+}
+
+#  if defined(CRNG_USE_BACKEND_CACHE)
+/*
+ * One close-on-exec descriptor shared by every caller. The device number is
+ * rechecked before each read so a descriptor the application closed, and
+ * the kernel reused for another file, is never read as entropy.
+ */
+static atomic_int crng_urandom_descriptor = -1;
+static atomic_uint_fast64_t crng_urandom_device;
+
+static int crng_urandom_is_device(int descriptor) {
+    struct stat status;
+
+    return fstat(descriptor, &status) == 0 && S_ISCHR(status.st_mode)
+           && (uint_fast64_t)status.st_rdev
+                  == atomic_load_explicit(&crng_urandom_device, memory_order_relaxed);
+}
+
+static int crng_urandom_cached(void) {
+    int descriptor = atomic_load_explicit(&crng_urandom_descriptor, memory_order_acquire);
+    int expected = -1;
+    struct stat status;
+
+    if (descriptor >= 0) {
+        if (crng_urandom_is_device(descriptor)) {
+            return descriptor;
         }
+        /* Not ours any more; drop it without closing the new owner's file. */
+        (void)atomic_compare_exchange_strong_explicit(
+            &crng_urandom_descriptor,
+            &descriptor,
+            -1,
+            memory_order_acq_rel,
+            memory_order_acquire
+        );
+    }
+
+    descriptor = crng_urandom_open();
+    if (descriptor < 0) {
+        return -1;
+    }
+    if (fstat(descriptor, &status) != 0 || !S_ISCHR(status.st_mode)) {
+        (void)close(descriptor);
+        return -1;
+    }
+    atomic_store_explicit(
+        &crng_urandom_device,
+        (uint_fast64_t)status.st_rdev,
+        memory_order_relaxed
+    );
+    if (!atomic_compare_exchange_strong_explicit(
+            &crng_urandom_descriptor,
+            &expected,
+            descriptor,
+            memory_order_acq_rel,
+            memory_order_acquire)) {
+        (void)close(descriptor);
+        return expected;
     }
+    return descriptor;
+}
+
+static crng_status crng_read_urandom(unsigned char *buffer, size_t size) {
+    const int descriptor = crng_urandom_cached();
+
+    if (descriptor < 0) {
+        return CRNG_ERR_SYSTEM;
+    }
+    return crng_read_descriptor(descriptor, &buffer, &size) == 0
+        ? CRNG_OK
+        : CRNG_ERR_SYSTEM;
+}
+#  else
+static crng_status crng_read_urandom(unsigned char *buffer, size_t size) {
+    const int descriptor = crng_urandom_open();
+    int error;
 
+    if (descriptor < 0) {
+        return CRNG_ERR_SYSTEM;
+    }
+    error = crng_read_descriptor(descriptor, &buffer, &size);
     (void)close(descriptor);
-    return CRNG_OK;
+    return error == 0 ? CRNG_OK : CRNG_ERR_SYSTEM;
 }
+#  endif
 #endif
 
-crng_status crng_secure_bytes(void *buffer, size_t size) {
-    unsigned char *bytes = (unsigned char *)buffer;
+#if defined(CRNG_USE_VDSO_GETRANDOM)
+#  if UINTPTR_MAX > UINT32_MAX
+typedef Elf64_Ehdr crng_elf_header;
+typedef Elf64_Phdr crng_elf_program;
+typedef Elf64_Dyn crng_elf_dynamic;
+typedef Elf64_Sym crng_elf_symbol;
+#    define CRNG_ELF_ST_TYPE ELF64_ST_TYPE
+#  else
+typedef Elf32_Ehdr crng_elf_header;
+typedef Elf32_Phdr crng_elf_program;
+typedef Elf32_Dyn crng_elf_dynamic;
+typedef Elf32_Sym crng_elf_symbol;
+#    define CRNG_ELF_ST_TYPE ELF32_ST_TYPE
+#  endif
 
-    if (size == 0) {
-        return CRNG_OK;
+/* Find a function exported by the kernel's vDSO image through DT_HASH. */
+static uintptr_t crng_vdso_symbol(const char *name) {
+    const uintptr_t base = (uintptr_t)getauxval(AT_SYSINFO_EHDR);
+    const crng_elf_header *header;
+    const crng_elf_program *programs;
+    const crng_elf_dynamic *dynamic = NULL;
+    const crng_elf_symbol *symbols = NULL;
+    const Elf32_Word *hash = NULL;
+    const char *strings = NULL;
+    uintptr_t load_offset = 0;
+    int have_load = 0;
+    size_t index;
+
+    if (base == 0) {
+        return 0;
     }
-    if (buffer == NULL) {
-        return CRNG_ERR_NULL;
+    header = (const crng_elf_header *)base;
+    programs = (const crng_elf_program *)(base + (uintptr_t)header->e_phoff);
+    for (index = 0; index < header->e_phnum; ++index) {
+        if (programs[index].p_type == PT_LOAD && have_load == 0) {
+            load_offset = base + (uintptr_t)programs[index].p_offset
+                          - (uintptr_t)programs[index].p_vaddr;
+            have_load = 1;
+        } else if (programs[index].p_type == PT_DYNAMIC) {
+            dynamic = (const crng_elf_dynamic *)(base + (uintptr_t)programs[index].p_offset);
+        }
+    }
+    if (have_load == 0 || dynamic == NULL) {
+        return 0;
+    }
+
+    for (; dynamic->d_tag != DT_NULL; ++dynamic) {
+        const uintptr_t address = load_offset + (uintptr_t)dynamic->d_un.d_ptr;
+        if (dynamic->d_tag == DT_STRTAB) {
+            strings = (const char *)address;
+        } else if (dynamic->d_tag == DT_SYMTAB) {
+            symbols = (const crng_elf_symbol *)address;
+        } else if (dynamic->d_tag == DT_HASH) {
+            hash = (const Elf32_Word *)address;
+        }
+    }
+    if (strings == NULL || symbols == NULL || hash == NULL) {
+        return 0;
+    }
+
+    /* The second DT_HASH word is the symbol count. */
+    for (index = 0; index < hash[1]; ++index) {
+        const crng_elf_symbol *symbol = &symbols[index];
+        if (CRNG_ELF_ST_TYPE(symbol->st_info) == STT_FUNC &&
+            symbol->st_shndx != SHN_UNDEF &&
+            strcmp(strings + symbol->st_name, name) == 0) {
+            return load_offset + (uintptr_t)symbol->st_value;
+        }
+    }
+    return 0;
+}
+
+/* x86 exports __vdso_getrandom; arm64, powerpc, and s390 use the kernel prefix. */
+static uintptr_t crng_vdso_getrandom_symbol(void) {
+    const uintptr_t address = crng_vdso_symbol("__vdso_getrandom");
+
+    return address != 0 ? address : crng_vdso_symbol("__kernel_getrandom");
+}
+
+#  if !defined(CRNG_LIBC_VDSO_GETRANDOM)
+#    define CRNG_VGETRANDOM_SLOTS 16U
+
+typedef ssize_t (*crng_vgetrandom_function)(
+    void *buffer,
+    size_t size,
+    unsigned int flags,
+    void *opaque_state,
+    size_t opaque_size
+);
+
+/* Layout fixed by the kernel's vgetrandom() parameter query. */
+typedef struct crng_vgetrandom_params {
+    uint32_t size_of_opaque_state;
+    uint32_t mmap_prot;
+    uint32_t mmap_flags;
+    uint32_t reserved[13];
+} crng_vgetrandom_params;
+
+/*
+ * Each opaque state may serve one thread at a time. A small shared set of
+ * states is claimed per request; callers that find none free, or arrive while
+ * the first caller is still probing, use the getrandom syscall instead.
+ */
+enum {
+    CRNG_VGETRANDOM_UNPROBED = 0,
+    CRNG_VGETRANDOM_PROBING = 1,
+    CRNG_VGETRANDOM_READY = 2,
+    CRNG_VGETRANDOM_UNAVAILABLE = 3
+};
+
+static atomic_int crng_vgetrandom_status;
+static crng_vgetrandom_function crng_vgetrandom;
+static unsigned char *crng_vgetrandom_states;
+static size_t crng_vgetrandom_state_size;
+static size_t crng_vgetrandom_slot_count;
+static atomic_uint crng_vgetrandom_busy[CRNG_VGETRANDOM_SLOTS];
+
+/*
+ * A slot held by another thread at fork() would stay busy in the child, whose
+ * copy of that thread never runs to release it. The states themselves are
+ * wiped on fork by their mapping flags, so freeing every slot is safe.
+ */
+static void crng_vgetrandom_atfork_child(void) {
+    size_t slot;
+
+    for (slot = 0; slot < CRNG_VGETRANDOM_SLOTS; ++slot) {
+        atomic_store_explicit(&crng_vgetrandom_busy[slot], 0U, memory_order_relaxed);
+    }
+}
+
+static int crng_vgetrandom_setup(void) {
+    crng_vgetrandom_params params;
+    crng_vgetrandom_function function;
+    uintptr_t address;
+    long page_size;
+    void *mapping;
+
+#    if defined(__powerpc__) || defined(__powerpc64__)
+    /* powerpc reports errors through CR0.SO, which a C call cannot see. */
+    return 0;
+#    endif
+    address = crng_vdso_getrandom_symbol();
+    if (address == 0) {
+        return 0;
+    }
+    function = (crng_vgetrandom_function)address;
+    memset(&params, 0, sizeof(params));
+    if (function(NULL, 0, 0, &params, ~(size_t)0) != 0 ||
+        params.size_of_opaque_state == 0) {
+        return 0;
+    }
+
+    page_size = sysconf(_SC_PAGESIZE);
+    if (page_size <= 0 || params.size_of_opaque_state > (unsigned long)page_size) {
+        return 0;
+    }
+    mapping = mmap(NULL, (size_t)page_size, (int)params.mmap_prot,
+                   (int)params.mmap_flags, -1, 0);
+    if (mapping == MAP_FAILED) {
+        return 0;
+    }
+    if (pthread_atfork(NULL, NULL, crng_vgetrandom_atfork_child) != 0) {
+        (void)munmap(mapping, (size_t)page_size);
+        return 0;
+    }
+
+    crng_vgetrandom = function;
+    crng_vgetrandom_states = (unsigned char *)mapping;
+    crng_vgetrandom_state_size = params.size_of_opaque_state;
+    crng_vgetrandom_slot_count = (size_t)page_size / params.size_of_opaque_state;
+    if (crng_vgetrandom_slot_count > CRNG_VGETRANDOM_SLOTS) {
+        crng_vgetrandom_slot_count = CRNG_VGETRANDOM_SLOTS;
+    }
+    return 1;
+}
+
+static int crng_vgetrandom_probe(void) {
+    int status = atomic_load_explicit(&crng_vgetrandom_status, memory_order_acquire);
+    int expected = CRNG_VGETRANDOM_UNPROBED;
+
+    if (status != CRNG_VGETRANDOM_UNPROBED) {
+        return status;
+    }
+    if (!atomic_compare_exchange_strong_explicit(
+            &crng_vgetrandom_status,
+            &expected,
+            CRNG_VGETRANDOM_PROBING,
+            memory_order_acq_rel,
+            memory_order_acquire)) {
+        return expected;
+    }
+    status = crng_vgetrandom_setup() != 0
+        ? CRNG_VGETRANDOM_READY
+        : CRNG_VGETRANDOM_UNAVAILABLE;
+    atomic_store_explicit(&crng_vgetrandom_status, status, memory_order_release);
+    return status;
+}
+
+/* Return how many leading bytes the vDSO produced; the caller finishes. */
+static size_t crng_vgetrandom_fill(unsigned char *buffer, size_t size) {
+    size_t slot;
+    size_t done = 0;
+
+    if (atomic_load_explicit(&crng_vgetrandom_status, memory_order_acquire)
+        != CRNG_VGETRANDOM_READY) {
+        return 0;
+    }
+    for (slot = 0; slot < crng_vgetrandom_slot_count; ++slot) {
+        if (atomic_exchange_explicit(&crng_vgetrandom_busy[slot], 1U,
+                                     memory_order_acquire) == 0U) {
+            break;
+        }
+    }
+    if (slot == crng_vgetrandom_slot_count) {
+        return 0;
+    }
+
+    while (done < size) {
+        const ssize_t count = crng_vgetrandom(
+            buffer + done,
+            size - done,
+            0,
+            crng_vgetrandom_states + slot * crng_vgetrandom_state_size,
+            crng_vgetrandom_state_size
+        );
+        if (count > 0) {
+            done += (size_t)count;
+        } else if (count != -EINTR) {
+            break;
+        }
     }
+    atomic_store_explicit(&crng_vgetrandom_busy[slot], 0U, memory_order_release);
+    return done;
+}
+#  endif
+#endif
+
+#if defined(CRNG_USE_GETRANDOM) && defined(CRNG_USE_BACKEND_CACHE)
+static atomic_int crng_backend_cache;
+
+static crng_secure_backend crng_getrandom_backend(void) {
+    int cached = atomic_load_explicit(&crng_backend_cache, memory_order_relaxed);
+    unsigned char probe = 0;
+    crng_secure_backend backend = CRNG_SECURE_BACKEND_GETRANDOM;
+
+    if (cached != 0) {
+        return (crng_secure_backend)cached;
+    }
+#  if defined(CRNG_USE_VDSO_GETRANDOM) && defined(CRNG_LIBC_VDSO_GETRANDOM)
+    if (crng_vdso_getrandom_symbol() != 0) {
+        backend = CRNG_SECURE_BACKEND_GETRANDOM_VDSO;
+    }
+#  elif defined(CRNG_USE_VDSO_GETRANDOM)
+    switch (crng_vgetrandom_probe()) {
+        case CRNG_VGETRANDOM_READY:
+            backend = CRNG_SECURE_BACKEND_GETRANDOM_VDSO;
+            break;
+        case CRNG_VGETRANDOM_PROBING:
+            /* Another thread is still probing; answer without caching. */
+            return CRNG_SECURE_BACKEND_GETRANDOM;
+        default:
+            break;
+    }
+#  endif
+    if (backend == CRNG_SECURE_BACKEND_GETRANDOM &&
+        getrandom(&probe, 0, GRND_NONBLOCK) < 0 && errno == ENOSYS) {
+        backend = CRNG_SECURE_BACKEND_URANDOM;
+    }
+    atomic_store_explicit(&crng_backend_cache, (int)backend, memory_order_relaxed);
+    return backend;
+}
+#endif
+
+crng_secure_backend crng_secure_backend_active(void) {
+#if defined(_WIN32)
+    return CRNG_SECURE_BACKEND_BCRYPT;
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || \
+      defined(__NetBSD__) || defined(__DragonFly__)
+    return CRNG_SECURE_BACKEND_ARC4RANDOM;
+#elif defined(CRNG_USE_GETRANDOM) && defined(CRNG_USE_BACKEND_CACHE)
+    return crng_getrandom_backend();
+#elif defined(CRNG_USE_GETRANDOM)
+    return CRNG_SECURE_BACKEND_GETRANDOM;
+#else
+    return CRNG_SECURE_BACKEND_URANDOM;
+#endif
+}
+
+const char *crng_secure_backend_name(crng_secure_backend backend) {
+    switch (backend) {
+        case CRNG_SECURE_BACKEND_BCRYPT:
+            return "BCryptGenRandom";
+        case CRNG_SECURE_BACKEND_ARC4RANDOM:
+            return "arc4random_buf";
+        case CRNG_SECURE_BACKEND_GETRANDOM:
+            return "getrandom";
+        case CRNG_SECURE_BACKEND_GETRANDOM_VDSO:
+            return "vDSO getrandom";
+        case CRNG_SECURE_BACKEND_URANDOM:
+            return "/dev/urandom";
+        default:
+            return "unknown";
+    }
+}
 
+/* Fill a nonempty buffer from the native provider. */
+static crng_status crng_secure_bytes_native(unsigned char *bytes, size_t size) {
 #if defined(_WIN32)
     while (size != 0) {
         const ULONG chunk = size > (size_t)ULONG_MAX ? ULONG_MAX : (ULONG)size;
@@ -87,6 +487,22 @@ crng_status crng_secure_bytes(void *buffer, size_t size) {
     arc4random_buf(bytes, size);
     return CRNG_OK;
 #elif defined(CRNG_USE_GETRANDOM)
+#  if defined(CRNG_USE_BACKEND_CACHE)
+    switch (crng_getrandom_backend()) {
+        case CRNG_SECURE_BACKEND_URANDOM:
+            return crng_read_urandom(bytes, size);
+#    if defined(CRNG_USE_VDSO_GETRANDOM) && !defined(CRNG_LIBC_VDSO_GETRANDOM)
+        case CRNG_SECURE_BACKEND_GETRANDOM_VDSO: {
+            const size_t done = crng_vgetrandom_fill(bytes, size);
+            bytes += done;
+            size -= done;
+            break;
+        }
+#    endif
+        default:
+            break;
+    }
+#  endif
     while (size != 0) {
         ssize_t count = getrandom(bytes, size, 0);
         if (count > 0) {
@@ -106,6 +522,30 @@ crng_status crng_secure_bytes(void *buffer, size_t size) {
 #endif
 }
 
+crng_status crng_secure_bytes(void *buffer, size_t size) {
+    crng_status status;
+
+    if (size == 0) {
+        return CRNG_OK;
+    }
+    if (buffer == NULL) {
+        return CRNG_ERR_NULL;
+    }
+
+    CRNG_PROBE2(secure_bytes_entry, size, (int)crng_secure_backend_active());
+    status = crng_secure_bytes_native((unsigned char *)buffer, size);
+    CRNG_PROBE2(secure_bytes_return, size, (int)status);
+#if defined(CRNG_ENABLE_STATS)
+    if (status == CRNG_OK) {
+        CRNG_SECURE_STAT_ADD(entropy_calls, 1U);
+        CRNG_SECURE_STAT_ADD(entropy_bytes, size);
+    } else {
+        CRNG_SECURE_STAT_ADD(entropy_failures, 1U);
+    }
+#endif
+    return status;
+}
+
 crng_status crng_secure_u64(uint64_t *out) {
     if (out == NULL) {
         return CRNG_ERR_NULL;
@@ -131,8 +571,13 @@ crng_status crng_secure_uniform_u64(uint64_t upper_bound, uint64_t *out) {
         if (status != CRNG_OK) {
             return status;
         }
+        if (value < threshold) {
+            CRNG_SECURE_STAT_ADD(uniform_rejections, 1U);
+            CRNG_PROBE1(secure_uniform_reject, upper_bound);
+        }
     } while (value < threshold);
 
+    CRNG_SECURE_STAT_ADD(uniform_results, 1U);
     *out = value % upper_bound;
     return CRNG_OK;
 }
@@ -163,133 +608,1768 @@ crng_status crng_secure_range_i32(
     return CRNG_OK;
 }
 
-static uint64_t crng_add_mod_u64(uint64_t left, uint64_t right, uint64_t modulus) {
-    return left >= modulus - right ? left - (modulus - right) : left + right;
-}
+crng_status crng_secure_uniform_u64_array(
+    uint64_t upper_bound,
+    uint64_t *out,
+    size_t count
+) {
+    uint64_t words[CRNG_SECURE_BATCH_WORDS];
+    uint64_t threshold;
+    size_t available = 0;
+    size_t index = 0;
 
-static uint64_t crng_mul_mod_u64(uint64_t left, uint64_t right, uint64_t modulus) {
-    uint64_t result = 0;
+    if (out == NULL && count != 0) {
+        return CRNG_ERR_NULL;
+    }
+    if (upper_bound == 0) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
 
-    left %= modulus;
-    while (right != 0) {
-        if ((right & UINT64_C(1)) != 0) {
-            result = crng_add_mod_u64(result, left, modulus);
+    threshold = (UINT64_C(0) - upper_bound) % upper_bound;
+    CRNG_PROBE2(secure_batch_entry, count, upper_bound);
+    while (index < count) {
+        uint64_t value;
+
+        if (available == 0) {
+            /* Ask for what remains; rejection rarely needs a short top-up. */
+            const size_t request = count - index < CRNG_SECURE_BATCH_WORDS
+                ? count - index
+                : CRNG_SECURE_BATCH_WORDS;
+            const crng_status status = crng_secure_bytes(words, request * sizeof(words[0]));
+            if (status != CRNG_OK) {
+                crng_secure_zero(words, sizeof(words));
+                crng_secure_zero(out, count * sizeof(*out));
+                CRNG_PROBE2(secure_batch_return, count, (int)status);
+                return status;
+            }
+            available = request;
         }
-        right >>= 1;
-        if (right != 0) {
-            left = crng_add_mod_u64(left, left, modulus);
+
+        value = words[--available];
+        if (value >= threshold) {
+            out[index++] = value % upper_bound;
+        } else {
+            CRNG_SECURE_STAT_ADD(uniform_rejections, 1U);
+            CRNG_PROBE1(secure_uniform_reject, upper_bound);
         }
     }
-    return result;
+
+    crng_secure_zero(words, sizeof(words));
+    CRNG_SECURE_STAT_ADD(uniform_results, count);
+    CRNG_PROBE2(secure_batch_return, count, (int)CRNG_OK);
+    return CRNG_OK;
 }
 
-static uint64_t crng_pow_mod_u64(uint64_t base, uint64_t exponent, uint64_t modulus) {
-    uint64_t result = UINT64_C(1);
+crng_status crng_secure_range_i32_array(
+    int32_t minimum,
+    int32_t maximum,
+    int32_t *out,
+    size_t count
+) {
+    uint32_t words[CRNG_SECURE_BATCH_WORDS * 2U];
+    uint64_t span;
+    uint32_t threshold;
+    size_t available = 0;
+    size_t index = 0;
 
-    base %= modulus;
-    while (exponent != 0) {
-        if ((exponent & UINT64_C(1)) != 0) {
-            result = crng_mul_mod_u64(result, base, modulus);
+    if (out == NULL && count != 0) {
+        return CRNG_ERR_NULL;
+    }
+    if (minimum > maximum) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+
+    /* Every span fits 32 source bits, so each OS word yields two draws. */
+    span = (uint64_t)((int64_t)maximum - (int64_t)minimum) + UINT64_C(1);
+    threshold = span > UINT32_MAX ? 0 : (UINT32_C(0) - (uint32_t)span) % (uint32_t)span;
+    CRNG_PROBE2(secure_batch_entry, count, span);
+    while (index < count) {
+        uint32_t value;
+
+        if (available == 0) {
+            const size_t wanted = count - index < sizeof(words) / sizeof(words[0])
+                ? count - index
+                : sizeof(words) / sizeof(words[0]);
+            const crng_status status = crng_secure_bytes(words, wanted * sizeof(words[0]));
+            if (status != CRNG_OK) {
+                crng_secure_zero(words, sizeof(words));
+                crng_secure_zero(out, count * sizeof(*out));
+                CRNG_PROBE2(secure_batch_return, count, (int)status);
+                return status;
+            }
+            available = wanted;
         }
-        exponent >>= 1;
-        if (exponent != 0) {
-            base = crng_mul_mod_u64(base, base, modulus);
+
+        value = words[--available];
+        if (value >= threshold) {
+            const uint64_t offset = span > UINT32_MAX
+                ? (uint64_t)value
+                : (uint64_t)(value % (uint32_t)span);
+            out[index++] = (int32_t)((int64_t)minimum + (int64_t)offset);
+        } else {
+            CRNG_SECURE_STAT_ADD(uniform_rejections, 1U);
+            CRNG_PROBE1(secure_uniform_reject, span);
         }
     }
-    return result;
+
+    crng_secure_zero(words, sizeof(words));
+    CRNG_SECURE_STAT_ADD(uniform_results, count);
+    CRNG_PROBE2(secure_batch_return, count, (int)CRNG_OK);
+    return CRNG_OK;
 }
 
-bool crng_crypto_is_prime_u64(uint64_t value) {
-    static const uint64_t small_primes[] = {
-        UINT64_C(2), UINT64_C(3), UINT64_C(5), UINT64_C(7),
-        UINT64_C(11), UINT64_C(13), UINT64_C(17), UINT64_C(19),
-        UINT64_C(23), UINT64_C(29), UINT64_C(31), UINT64_C(37)
-    };
-    static const uint64_t witnesses[] = {
-        UINT64_C(2), UINT64_C(325), UINT64_C(9375), UINT64_C(28178),
-        UINT64_C(450775), UINT64_C(9780504), UINT64_C(1795265022)
-    };
-    uint64_t odd_part;
-    unsigned int powers_of_two = 0;
-    size_t index;
+/* Words per native request when minting tokens: 4 KiB of entropy. */
+#define CRNG_SECURE_TOKEN_BATCH_WORDS (CRNG_SECURE_BATCH_WORDS * 8U)
 
-    if (value < UINT64_C(2)) {
-        return false;
-    }
-    for (index = 0; index < sizeof(small_primes) / sizeof(small_primes[0]); ++index) {
-        if (value == small_primes[index]) {
-            return true;
-        }
-        if (value % small_primes[index] == 0) {
-            return false;
+/*
+ * How one 64-bit word is cut into symbols. A power-of-two alphabet takes
+ * `shift`-bit fields with no rejection. Any other alphabet of n symbols
+ * takes `digits` base-n digits of the word reduced modulo n^digits, after
+ * rejecting the 2^64 mod n^digits smallest words so every digit string is
+ * equally likely.
+ */
+typedef struct crng_token_plan {
+    unsigned int digits;
+    unsigned int shift;
+    uint64_t bound;
+    uint64_t threshold;
+} crng_token_plan;
+
+static void crng_token_plan_for(crng_token_plan *plan, uint64_t symbols) {
+    uint64_t power = symbols;
+    unsigned int digits = 1;
+
+    plan->shift = 0;
+    if ((symbols & (symbols - 1U)) == 0) {
+        while ((UINT64_C(1) << plan->shift) < symbols) {
+            ++plan->shift;
         }
+        plan->digits = 64U / plan->shift;
+        plan->bound = 0;
+        plan->threshold = 0;
+        return;
     }
 
-    odd_part = value - UINT64_C(1);
-    while ((odd_part & UINT64_C(1)) == 0) {
-        odd_part >>= 1;
-        ++powers_of_two;
+    while (power <= UINT64_MAX / symbols) {
+        power *= symbols;
+        ++digits;
     }
+    plan->digits = digits;
+    plan->bound = power;
+    plan->threshold = (UINT64_C(0) - power) % power;
 
-    for (index = 0; index < sizeof(witnesses) / sizeof(witnesses[0]); ++index) {
-        const uint64_t witness = witnesses[index] % value;
-        uint64_t result;
-        unsigned int round;
-
-        if (witness == 0) {
-            continue;
-        }
-        result = crng_pow_mod_u64(witness, odd_part, value);
-        if (result == UINT64_C(1) || result == value - UINT64_C(1)) {
-            continue;
-        }
+    /*
+     * The largest power can reject nearly half of all words (n = 3 rejects
+     * about 34%); one digit fewer may then yield more symbols per word.
+     */
+    if (digits > 1U) {
+        const uint64_t smaller = power / symbols;
+        const uint64_t smaller_threshold = (UINT64_C(0) - smaller) % smaller;
+        const double word = 18446744073709551616.0;
+        const double yield = (double)digits * (1.0 - (double)plan->threshold / word);
+        const double smaller_yield =
+            (double)(digits - 1U) * (1.0 - (double)smaller_threshold / word);
 
-        for (round = 1; round < powers_of_two; ++round) {
-            result = crng_mul_mod_u64(result, result, value);
-            if (result == value - UINT64_C(1)) {
-                break;
-            }
-        }
-        if (round == powers_of_two) {
-            return false;
+        if (smaller_yield > yield) {
+            plan->digits = digits - 1U;
+            plan->bound = smaller;
+            plan->threshold = smaller_threshold;
         }
     }
-    return true;
 }
 
-crng_status crng_crypto_random_prime_u64(
-    uint64_t minimum,
-    uint64_t maximum,
-    uint64_t max_attempts,
-    uint64_t *out
+crng_status crng_secure_token_array(
+    const char *alphabet,
+    size_t alphabet_length,
+    char *out,
+    size_t length,
+    size_t count
 ) {
-    uint64_t attempt;
+    uint64_t words[CRNG_SECURE_TOKEN_BATCH_WORDS];
+    crng_token_plan plan;
+    uint64_t symbols;
+    size_t total;
+    size_t available = 0;
+    size_t index = 0;
 
-    if (out == NULL) {
+    if (count != 0 && length > SIZE_MAX / count) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+    total = length * count;
+    if (alphabet == NULL || (out == NULL && total != 0)) {
         return CRNG_ERR_NULL;
     }
-    if (minimum > maximum || max_attempts == 0 || maximum < UINT64_C(2)) {
+    if (alphabet_length < 2U || alphabet_length > 256U) {
+        crng_secure_zero(out, total);
         return CRNG_ERR_INVALID_RANGE;
     }
-    if (minimum < UINT64_C(2)) {
-        minimum = UINT64_C(2);
-    }
 
-    for (attempt = 0; attempt < max_attempts; ++attempt) {
-        uint64_t candidate;
-        crng_status status;
+    symbols = (uint64_t)alphabet_length;
+    crng_token_plan_for(&plan, symbols);
+    CRNG_PROBE2(secure_batch_entry, total, symbols);
+    while (index < total) {
+        uint64_t value;
+        unsigned int digit;
 
-        const uint64_t span = maximum - minimum + UINT64_C(1);
-        uint64_t offset;
-        status = crng_secure_uniform_u64(span, &offset);
-        if (status != CRNG_OK) {
-            return status;
+        if (available == 0) {
+            /* Enough words for the rest at full yield; rejection tops up. */
+            const size_t needed = (total - index - 1U) / plan.digits + 1U;
+            const size_t request = needed < CRNG_SECURE_TOKEN_BATCH_WORDS
+                ? needed
+                : CRNG_SECURE_TOKEN_BATCH_WORDS;
+            const crng_status status = crng_secure_bytes(words, request * sizeof(words[0]));
+            if (status != CRNG_OK) {
+                crng_secure_zero(words, sizeof(words));
+                crng_secure_zero(out, total);
+                CRNG_PROBE2(secure_batch_return, total, (int)status);
+                return status;
+            }
+            available = request;
+        }
+
+        value = words[--available];
+        if (value < plan.threshold) {
+            CRNG_SECURE_STAT_ADD(uniform_rejections, 1U);
+            CRNG_PROBE1(secure_uniform_reject, plan.bound);
+            continue;
+        }
+        if (plan.shift != 0) {
+            const uint64_t mask = symbols - 1U;
+
+            for (digit = 0; digit < plan.digits && index < total; ++digit) {
+                out[index++] = alphabet[value & mask];
+                value >>= plan.shift;
+            }
+        } else {
+            value %= plan.bound;
+            for (digit = 0; digit < plan.digits && index < total; ++digit) {
+                out[index++] = alphabet[value % symbols];
+                value /= symbols;
+            }
+        }
+    }
+
+    crng_secure_zero(words, sizeof(words));
+    CRNG_PROBE2(secure_batch_return, total, (int)CRNG_OK);
+    return CRNG_OK;
+}
+
+crng_status crng_secure_token(
+    const char *alphabet,
+    size_t alphabet_length,
+    char *out,
+    size_t length
+) {
+    return crng_secure_token_array(alphabet, alphabet_length, out, length, 1U);
+}
+
+/*
+ * Define CRNG_PORTABLE_MULMOD to force the shift-and-add arithmetic on
+ * targets that provide a 64x64->128-bit multiply.
+ */
+#if !defined(CRNG_PORTABLE_MULMOD)
+#  if defined(__SIZEOF_INT128__)
+#    define CRNG_HAVE_INT128 1
+__extension__ typedef unsigned __int128 crng_uint128;
+#  elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#    include <intrin.h>
+#    define CRNG_HAVE_MUL_HIGH 1
+#  endif
+#endif
+#if defined(CRNG_HAVE_INT128) || defined(CRNG_HAVE_MUL_HIGH)
+#  define CRNG_USE_MONTGOMERY 1
+#endif
+
+/* Odd primes tried by the scalar and batch screens, and batch lane width. */
+#define CRNG_PRIME_SCALAR_SCREEN 11U
+#define CRNG_PRIME_BATCH_SCREEN 32U
+#define CRNG_PRIME_LANES 4U
+/* Odd primes and odd candidates per window in the sieved prime search. */
+#define CRNG_PRIME_SIEVE_PRIMES 64U
+#define CRNG_PRIME_SIEVE_WINDOW 128U
+
+static uint64_t crng_add_mod_u64(uint64_t left, uint64_t right, uint64_t modulus) {
+    return left >= modulus - right ? left - (modulus - right) : left + right;
+}
+
+/*
+ * Trial division by 2 and the first `count` odd primes. Return 0 for a
+ * composite or a value below two, 1 for a proven prime, and -1 otherwise.
+ */
+static int crng_trial_divide_u64(uint64_t value, size_t count) {
+    const uint64_t largest = crng_small_primes[count - 1U].prime;
+    size_t index;
+
+    if ((value & UINT64_C(1)) == 0 || value < UINT64_C(2)) {
+        return value == UINT64_C(2);
+    }
+    for (index = 0; index < count; ++index) {
+        if (value * crng_small_primes[index].inverse <= crng_small_primes[index].limit) {
+            return value == crng_small_primes[index].prime;
+        }
+    }
+    return value < largest * largest ? 1 : -1;
+}
+
+/* Split value - 1 into odd_part * 2^powers_of_two. */
+static uint64_t crng_odd_part_u64(uint64_t value, unsigned int *powers_of_two) {
+    uint64_t odd_part = value - UINT64_C(1);
+
+    *powers_of_two = 0;
+    while ((odd_part & UINT64_C(1)) == 0) {
+        odd_part >>= 1;
+        ++*powers_of_two;
+    }
+    return odd_part;
+}
+
+/* Strong probable-prime test to one base; requires base * base < 2^64. */
+static bool crng_strong_probable_prime_u32(
+    uint64_t value,
+    uint64_t base,
+    uint64_t odd_part,
+    unsigned int powers_of_two
+) {
+    uint64_t result = UINT64_C(1);
+    uint64_t exponent = odd_part;
+    unsigned int round;
+
+    base %= value;
+    if (base == 0) {
+        return true;
+    }
+    while (exponent != 0) {
+        if ((exponent & UINT64_C(1)) != 0) {
+            result = result * base % value;
+        }
+        exponent >>= 1;
+        base = base * base % value;
+    }
+    if (result == UINT64_C(1) || result == value - UINT64_C(1)) {
+        return true;
+    }
+    for (round = 1; round < powers_of_two; ++round) {
+        result = result * result % value;
+        if (result == value - UINT64_C(1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Return the low word of left * right and store the high word. */
+static uint64_t crng_mul_wide_u64(uint64_t left, uint64_t right, uint64_t *high) {
+#if defined(CRNG_HAVE_INT128)
+    const crng_uint128 product = (crng_uint128)left * right;
+    *high = (uint64_t)(product >> 64);
+    return (uint64_t)product;
+#elif defined(CRNG_HAVE_MUL_HIGH)
+    *high = __umulh(left, right);
+    return left * right;
+#else
+    /* Schoolbook product of 32-bit halves. */
+    const uint64_t left_low = left & UINT32_MAX;
+    const uint64_t left_high = left >> 32;
+    const uint64_t right_low = right & UINT32_MAX;
+    const uint64_t right_high = right >> 32;
+    const uint64_t low_low = left_low * right_low;
+    const uint64_t high_low = left_high * right_low;
+    const uint64_t low_high = left_low * right_high;
+    const uint64_t middle = (low_low >> 32) + (high_low & UINT32_MAX) + low_high;
+
+    *high = left_high * right_high + (high_low >> 32) + (middle >> 32);
+    return (middle << 32) | (low_low & UINT32_MAX);
+#endif
+}
+
+static int crng_jacobi_u64(uint64_t top, uint64_t modulus) {
+    int result = 1;
+
+    top %= modulus;
+    while (top != 0) {
+        uint64_t swap;
+
+        while ((top & UINT64_C(1)) == 0) {
+            const uint64_t residue = modulus & UINT64_C(7);
+            top >>= 1;
+            if (residue == UINT64_C(3) || residue == UINT64_C(5)) {
+                result = -result;
+            }
+        }
+        swap = top;
+        top = modulus;
+        modulus = swap;
+        if ((top & UINT64_C(3)) == UINT64_C(3) &&
+            (modulus & UINT64_C(3)) == UINT64_C(3)) {
+            result = -result;
+        }
+        top %= modulus;
+    }
+    return modulus == UINT64_C(1) ? result : 0;
+}
+
+#if defined(CRNG_USE_MONTGOMERY)
+/* Montgomery arithmetic modulo an odd `modulus` with R = 2^64. */
+typedef struct crng_montgomery_u64 {
+    uint64_t modulus;
+    uint64_t inverse;
+    uint64_t one;
+    uint64_t r_squared;
+} crng_montgomery_u64;
+
+static void crng_montgomery_init(crng_montgomery_u64 *context, uint64_t modulus) {
+    uint64_t inverse = modulus;
+    uint64_t r_squared;
+    unsigned int round;
+
+    /* Newton's iteration doubles the correct low bits: 3, 6, ..., 96. */
+    for (round = 0; round < 5; ++round) {
+        inverse *= UINT64_C(2) - modulus * inverse;
+    }
+    r_squared = (UINT64_C(0) - modulus) % modulus;
+    context->modulus = modulus;
+    context->inverse = inverse;
+    context->one = r_squared;
+    for (round = 0; round < 64; ++round) {
+        r_squared = crng_add_mod_u64(r_squared, r_squared, modulus);
+    }
+    context->r_squared = r_squared;
+}
+
+/* Return (high * 2^64 + low) / R mod n for inputs below n * R. */
+static uint64_t crng_montgomery_reduce(
+    const crng_montgomery_u64 *context,
+    uint64_t high,
+    uint64_t low
+) {
+    uint64_t correction;
+
+    (void)crng_mul_wide_u64(low * context->inverse, context->modulus, &correction);
+    return high >= correction
+        ? high - correction
+        : high - correction + context->modulus;
+}
+
+static uint64_t crng_montgomery_mul(
+    const crng_montgomery_u64 *context,
+    uint64_t left,
+    uint64_t right
+) {
+    uint64_t high;
+    const uint64_t low = crng_mul_wide_u64(left, right, &high);
+    return crng_montgomery_reduce(context, high, low);
+}
+
+static uint64_t crng_montgomery_from(const crng_montgomery_u64 *context, uint64_t value) {
+    return crng_montgomery_mul(context, value % context->modulus, context->r_squared);
+}
+
+static uint64_t crng_montgomery_sub(
+    const crng_montgomery_u64 *context,
+    uint64_t left,
+    uint64_t right
+) {
+    return left >= right ? left - right : left - right + context->modulus;
+}
+
+/* Halve modulo an odd modulus; Montgomery form commutes with halving. */
+static uint64_t crng_montgomery_half(const crng_montgomery_u64 *context, uint64_t value) {
+    return (value & UINT64_C(1)) != 0
+        ? (value >> 1) + (context->modulus >> 1) + UINT64_C(1)
+        : value >> 1;
+}
+
+/*
+ * Base-2 strong probable-prime test on up to CRNG_PRIME_LANES moduli at once.
+ * The lanes share one left-to-right exponent loop so their independent
+ * multiplies overlap; multiplying by the base is a modular doubling. Lanes
+ * with shorter exponents square Montgomery one, which leaves it unchanged.
+ */
+static void crng_montgomery_base2_lanes(
+    const crng_montgomery_u64 *contexts,
+    size_t lanes,
+    bool *passed
+) {
+    uint64_t odd_parts[CRNG_PRIME_LANES];
+    uint64_t results[CRNG_PRIME_LANES];
+    unsigned int powers[CRNG_PRIME_LANES];
+    uint64_t highest = 0;
+    size_t lane;
+    int bit;
+
+    for (lane = 0; lane < lanes; ++lane) {
+        odd_parts[lane] = crng_odd_part_u64(contexts[lane].modulus, &powers[lane]);
+        results[lane] = contexts[lane].one;
+        highest |= odd_parts[lane];
+    }
+
+    bit = 63;
+    while (((highest >> bit) & UINT64_C(1)) == 0) {
+        --bit;
+    }
+    for (; bit >= 0; --bit) {
+        for (lane = 0; lane < lanes; ++lane) {
+            const uint64_t square = crng_montgomery_mul(
+                &contexts[lane],
+                results[lane],
+                results[lane]
+            );
+            const uint64_t select = UINT64_C(0) - ((odd_parts[lane] >> bit) & UINT64_C(1));
+            results[lane] = crng_add_mod_u64(square, square & select, contexts[lane].modulus);
+        }
+    }
+
+    for (lane = 0; lane < lanes; ++lane) {
+        const crng_montgomery_u64 *context = &contexts[lane];
+        const uint64_t minus_one = context->modulus - context->one;
+        uint64_t result = results[lane];
+        unsigned int round;
+
+        passed[lane] = result == context->one || result == minus_one;
+        for (round = 1; !passed[lane] && round < powers[lane]; ++round) {
+            result = crng_montgomery_mul(context, result, result);
+            passed[lane] = result == minus_one;
+        }
+    }
+}
+
+static bool crng_is_square_u64(uint64_t value) {
+    /* Bit r is set when r is a square modulo 64; 52 of 64 residues are not. */
+    const uint64_t squares_mod_64 = UINT64_C(0x0202021202030213);
+    uint64_t root = 0;
+    uint64_t bit = UINT64_C(1) << 62;
+
+    if (((squares_mod_64 >> (value & UINT64_C(63))) & UINT64_C(1)) == 0) {
+        return false;
+    }
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return value == 0;
+}
+
+/* Strong Lucas test with Selfridge's parameters: P = 1, Q = (1 - D) / 4. */
+static bool crng_montgomery_strong_lucas(const crng_montgomery_u64 *context) {
+    const uint64_t modulus = context->modulus;
+    int64_t discriminant = 5;
+    uint64_t d_residue;
+    uint64_t q_residue;
+    uint64_t odd_part;
+    uint64_t u;
+    uint64_t v;
+    uint64_t q_power;
+    uint64_t q_base;
+    uint64_t d_form;
+    unsigned int powers_of_two = 0;
+    int bit;
+
+    if (crng_is_square_u64(modulus)) {
+        return false;
+    }
+    /*
+     * The modulus exceeds 2^32, far above any |D| reached here. Reciprocity
+     * gives (D/n) = (-1/n)^[D < 0] (n mod |D| / |D|), flipped when |D| and n
+     * are both 3 mod 4, so each candidate D costs one short division.
+     */
+    for (;;) {
+        const uint64_t magnitude = (uint64_t)(discriminant < 0 ? -discriminant : discriminant);
+        int symbol = crng_jacobi_u64(modulus % magnitude, magnitude);
+
+        if ((magnitude & UINT64_C(3)) == UINT64_C(3) && (modulus & UINT64_C(3)) == UINT64_C(3)) {
+            symbol = -symbol;
+        }
+        if (discriminant < 0 && (modulus & UINT64_C(3)) == UINT64_C(3)) {
+            symbol = -symbol;
+        }
+        if (symbol == -1) {
+            d_residue = discriminant < 0 ? modulus - magnitude : magnitude;
+            break;
+        }
+        if (symbol == 0) {
+            return false;
+        }
+        discriminant = discriminant < 0 ? 2 - discriminant : -2 - discriminant;
+    }
+
+    {
+        const int64_t q_value = (1 - discriminant) / 4;
+        const uint64_t q_magnitude = (uint64_t)(q_value < 0 ? -q_value : q_value);
+        q_residue = q_value < 0 ? modulus - q_magnitude : q_magnitude;
+    }
+
+    /* modulus is odd and not 2^64 - 1, which has the factor three. */
+    odd_part = modulus + UINT64_C(1);
+    while ((odd_part & UINT64_C(1)) == 0) {
+        odd_part >>= 1;
+        ++powers_of_two;
+    }
+
+    d_form = crng_montgomery_from(context, d_residue);
+    q_base = crng_montgomery_from(context, q_residue);
+    u = context->one;
+    v = context->one;
+    q_power = q_base;
+    bit = 63;
+    while (((odd_part >> bit) & UINT64_C(1)) == 0) {
+        --bit;
+    }
+    for (--bit; bit >= 0; --bit) {
+        u = crng_montgomery_mul(context, u, v);
+        v = crng_montgomery_sub(
+            context,
+            crng_montgomery_mul(context, v, v),
+            crng_add_mod_u64(q_power, q_power, modulus)
+        );
+        q_power = crng_montgomery_mul(context, q_power, q_power);
+        if (((odd_part >> bit) & UINT64_C(1)) != 0) {
+            const uint64_t next_u = crng_montgomery_half(
+                context,
+                crng_add_mod_u64(u, v, modulus)
+            );
+            v = crng_montgomery_half(
+                context,
+                crng_add_mod_u64(crng_montgomery_mul(context, d_form, u), v, modulus)
+            );
+            u = next_u;
+            q_power = crng_montgomery_mul(context, q_power, q_base);
+        }
+    }
+
+    if (u == 0 || v == 0) {
+        return true;
+    }
+    while (--powers_of_two != 0) {
+        v = crng_montgomery_sub(
+            context,
+            crng_montgomery_mul(context, v, v),
+            crng_add_mod_u64(q_power, q_power, modulus)
+        );
+        if (v == 0) {
+            return true;
+        }
+        q_power = crng_montgomery_mul(context, q_power, q_power);
+    }
+    return false;
+}
+
+/* Baillie-PSW on an odd value above 2^32 that survived trial division. */
+static bool crng_montgomery_bpsw(uint64_t value) {
+    crng_montgomery_u64 context;
+    bool passed;
+
+    crng_montgomery_init(&context, value);
+    crng_montgomery_base2_lanes(&context, 1, &passed);
+    return passed && crng_montgomery_strong_lucas(&context);
+}
+#else
+static uint64_t crng_mul_mod_u64(uint64_t left, uint64_t right, uint64_t modulus) {
+    uint64_t result = 0;
+
+    left %= modulus;
+    while (right != 0) {
+        if ((right & UINT64_C(1)) != 0) {
+            result = crng_add_mod_u64(result, left, modulus);
+        }
+        right >>= 1;
+        if (right != 0) {
+            left = crng_add_mod_u64(left, left, modulus);
+        }
+    }
+    return result;
+}
+
+static uint64_t crng_pow_mod_u64(uint64_t base, uint64_t exponent, uint64_t modulus) {
+    uint64_t result = UINT64_C(1);
+
+    base %= modulus;
+    while (exponent != 0) {
+        if ((exponent & UINT64_C(1)) != 0) {
+            result = crng_mul_mod_u64(result, base, modulus);
+        }
+        exponent >>= 1;
+        if (exponent != 0) {
+            base = crng_mul_mod_u64(base, base, modulus);
+        }
+    }
+    return result;
+}
+
+static bool crng_witnesses_probable_prime_u64(uint64_t value) {
+    static const uint64_t witnesses[] = {
+        UINT64_C(2), UINT64_C(325), UINT64_C(9375), UINT64_C(28178),
+        UINT64_C(450775), UINT64_C(9780504), UINT64_C(1795265022)
+    };
+    unsigned int powers_of_two;
+    const uint64_t odd_part = crng_odd_part_u64(value, &powers_of_two);
+    size_t index;
+
+    for (index = 0; index < sizeof(witnesses) / sizeof(witnesses[0]); ++index) {
+        const uint64_t witness = witnesses[index] % value;
+        uint64_t result;
+        unsigned int round;
+
+        if (witness == 0) {
+            continue;
+        }
+        result = crng_pow_mod_u64(witness, odd_part, value);
+        if (result == UINT64_C(1) || result == value - UINT64_C(1)) {
+            continue;
+        }
+
+        for (round = 1; round < powers_of_two; ++round) {
+            result = crng_mul_mod_u64(result, result, value);
+            if (result == value - UINT64_C(1)) {
+                break;
+            }
+        }
+        if (round == powers_of_two) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+/* Classify an odd value below 2^32 that survived trial division. */
+static bool crng_is_prime_u32(uint64_t value) {
+    unsigned int powers_of_two;
+    const uint64_t odd_part = crng_odd_part_u64(value, &powers_of_two);
+
+    /* Bases 2, 7, and 61 are deterministic below 4,759,123,141. */
+    return crng_strong_probable_prime_u32(value, UINT64_C(2), odd_part, powers_of_two) &&
+        crng_strong_probable_prime_u32(value, UINT64_C(7), odd_part, powers_of_two) &&
+        crng_strong_probable_prime_u32(value, UINT64_C(61), odd_part, powers_of_two);
+}
+
+bool crng_crypto_is_prime_u64(uint64_t value) {
+    const int screened = crng_trial_divide_u64(value, CRNG_PRIME_SCALAR_SCREEN);
+
+    if (screened >= 0) {
+        return screened != 0;
+    }
+    if (value <= UINT32_MAX) {
+        return crng_is_prime_u32(value);
+    }
+#if defined(CRNG_USE_MONTGOMERY)
+    /* Baillie-PSW has no counterexample below 2^64 (Feitsma-Galway). */
+    return crng_montgomery_bpsw(value);
+#else
+    return crng_witnesses_probable_prime_u64(value);
+#endif
+}
+
+#if defined(CRNG_USE_MONTGOMERY)
+/* Most composites fail base 2, so only that stage is interleaved. */
+static void crng_prime_lanes_finish(
+    const crng_montgomery_u64 *contexts,
+    const size_t *pending,
+    size_t lanes,
+    bool *out
+) {
+    bool passed[CRNG_PRIME_LANES];
+    size_t lane;
+
+    crng_montgomery_base2_lanes(contexts, lanes, passed);
+    for (lane = 0; lane < lanes; ++lane) {
+        out[pending[lane]] = passed[lane] && crng_montgomery_strong_lucas(&contexts[lane]);
+    }
+}
+#endif
+
+crng_status crng_crypto_is_prime_u64_array(
+    const uint64_t *values,
+    bool *out,
+    size_t count
+) {
+#if defined(CRNG_USE_MONTGOMERY)
+    crng_montgomery_u64 contexts[CRNG_PRIME_LANES];
+    size_t pending[CRNG_PRIME_LANES];
+    size_t lanes = 0;
+#endif
+    size_t index;
+
+    if (count == 0) {
+        return CRNG_OK;
+    }
+    if (values == NULL || out == NULL) {
+        return CRNG_ERR_NULL;
+    }
+
+    for (index = 0; index < count; ++index) {
+        const uint64_t value = values[index];
+        const int screened = crng_trial_divide_u64(value, CRNG_PRIME_BATCH_SCREEN);
+
+        if (screened >= 0) {
+            out[index] = screened != 0;
+        } else if (value <= UINT32_MAX) {
+            out[index] = crng_is_prime_u32(value);
+        } else {
+#if defined(CRNG_USE_MONTGOMERY)
+            crng_montgomery_init(&contexts[lanes], value);
+            pending[lanes++] = index;
+            if (lanes == CRNG_PRIME_LANES) {
+                crng_prime_lanes_finish(contexts, pending, lanes, out);
+                lanes = 0;
+            }
+#else
+            out[index] = crng_witnesses_probable_prime_u64(value);
+#endif
+        }
+    }
+
+#if defined(CRNG_USE_MONTGOMERY)
+    if (lanes != 0) {
+        crng_prime_lanes_finish(contexts, pending, lanes, out);
+    }
+#endif
+    return CRNG_OK;
+}
+
+crng_status crng_crypto_random_prime_u64(
+    uint64_t minimum,
+    uint64_t maximum,
+    uint64_t max_attempts,
+    uint64_t *out
+) {
+    uint64_t attempt;
+
+    if (out == NULL) {
+        return CRNG_ERR_NULL;
+    }
+    if (minimum > maximum || max_attempts == 0 || maximum < UINT64_C(2)) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+    if (minimum < UINT64_C(2)) {
+        minimum = UINT64_C(2);
+    }
+
+    CRNG_SECURE_STAT_ADD(prime_searches, 1U);
+    CRNG_PROBE3(prime_search_entry, minimum, maximum, max_attempts);
+    for (attempt = 0; attempt < max_attempts; ++attempt) {
+        uint64_t candidate;
+        crng_status status;
+
+        const uint64_t span = maximum - minimum + UINT64_C(1);
+        uint64_t offset;
+        status = crng_secure_uniform_u64(span, &offset);
+        if (status != CRNG_OK) {
+            return status;
         }
         candidate = minimum + offset;
+        CRNG_SECURE_STAT_ADD(prime_attempts, 1U);
+        CRNG_PROBE1(prime_attempt, candidate);
         if (crng_crypto_is_prime_u64(candidate)) {
+            CRNG_PROBE2(prime_search_return, (int)CRNG_OK, attempt + 1U);
+            *out = candidate;
+            return CRNG_OK;
+        }
+    }
+    CRNG_SECURE_STAT_ADD(prime_not_found, 1U);
+    CRNG_PROBE2(prime_search_return, (int)CRNG_ERR_NOT_FOUND, max_attempts);
+    return CRNG_ERR_NOT_FOUND;
+}
+
+/*
+ * Return the position of the first prime among `count` increasing values,
+ * at most CRNG_PRIME_LANES, that passed trial division; return `count` when
+ * none is prime. Base-2 tests for values above 2^32 run interleaved.
+ */
+static size_t crng_first_prime_u64(const uint64_t *values, size_t count) {
+    size_t lane;
+
+#if defined(CRNG_USE_MONTGOMERY)
+    if (values[0] > UINT32_MAX) {
+        crng_montgomery_u64 contexts[CRNG_PRIME_LANES];
+        bool passed[CRNG_PRIME_LANES];
+
+        for (lane = 0; lane < count; ++lane) {
+            crng_montgomery_init(&contexts[lane], values[lane]);
+        }
+        crng_montgomery_base2_lanes(contexts, count, passed);
+        for (lane = 0; lane < count; ++lane) {
+            if (passed[lane] && crng_montgomery_strong_lucas(&contexts[lane])) {
+                return lane;
+            }
+        }
+        return count;
+    }
+#endif
+    for (lane = 0; lane < count; ++lane) {
+        if (crng_crypto_is_prime_u64(values[lane])) {
+            return lane;
+        }
+    }
+    return count;
+}
+
+/*
+ * Candidates of a sieved prime search in increasing order: up to two small
+ * values tested directly, then the odd progression first + step * k for
+ * k < count. With `safe` set, a candidate p must also have (p - 1) / 2 prime.
+ */
+typedef struct crng_prime_walk {
+    uint64_t small[2];
+    size_t small_count;
+    uint64_t first;
+    uint64_t step;
+    uint64_t count;
+    bool safe;
+} crng_prime_walk;
+
+/* Inverse of value modulo an odd prime that does not divide it. */
+static uint32_t crng_inverse_mod_u32(uint32_t value, uint32_t prime) {
+    int64_t coefficient = 0;
+    int64_t next_coefficient = 1;
+    int64_t remainder = (int64_t)prime;
+    int64_t next_remainder = (int64_t)value;
+
+    while (next_remainder != 0) {
+        const int64_t quotient = remainder / next_remainder;
+        int64_t swap = coefficient - quotient * next_coefficient;
+
+        coefficient = next_coefficient;
+        next_coefficient = swap;
+        swap = remainder - quotient * next_remainder;
+        remainder = next_remainder;
+        next_remainder = swap;
+    }
+    return (uint32_t)(coefficient < 0 ? coefficient + (int64_t)prime : coefficient);
+}
+
+static uint64_t crng_gcd_u64(uint64_t left, uint64_t right) {
+    while (right != 0) {
+        const uint64_t remainder = left % right;
+
+        left = right;
+        right = remainder;
+    }
+    return left;
+}
+
+/* Set the progression to the terms of residue (mod step) in [low, high]. */
+static void crng_prime_walk_set_terms(
+    crng_prime_walk *walk,
+    uint64_t low,
+    uint64_t high,
+    uint64_t residue,
+    uint64_t step
+) {
+    const uint64_t low_residue = low % step;
+    const uint64_t shift = residue >= low_residue
+        ? residue - low_residue
+        : step - (low_residue - residue);
+
+    walk->step = step;
+    walk->count = 0;
+    if (low <= high && shift <= high - low) {
+        walk->first = low + shift;
+        walk->count = (high - walk->first) / step + 1U;
+    }
+}
+
+static bool crng_prime_walk_accepts(const crng_prime_walk *walk, uint64_t value) {
+    return crng_crypto_is_prime_u64(value) &&
+           (!walk->safe || crng_crypto_is_prime_u64((value - 1U) / 2U));
+}
+
+/*
+ * Search progression terms [begin, end) in increasing order. Terms are sieved
+ * a window at a time against the first CRNG_PRIME_SIEVE_PRIMES odd primes,
+ * and, for safe primes, against p == 1 (mod r), which marks small factors of
+ * (p - 1) / 2. Each term visited, sieved or tested, uses one unit of
+ * *remaining.
+ */
+static bool crng_prime_walk_terms(
+    const crng_prime_walk *walk,
+    uint64_t begin,
+    uint64_t end,
+    uint64_t *remaining,
+    uint64_t *out
+) {
+    /* Index of the next marked term per prime and target, relative to base. */
+    uint32_t next[CRNG_PRIME_SIEVE_PRIMES][2];
+    uint32_t stride[CRNG_PRIME_SIEVE_PRIMES];
+    unsigned char composite[CRNG_PRIME_SIEVE_WINDOW];
+    uint64_t values[CRNG_PRIME_LANES];
+    size_t positions[CRNG_PRIME_LANES];
+    /* Terms up to here may equal a sieving prime or twice one plus one. */
+    const uint64_t exact_limit =
+        2U * (uint64_t)crng_small_primes[CRNG_PRIME_SIEVE_PRIMES - 1U].prime + 1U;
+    const size_t targets = walk->safe ? 2U : 1U;
+    uint64_t base = walk->first + walk->step * begin;
+    uint64_t count = end - begin;
+    size_t survivors;
+    size_t index;
+    size_t target;
+
+    for (index = 0; index < CRNG_PRIME_SIEVE_PRIMES; ++index) {
+        const uint32_t prime = crng_small_primes[index].prime;
+        const uint32_t step_residue = (uint32_t)(walk->step % prime);
+        const uint32_t base_residue = (uint32_t)(base % prime);
+
+        if (step_residue == 0) {
+            /* Every term shares one residue: all or none are marked. */
+            stride[index] = 1U;
+            for (target = 0; target < targets; ++target) {
+                next[index][target] = base_residue == target ? 0U : UINT32_MAX;
+            }
+        } else {
+            const uint32_t inverse = crng_inverse_mod_u32(step_residue, prime);
+
+            stride[index] = prime;
+            for (target = 0; target < targets; ++target) {
+                /* Solve base + step * k == target (mod prime) for k. */
+                uint32_t gap = (uint32_t)target + prime - base_residue;
+
+                gap = gap >= prime ? gap - prime : gap;
+                next[index][target] = (uint32_t)((uint64_t)gap * inverse % prime);
+            }
+        }
+    }
+
+    while (count != 0 && *remaining != 0) {
+        uint64_t window = count < *remaining ? count : *remaining;
+        size_t size;
+
+        if (window > CRNG_PRIME_SIEVE_WINDOW) {
+            window = CRNG_PRIME_SIEVE_WINDOW;
+        }
+        size = (size_t)window;
+        memset(composite, 0, size);
+        for (index = 0; index < CRNG_PRIME_SIEVE_PRIMES; ++index) {
+            for (target = 0; target < targets; ++target) {
+                uint32_t offset = next[index][target];
+
+                if (offset == UINT32_MAX) {
+                    continue;
+                }
+                for (; offset < size; offset += stride[index]) {
+                    composite[offset] = 1;
+                }
+                next[index][target] = offset - (uint32_t)size;
+            }
+        }
+        /* Small terms go to the exact test instead of trusting the marks. */
+        for (index = 0; index < size && base + walk->step * index <= exact_limit; ++index) {
+            composite[index] = 0;
+        }
+
+        for (index = 0, survivors = 0; index < size; ++index) {
+            if (composite[index] == 0) {
+                positions[survivors] = index;
+                values[survivors++] = base + walk->step * (uint64_t)index;
+            }
+            if (survivors == CRNG_PRIME_LANES || (index + 1U == size && survivors != 0)) {
+                size_t from = 0;
+
+                while (from < survivors) {
+                    const size_t found =
+                        from + crng_first_prime_u64(values + from, survivors - from);
+
+                    if (found == survivors) {
+                        break;
+                    }
+                    if (!walk->safe || crng_crypto_is_prime_u64((values[found] - 1U) / 2U)) {
+                        *remaining -= (uint64_t)positions[found] + 1U;
+                        *out = values[found];
+                        return true;
+                    }
+                    from = found + 1U;
+                }
+                survivors = 0;
+            }
+        }
+
+        *remaining -= window;
+        count -= window;
+        if (count != 0) {
+            base += walk->step * window;
+        }
+    }
+    return false;
+}
+
+/* Search candidates [begin, end), small values first, then progression terms. */
+static bool crng_prime_walk_range(
+    const crng_prime_walk *walk,
+    uint64_t begin,
+    uint64_t end,
+    uint64_t *remaining,
+    uint64_t *out
+) {
+    for (; begin < end && begin < walk->small_count; ++begin) {
+        if (*remaining == 0) {
+            return false;
+        }
+        --*remaining;
+        if (crng_prime_walk_accepts(walk, walk->small[begin])) {
+            *out = walk->small[begin];
+            return true;
+        }
+    }
+    if (begin >= end || *remaining == 0) {
+        return false;
+    }
+    return crng_prime_walk_terms(
+        walk, begin - walk->small_count, end - walk->small_count, remaining, out);
+}
+
+/* Walk upward from one uniform OS-random candidate, then wrap to the first. */
+static crng_status crng_prime_walk_search(
+    const crng_prime_walk *walk,
+    uint64_t max_attempts,
+    uint64_t *out
+) {
+    const uint64_t total = (uint64_t)walk->small_count + walk->count;
+    uint64_t remaining = max_attempts;
+    uint64_t start;
+    uint64_t prime;
+    crng_status status;
+
+    CRNG_SECURE_STAT_ADD(prime_searches, 1U);
+    CRNG_PROBE3(prime_search_entry, walk->first, walk->step, max_attempts);
+    if (total == 0) {
+        CRNG_SECURE_STAT_ADD(prime_not_found, 1U);
+        CRNG_PROBE2(prime_search_return, (int)CRNG_ERR_NOT_FOUND, UINT64_C(0));
+        return CRNG_ERR_NOT_FOUND;
+    }
+    status = crng_secure_uniform_u64(total, &start);
+    if (status != CRNG_OK) {
+        return status;
+    }
+    if (crng_prime_walk_range(walk, start, total, &remaining, &prime) ||
+        (start != 0 && crng_prime_walk_range(walk, 0, start, &remaining, &prime))) {
+        CRNG_SECURE_STAT_ADD(prime_attempts, max_attempts - remaining);
+        CRNG_PROBE2(prime_search_return, (int)CRNG_OK, max_attempts - remaining);
+        *out = prime;
+        return CRNG_OK;
+    }
+    CRNG_SECURE_STAT_ADD(prime_attempts, max_attempts - remaining);
+    CRNG_SECURE_STAT_ADD(prime_not_found, 1U);
+    CRNG_PROBE2(prime_search_return, (int)CRNG_ERR_NOT_FOUND, max_attempts - remaining);
+    return CRNG_ERR_NOT_FOUND;
+}
+
+crng_status crng_crypto_random_prime_u64_sieved(
+    uint64_t minimum,
+    uint64_t maximum,
+    uint64_t max_attempts,
+    uint64_t *out
+) {
+    return crng_crypto_random_prime_congruent_u64(
+        minimum, maximum, 0, UINT64_C(1), max_attempts, out);
+}
+
+crng_status crng_crypto_random_prime_congruent_u64(
+    uint64_t minimum,
+    uint64_t maximum,
+    uint64_t residue,
+    uint64_t modulus,
+    uint64_t max_attempts,
+    uint64_t *out
+) {
+    crng_prime_walk walk;
+    uint64_t odd_residue;
+
+    if (out == NULL) {
+        return CRNG_ERR_NULL;
+    }
+    if (minimum > maximum || max_attempts == 0 || maximum < UINT64_C(2) ||
+        modulus == 0 || residue >= modulus) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+    if (minimum < UINT64_C(2)) {
+        minimum = UINT64_C(2);
+    }
+
+    /*
+     * Every member of a class sharing a factor with the modulus has that
+     * factor, so only its least positive member can be prime.
+     */
+    if (crng_gcd_u64(residue, modulus) != 1U) {
+        const uint64_t member = residue != 0 ? residue : modulus;
+
+        CRNG_SECURE_STAT_ADD(prime_searches, 1U);
+        CRNG_SECURE_STAT_ADD(prime_attempts, 1U);
+        if (member >= minimum && member <= maximum && crng_crypto_is_prime_u64(member)) {
+            *out = member;
+            return CRNG_OK;
+        }
+        CRNG_SECURE_STAT_ADD(prime_not_found, 1U);
+        return CRNG_ERR_NOT_FOUND;
+    }
+
+    memset(&walk, 0, sizeof walk);
+    if (minimum == UINT64_C(2) && UINT64_C(2) % modulus == residue) {
+        walk.small[walk.small_count++] = UINT64_C(2);
+    }
+    if ((modulus & 1U) == 0) {
+        /* The residue is odd, so every term already is. */
+        crng_prime_walk_set_terms(&walk, minimum, maximum, residue, modulus);
+    } else if (modulus <= UINT64_MAX / 2U) {
+        odd_residue = (residue & 1U) != 0 ? residue : residue + modulus;
+        crng_prime_walk_set_terms(&walk, minimum, maximum, odd_residue, 2U * modulus);
+    } else {
+        /* At most one odd member fits below 2^64. */
+        odd_residue = residue;
+        if ((odd_residue & 1U) == 0 && odd_residue <= UINT64_MAX - modulus) {
+            odd_residue += modulus;
+        }
+        if ((odd_residue & 1U) != 0 && odd_residue >= minimum && odd_residue <= maximum) {
+            walk.small[walk.small_count++] = odd_residue;
+        }
+    }
+    return crng_prime_walk_search(&walk, max_attempts, out);
+}
+
+crng_status crng_crypto_random_safe_prime_u64(
+    uint64_t minimum,
+    uint64_t maximum,
+    uint64_t max_attempts,
+    uint64_t *out
+) {
+    crng_prime_walk walk;
+
+    if (out == NULL) {
+        return CRNG_ERR_NULL;
+    }
+    if (minimum > maximum || max_attempts == 0 || maximum < UINT64_C(5)) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+
+    /* Safe primes above 7 are 11 (mod 12): p == 3 (mod 4), p == 2 (mod 3). */
+    memset(&walk, 0, sizeof walk);
+    walk.safe = true;
+    if (minimum <= UINT64_C(5) && maximum >= UINT64_C(5)) {
+        walk.small[walk.small_count++] = UINT64_C(5);
+    }
+    if (minimum <= UINT64_C(7) && maximum >= UINT64_C(7)) {
+        walk.small[walk.small_count++] = UINT64_C(7);
+    }
+    crng_prime_walk_set_terms(
+        &walk, minimum < UINT64_C(8) ? UINT64_C(8) : minimum, maximum, UINT64_C(11), UINT64_C(12));
+    return crng_prime_walk_search(&walk, max_attempts, out);
+}
+
+/* Odd primes tried by the 128-bit screen before Baillie-PSW. */
+#define CRNG_PRIME_U128_SCREEN 128U
+
+static bool crng_u128_less(crng_u128 left, crng_u128 right) {
+    return left.high != right.high ? left.high < right.high : left.low < right.low;
+}
+
+static bool crng_u128_equal(crng_u128 left, crng_u128 right) {
+    return left.high == right.high && left.low == right.low;
+}
+
+/* Wrapping sum; *carry receives the bit shifted out. */
+static crng_u128 crng_u128_add(crng_u128 left, crng_u128 right, uint64_t *carry) {
+    crng_u128 sum;
+
+    sum.low = left.low + right.low;
+    sum.high = left.high + right.high;
+    *carry = sum.high < left.high ? 1U : 0U;
+    if (sum.low < left.low) {
+        ++sum.high;
+        *carry |= sum.high == 0 ? 1U : 0U;
+    }
+    return sum;
+}
+
+/* Wrapping difference. */
+static crng_u128 crng_u128_sub(crng_u128 left, crng_u128 right) {
+    crng_u128 difference;
+
+    difference.low = left.low - right.low;
+    difference.high = left.high - right.high - (left.low < right.low ? 1U : 0U);
+    return difference;
+}
+
+static crng_u128 crng_u128_shift_right(crng_u128 value, unsigned int shift) {
+    crng_u128 result;
+
+    if (shift == 0) {
+        return value;
+    }
+    if (shift >= 64U) {
+        result.low = value.high >> (shift - 64U);
+        result.high = 0;
+    } else {
+        result.low = (value.low >> shift) | (value.high << (64U - shift));
+        result.high = value.high >> shift;
+    }
+    return result;
+}
+
+static bool crng_u128_bit(crng_u128 value, int bit) {
+    return bit >= 64
+        ? ((value.high >> (bit - 64)) & UINT64_C(1)) != 0
+        : ((value.low >> bit) & UINT64_C(1)) != 0;
+}
+
+static int crng_u128_top_bit(crng_u128 value) {
+    uint64_t word = value.high != 0 ? value.high : value.low;
+    int bit = value.high != 0 ? 64 : 0;
+
+    while (word > 1U) {
+        word >>= 1;
+        ++bit;
+    }
+    return bit;
+}
+
+/* Remainder modulo a divisor below 2^32. */
+static uint64_t crng_u128_mod_small(crng_u128 value, uint64_t divisor) {
+    const uint64_t radix = (UINT64_MAX % divisor + 1U) % divisor;
+
+    return ((value.high % divisor) * radix + value.low % divisor) % divisor;
+}
+
+/*
+ * Trial division of an odd value of at least 2^64 by the first `count` odd
+ * primes. For n = high * 2^64 + low = p * q, the low quotient word is
+ * low * inverse and the high word satisfies high - mulhi(q_low, p) = p * q_high,
+ * so each prime costs three multiplies.
+ */
+static bool crng_trial_divide_u128(crng_u128 value, size_t count) {
+    size_t index;
+
+    for (index = 0; index < count; ++index) {
+        const crng_small_prime *entry = &crng_small_primes[index];
+        uint64_t carried;
+
+        (void)crng_mul_wide_u64(value.low * entry->inverse, entry->prime, &carried);
+        if (value.high >= carried &&
+            (value.high - carried) * entry->inverse <= entry->limit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Montgomery arithmetic modulo an odd modulus of at least 2^64, R = 2^128. */
+typedef struct crng_montgomery_u128 {
+    crng_u128 modulus;
+    uint64_t inverse;
+    crng_u128 one;
+    crng_u128 r_squared;
+} crng_montgomery_u128;
+
+/* Return the low word of left * right + first + second; never overflows. */
+static uint64_t crng_mul_add_u64(
+    uint64_t left,
+    uint64_t right,
+    uint64_t first,
+    uint64_t second,
+    uint64_t *high
+) {
+#if defined(CRNG_HAVE_INT128)
+    const crng_uint128 sum = (crng_uint128)left * right + first + second;
+
+    *high = (uint64_t)(sum >> 64);
+    return (uint64_t)sum;
+#else
+    uint64_t low = crng_mul_wide_u64(left, right, high);
+
+    low += first;
+    *high += low < first ? 1U : 0U;
+    low += second;
+    *high += low < second ? 1U : 0U;
+    return low;
+#endif
+}
+
+static crng_u128 crng_montgomery128_add(
+    const crng_montgomery_u128 *context,
+    crng_u128 left,
+    crng_u128 right
+) {
+    uint64_t carry;
+    const crng_u128 sum = crng_u128_add(left, right, &carry);
+
+    return carry != 0 || !crng_u128_less(sum, context->modulus)
+        ? crng_u128_sub(sum, context->modulus)
+        : sum;
+}
+
+static crng_u128 crng_montgomery128_sub(
+    const crng_montgomery_u128 *context,
+    crng_u128 left,
+    crng_u128 right
+) {
+    uint64_t carry;
+    const crng_u128 difference = crng_u128_sub(left, right);
+
+    return crng_u128_less(left, right)
+        ? crng_u128_add(difference, context->modulus, &carry)
+        : difference;
+}
+
+static crng_u128 crng_montgomery128_half(
+    const crng_montgomery_u128 *context,
+    crng_u128 value
+) {
+    uint64_t carry = 0;
+
+    if ((value.low & UINT64_C(1)) != 0) {
+        value = crng_u128_add(value, context->modulus, &carry);
+    }
+    value = crng_u128_shift_right(value, 1U);
+    value.high |= carry << 63;
+    return value;
+}
+
+/*
+ * Coarsely integrated operand scanning: one 64-bit word of `right` at a
+ * time, reducing by one word after each. Inputs below the modulus give a
+ * result below it; t holds at most four words before each shift.
+ */
+static crng_u128 crng_montgomery128_mul(
+    const crng_montgomery_u128 *context,
+    crng_u128 left,
+    crng_u128 right
+) {
+    const uint64_t words[2] = {right.low, right.high};
+    uint64_t t0 = 0;
+    uint64_t t1 = 0;
+    uint64_t t2 = 0;
+    size_t index;
+    crng_u128 result;
+
+    for (index = 0; index < 2U; ++index) {
+        uint64_t carry;
+        uint64_t t3;
+        uint64_t factor;
+
+        t0 = crng_mul_add_u64(left.low, words[index], t0, 0, &carry);
+        t1 = crng_mul_add_u64(left.high, words[index], t1, carry, &carry);
+        t2 += carry;
+        t3 = t2 < carry ? 1U : 0U;
+
+        factor = t0 * context->inverse;
+        (void)crng_mul_add_u64(factor, context->modulus.low, t0, 0, &carry);
+        t0 = crng_mul_add_u64(factor, context->modulus.high, t1, carry, &carry);
+        t1 = t2 + carry;
+        t2 = t3 + (t1 < carry ? 1U : 0U);
+    }
+
+    result.low = t0;
+    result.high = t1;
+    return t2 != 0 || !crng_u128_less(result, context->modulus)
+        ? crng_u128_sub(result, context->modulus)
+        : result;
+}
+
+static void crng_montgomery128_init(crng_montgomery_u128 *context, crng_u128 modulus) {
+    uint64_t inverse = modulus.low;
+    crng_u128 power;
+    const int top = crng_u128_top_bit(modulus);
+    int bit;
+    unsigned int round;
+
+    for (round = 0; round < 5; ++round) {
+        inverse *= UINT64_C(2) - modulus.low * inverse;
+    }
+    context->modulus = modulus;
+    context->inverse = UINT64_C(0) - inverse;
+
+    /* Double 2^top, the largest power of two below the modulus, to 2^128. */
+    power.low = 0;
+    power.high = UINT64_C(1) << (top - 64);
+    for (bit = top; bit < 128; ++bit) {
+        power = crng_montgomery128_add(context, power, power);
+    }
+    context->one = power;
+
+    /* (2^64 R)^2 / R = R^2 (mod n). */
+    for (round = 0; round < 64; ++round) {
+        power = crng_montgomery128_add(context, power, power);
+    }
+    context->r_squared = crng_montgomery128_mul(context, power, power);
+}
+
+static crng_u128 crng_montgomery128_from_small(
+    const crng_montgomery_u128 *context,
+    uint64_t value
+) {
+    crng_u128 wide;
+
+    wide.low = value;
+    wide.high = 0;
+    return crng_montgomery128_mul(context, wide, context->r_squared);
+}
+
+static bool crng_montgomery128_base2(const crng_montgomery_u128 *context) {
+    const crng_u128 minus_one = crng_u128_sub(context->modulus, context->one);
+    crng_u128 odd_part = context->modulus;
+    crng_u128 result = context->one;
+    unsigned int powers_of_two = 0;
+    int bit;
+
+    odd_part.low -= 1U; /* The modulus is odd, so no borrow. */
+    while ((odd_part.low & UINT64_C(1)) == 0) {
+        odd_part = crng_u128_shift_right(odd_part, 1U);
+        ++powers_of_two;
+    }
+
+    for (bit = crng_u128_top_bit(odd_part); bit >= 0; --bit) {
+        result = crng_montgomery128_mul(context, result, result);
+        if (crng_u128_bit(odd_part, bit)) {
+            result = crng_montgomery128_add(context, result, result);
+        }
+    }
+
+    if (crng_u128_equal(result, context->one) || crng_u128_equal(result, minus_one)) {
+        return true;
+    }
+    while (--powers_of_two != 0) {
+        result = crng_montgomery128_mul(context, result, result);
+        if (crng_u128_equal(result, minus_one)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool crng_is_square_u128(crng_u128 value) {
+    const uint64_t squares_mod_64 = UINT64_C(0x0202021202030213);
+    crng_u128 root = {0, 0};
+    crng_u128 bit = {0, UINT64_C(1) << 62};
+
+    if (((squares_mod_64 >> (value.low & UINT64_C(63))) & UINT64_C(1)) == 0) {
+        return false;
+    }
+
+    while (crng_u128_less(value, bit)) {
+        bit = crng_u128_shift_right(bit, 2U);
+    }
+    while (bit.low != 0 || bit.high != 0) {
+        uint64_t carry;
+        const crng_u128 trial = crng_u128_add(root, bit, &carry);
+
+        root = crng_u128_shift_right(root, 1U);
+        if (!crng_u128_less(value, trial)) {
+            value = crng_u128_sub(value, trial);
+            root = crng_u128_add(root, bit, &carry);
+        }
+        bit = crng_u128_shift_right(bit, 2U);
+    }
+    return value.low == 0 && value.high == 0;
+}
+
+/* Strong Lucas test with Selfridge's parameters, as for 64-bit moduli. */
+static bool crng_montgomery128_strong_lucas(const crng_montgomery_u128 *context) {
+    const crng_u128 modulus = context->modulus;
+    const bool three_mod_four = (modulus.low & UINT64_C(3)) == UINT64_C(3);
+    int64_t discriminant = 5;
+    uint64_t magnitude;
+    crng_u128 odd_part;
+    crng_u128 u;
+    crng_u128 v;
+    crng_u128 q_power;
+    crng_u128 q_base;
+    crng_u128 d_form;
+    unsigned int powers_of_two = 0;
+    uint64_t carry;
+    int bit;
+
+    if (crng_is_square_u128(modulus)) {
+        return false;
+    }
+    for (;;) {
+        int symbol;
+
+        magnitude = (uint64_t)(discriminant < 0 ? -discriminant : discriminant);
+        symbol = crng_jacobi_u64(crng_u128_mod_small(modulus, magnitude), magnitude);
+        if ((magnitude & UINT64_C(3)) == UINT64_C(3) && three_mod_four) {
+            symbol = -symbol;
+        }
+        if (discriminant < 0 && three_mod_four) {
+            symbol = -symbol;
+        }
+        if (symbol == -1) {
+            break;
+        }
+        if (symbol == 0) {
+            return false;
+        }
+        discriminant = discriminant < 0 ? 2 - discriminant : -2 - discriminant;
+    }
+
+    /* Negative constants are formed by subtraction from Montgomery zero. */
+    {
+        const crng_u128 zero = {0, 0};
+        const int64_t q_value = (1 - discriminant) / 4;
+        const crng_u128 d_positive = crng_montgomery128_from_small(context, magnitude);
+        const crng_u128 q_positive = crng_montgomery128_from_small(
+            context, (uint64_t)(q_value < 0 ? -q_value : q_value));
+
+        d_form = discriminant < 0
+            ? crng_montgomery128_sub(context, zero, d_positive)
+            : d_positive;
+        q_base = q_value < 0
+            ? crng_montgomery128_sub(context, zero, q_positive)
+            : q_positive;
+    }
+
+    /* The modulus is odd and not 2^128 - 1, which has the factor three. */
+    odd_part = crng_u128_add(modulus, (crng_u128){1U, 0}, &carry);
+    while ((odd_part.low & UINT64_C(1)) == 0) {
+        odd_part = crng_u128_shift_right(odd_part, 1U);
+        ++powers_of_two;
+    }
+
+    u = context->one;
+    v = context->one;
+    q_power = q_base;
+    for (bit = crng_u128_top_bit(odd_part) - 1; bit >= 0; --bit) {
+        u = crng_montgomery128_mul(context, u, v);
+        v = crng_montgomery128_sub(
+            context,
+            crng_montgomery128_mul(context, v, v),
+            crng_montgomery128_add(context, q_power, q_power)
+        );
+        q_power = crng_montgomery128_mul(context, q_power, q_power);
+        if (crng_u128_bit(odd_part, bit)) {
+            const crng_u128 next_u = crng_montgomery128_half(
+                context,
+                crng_montgomery128_add(context, u, v)
+            );
+            v = crng_montgomery128_half(
+                context,
+                crng_montgomery128_add(context, crng_montgomery128_mul(context, d_form, u), v)
+            );
+            u = next_u;
+            q_power = crng_montgomery128_mul(context, q_power, q_base);
+        }
+    }
+
+    if ((u.low == 0 && u.high == 0) || (v.low == 0 && v.high == 0)) {
+        return true;
+    }
+    while (--powers_of_two != 0) {
+        v = crng_montgomery128_sub(
+            context,
+            crng_montgomery128_mul(context, v, v),
+            crng_montgomery128_add(context, q_power, q_power)
+        );
+        if (v.low == 0 && v.high == 0) {
+            return true;
+        }
+        q_power = crng_montgomery128_mul(context, q_power, q_power);
+    }
+    return false;
+}
+
+bool crng_crypto_is_prime_u128(crng_u128 value) {
+    crng_montgomery_u128 context;
+
+    if (value.high == 0) {
+        return crng_crypto_is_prime_u64(value.low);
+    }
+    if ((value.low & UINT64_C(1)) == 0 ||
+        !crng_trial_divide_u128(value, CRNG_PRIME_U128_SCREEN)) {
+        return false;
+    }
+    crng_montgomery128_init(&context, value);
+    return crng_montgomery128_base2(&context) && crng_montgomery128_strong_lucas(&context);
+}
+
+crng_status crng_secure_uniform_u128(crng_u128 upper_bound, crng_u128 *out) {
+    crng_u128 limit;
+    crng_u128 mask;
+    uint64_t words[2];
+    unsigned int shift;
+    crng_status status;
+
+    if (out == NULL) {
+        return CRNG_ERR_NULL;
+    }
+    if (upper_bound.low == 0 && upper_bound.high == 0) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+
+    /* Mask to the bit length of upper_bound - 1; each draw succeeds with p > 1/2. */
+    limit = crng_u128_sub(upper_bound, (crng_u128){1U, 0});
+    mask.high = limit.high;
+    mask.low = limit.high != 0 ? UINT64_MAX : limit.low;
+    for (shift = 1; shift < 64U; shift <<= 1) {
+        mask.high |= mask.high >> shift;
+        mask.low |= mask.low >> shift;
+    }
+    do {
+        status = crng_secure_bytes(words, sizeof(words));
+        if (status != CRNG_OK) {
+            return status;
+        }
+        words[0] &= mask.low;
+        words[1] &= mask.high;
+        if (words[1] > limit.high || (words[1] == limit.high && words[0] > limit.low)) {
+            CRNG_SECURE_STAT_ADD(uniform_rejections, 1U);
+            CRNG_PROBE2(secure_uniform_reject_u128, upper_bound.low, upper_bound.high);
+        }
+    } while (words[1] > limit.high || (words[1] == limit.high && words[0] > limit.low));
+
+    CRNG_SECURE_STAT_ADD(uniform_results, 1U);
+    out->low = words[0];
+    out->high = words[1];
+    crng_secure_zero(words, sizeof(words));
+    return CRNG_OK;
+}
+
+crng_status crng_crypto_random_prime_u128(
+    crng_u128 minimum,
+    crng_u128 maximum,
+    uint64_t max_attempts,
+    crng_u128 *out
+) {
+    const crng_u128 two = {2U, 0};
+    crng_u128 span;
+    uint64_t attempt;
+    uint64_t carry;
+
+    if (out == NULL) {
+        return CRNG_ERR_NULL;
+    }
+    if (crng_u128_less(maximum, minimum) || max_attempts == 0 ||
+        crng_u128_less(maximum, two)) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+    if (crng_u128_less(minimum, two)) {
+        minimum = two;
+    }
+
+    span = crng_u128_add(crng_u128_sub(maximum, minimum), (crng_u128){1U, 0}, &carry);
+    CRNG_SECURE_STAT_ADD(prime_searches, 1U);
+    CRNG_PROBE3(prime_search_entry, minimum.high, maximum.high, max_attempts);
+    for (attempt = 0; attempt < max_attempts; ++attempt) {
+        crng_u128 candidate;
+        crng_status status;
+
+        status = crng_secure_uniform_u128(span, &candidate);
+        if (status != CRNG_OK) {
+            return status;
+        }
+        candidate = crng_u128_add(minimum, candidate, &carry);
+        CRNG_SECURE_STAT_ADD(prime_attempts, 1U);
+        CRNG_PROBE2(prime_attempt_u128, candidate.low, candidate.high);
+        if (crng_crypto_is_prime_u128(candidate)) {
+            CRNG_PROBE2(prime_search_return, (int)CRNG_OK, attempt + 1U);
             *out = candidate;
             return CRNG_OK;
         }
     }
+    CRNG_SECURE_STAT_ADD(prime_not_found, 1U);
+    CRNG_PROBE2(prime_search_return, (int)CRNG_ERR_NOT_FOUND, max_attempts);
     return CRNG_ERR_NOT_FOUND;
 }
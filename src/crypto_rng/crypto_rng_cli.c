@@ -1,4 +1,12 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#  define _DEFAULT_SOURCE
+#endif
+#if defined(_MSC_VER) && !defined(_CRT_SECURE_NO_WARNINGS)
+#  define _CRT_SECURE_NO_WARNINGS /* strerror is used portably here. */
+#endif
+
 #include "classical_rng/crypto_rng.h"
+#include "../common/secure_zero.h"
 
 #include <errno.h>
 #include <inttypes.h>
@@ -6,9 +14,40 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(_WIN32)
+#  include <fcntl.h>
+#  include <io.h>
+#else
+#  include <signal.h>
+#  include <unistd.h>
+#endif
+
+/*
+ * One OS request serves many tokens. The size is a multiple of three so a
+ * token longer than one request still base64-encodes in whole groups.
+ */
+#define CRNG_CRYPTO_RANDOM_BYTES 65535U
+#define CRNG_CRYPTO_OUTPUT_BYTES ((size_t)1 << 20)
+
+typedef enum crng_crypto_format {
+    CRNG_CRYPTO_FORMAT_HEX,
+    CRNG_CRYPTO_FORMAT_RAW,
+    CRNG_CRYPTO_FORMAT_BASE64,
+    CRNG_CRYPTO_FORMAT_BASE64URL
+} crng_crypto_format;
+
+/* Encoding tables: one byte to two hex digits, twelve bits to two base64 symbols. */
+static unsigned char crng_crypto_hex_pairs[256][2];
+static unsigned char crng_crypto_base64_pairs[4096][2];
+static const char *crng_crypto_base64_alphabet;
+
 static void crng_crypto_usage(const char *program) {
     fprintf(stderr,
-            "usage: %s [--bytes N | --prime MIN MAX] [--attempts N]\n",
+            "usage: %s [--bytes N] [--count N] [--format hex|raw|base64|base64url]\n"
+            "       %s --prime MIN MAX [--attempts N]\n"
+            "       %s --prime-table PATH LIMIT\n",
+            program,
+            program,
             program);
 }
 
@@ -28,12 +67,239 @@ static int crng_crypto_parse_u64(const char *text, uint64_t *out) {
     return 1;
 }
 
+static void crng_crypto_prepare_tables(crng_crypto_format format) {
+    static const char hex_digits[] = "0123456789abcdef";
+    unsigned int index;
+
+    for (index = 0; index < 256U; ++index) {
+        crng_crypto_hex_pairs[index][0] = (unsigned char)hex_digits[index >> 4];
+        crng_crypto_hex_pairs[index][1] = (unsigned char)hex_digits[index & 15U];
+    }
+    crng_crypto_base64_alphabet =
+        format == CRNG_CRYPTO_FORMAT_BASE64URL
+            ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+            : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for (index = 0; index < 4096U; ++index) {
+        crng_crypto_base64_pairs[index][0] =
+            (unsigned char)crng_crypto_base64_alphabet[index >> 6];
+        crng_crypto_base64_pairs[index][1] =
+            (unsigned char)crng_crypto_base64_alphabet[index & 63U];
+    }
+}
+
+static size_t crng_crypto_encoded_size(crng_crypto_format format, size_t size) {
+    switch (format) {
+    case CRNG_CRYPTO_FORMAT_HEX:
+        return size * 2U;
+    case CRNG_CRYPTO_FORMAT_BASE64:
+    case CRNG_CRYPTO_FORMAT_BASE64URL:
+        return (size + 2U) / 3U * 4U;
+    case CRNG_CRYPTO_FORMAT_RAW:
+        break;
+    }
+    return size;
+}
+
+/*
+ * Encode one piece of a token. Only a token's final piece may have a length
+ * that is not a multiple of three; base64 pads it, base64url leaves it short.
+ */
+static size_t crng_crypto_encode(
+    crng_crypto_format format,
+    unsigned char *out,
+    const unsigned char *bytes,
+    size_t size
+) {
+    size_t length = 0;
+    size_t index = 0;
+
+    if (format == CRNG_CRYPTO_FORMAT_RAW) {
+        memcpy(out, bytes, size);
+        return size;
+    }
+    if (format == CRNG_CRYPTO_FORMAT_HEX) {
+        for (index = 0; index < size; ++index) {
+            memcpy(out + length, crng_crypto_hex_pairs[bytes[index]], 2U);
+            length += 2U;
+        }
+        return length;
+    }
+    for (; index + 3U <= size; index += 3U) {
+        const uint32_t group = (uint32_t)bytes[index] << 16 |
+                               (uint32_t)bytes[index + 1U] << 8 | bytes[index + 2U];
+
+        memcpy(out + length, crng_crypto_base64_pairs[group >> 12], 2U);
+        memcpy(out + length + 2U, crng_crypto_base64_pairs[group & 0xfffU], 2U);
+        length += 4U;
+    }
+    if (index < size) {
+        const uint32_t group = (uint32_t)bytes[index] << 16 |
+                               (index + 1U < size ? (uint32_t)bytes[index + 1U] << 8 : 0U);
+
+        out[length++] = (unsigned char)crng_crypto_base64_alphabet[group >> 18];
+        out[length++] = (unsigned char)crng_crypto_base64_alphabet[(group >> 12) & 63U];
+        if (index + 1U < size) {
+            out[length++] = (unsigned char)crng_crypto_base64_alphabet[(group >> 6) & 63U];
+        } else if (format == CRNG_CRYPTO_FORMAT_BASE64) {
+            out[length++] = '=';
+        }
+        if (format == CRNG_CRYPTO_FORMAT_BASE64) {
+            out[length++] = '=';
+        }
+    }
+    return length;
+}
+
+/* Returns 0 on success, 1 when the reader has gone away, -1 on error. */
+static int crng_crypto_write_all(const unsigned char *data, size_t size) {
+#if defined(_WIN32)
+    if (fwrite(data, 1, size, stdout) != size) {
+        return errno == EPIPE || errno == EINVAL ? 1 : -1;
+    }
+    return 0;
+#else
+    while (size != 0) {
+        const ssize_t written = write(STDOUT_FILENO, data, size);
+
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EPIPE ? 1 : -1;
+        }
+        data += written;
+        size -= (size_t)written;
+    }
+    return 0;
+#endif
+}
+
+/*
+ * Emit `count` independent tokens of `size` bytes, one per line except in raw
+ * format. Entropy is read in large requests, encoded into a large output
+ * buffer, and written in big blocks; both buffers are erased before return.
+ */
+static int crng_crypto_emit_tokens(crng_crypto_format format, uint64_t size, uint64_t count) {
+    const size_t capacity = CRNG_CRYPTO_OUTPUT_BYTES +
+                            crng_crypto_encoded_size(format, CRNG_CRYPTO_RANDOM_BYTES) + 1U;
+    unsigned char *random;
+    unsigned char *output;
+    uint64_t total_remaining;
+    size_t available = 0;
+    size_t offset = 0;
+    size_t length = 0;
+    int result = 0;
+
+    if (count != 0 && size > UINT64_MAX / count) {
+        fprintf(stderr, "requested output is too large\n");
+        return 2;
+    }
+    total_remaining = size * count;
+    random = (unsigned char *)malloc(CRNG_CRYPTO_RANDOM_BYTES);
+    output = (unsigned char *)malloc(capacity);
+    if (random == NULL || output == NULL) {
+        free(random);
+        free(output);
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    crng_crypto_prepare_tables(format);
+#if defined(_WIN32)
+    if (format == CRNG_CRYPTO_FORMAT_RAW) {
+        (void)_setmode(_fileno(stdout), _O_BINARY);
+    }
+#else
+    signal(SIGPIPE, SIG_IGN);
+#endif
+
+    while (count-- != 0 && result == 0) {
+        uint64_t remaining = size;
+
+        /* Start a fresh request when this token would straddle two. */
+        if (remaining > available) {
+            available = 0;
+        }
+        do {
+            size_t piece;
+
+            if (available == 0 && remaining != 0) {
+                const size_t request = total_remaining < CRNG_CRYPTO_RANDOM_BYTES
+                                           ? (size_t)total_remaining
+                                           : CRNG_CRYPTO_RANDOM_BYTES;
+                const crng_status status = crng_secure_bytes(random, request);
+
+                if (status != CRNG_OK) {
+                    fprintf(stderr, "secure random source failed: %s\n",
+                            crng_status_string(status));
+                    result = 1;
+                    break;
+                }
+                available = request;
+                offset = 0;
+            }
+            piece = remaining < available ? (size_t)remaining : available;
+            if (length + crng_crypto_encoded_size(format, piece) + 1U > capacity) {
+                const int written = crng_crypto_write_all(output, length);
+
+                length = 0;
+                if (written != 0) {
+                    result = written < 0 ? -1 : 2;
+                    break;
+                }
+            }
+            length += crng_crypto_encode(format, output + length, random + offset, piece);
+            offset += piece;
+            available -= piece;
+            remaining -= piece;
+            total_remaining -= piece;
+        } while (remaining != 0);
+        if (result == 0 && format != CRNG_CRYPTO_FORMAT_RAW) {
+            output[length++] = '\n';
+        }
+        if (result == 0 && length > CRNG_CRYPTO_OUTPUT_BYTES) {
+            const int written = crng_crypto_write_all(output, length);
+
+            length = 0;
+            if (written != 0) {
+                result = written < 0 ? -1 : 2;
+            }
+        }
+    }
+    if (result == 0 && length != 0) {
+        const int written = crng_crypto_write_all(output, length);
+
+        if (written != 0) {
+            result = written < 0 ? -1 : 2;
+        }
+    }
+#if defined(_WIN32)
+    if (result == 0 && fflush(stdout) != 0) {
+        result = errno == EPIPE || errno == EINVAL ? 2 : -1;
+    }
+#endif
+    if (result < 0) {
+        fprintf(stderr, "write failed: %s\n", strerror(errno));
+        result = 1;
+    } else if (result == 2) {
+        /* The reader closed the pipe; that ends the output, not an error. */
+        result = 0;
+    }
+    crng_secure_zero(random, CRNG_CRYPTO_RANDOM_BYTES);
+    crng_secure_zero(output, capacity);
+    free(random);
+    free(output);
+    return result;
+}
+
 int main(int argc, char **argv) {
     uint64_t byte_count = UINT64_C(32);
+    uint64_t token_count = UINT64_C(1);
+    crng_crypto_format format = CRNG_CRYPTO_FORMAT_HEX;
     uint64_t minimum = 0;
     uint64_t maximum = 0;
     uint64_t attempts = UINT64_C(1024);
     int prime_mode = 0;
+    const char *table_path = NULL;
     int argument;
 
     for (argument = 1; argument < argc; ++argument) {
@@ -42,6 +308,26 @@ int main(int argc, char **argv) {
                 crng_crypto_usage(argv[0]);
                 return 2;
             }
+        } else if (strcmp(argv[argument], "--count") == 0 && argument + 1 < argc) {
+            if (!crng_crypto_parse_u64(argv[++argument], &token_count)) {
+                crng_crypto_usage(argv[0]);
+                return 2;
+            }
+        } else if (strcmp(argv[argument], "--format") == 0 && argument + 1 < argc) {
+            const char *name = argv[++argument];
+
+            if (strcmp(name, "hex") == 0) {
+                format = CRNG_CRYPTO_FORMAT_HEX;
+            } else if (strcmp(name, "raw") == 0) {
+                format = CRNG_CRYPTO_FORMAT_RAW;
+            } else if (strcmp(name, "base64") == 0) {
+                format = CRNG_CRYPTO_FORMAT_BASE64;
+            } else if (strcmp(name, "base64url") == 0) {
+                format = CRNG_CRYPTO_FORMAT_BASE64URL;
+            } else {
+                crng_crypto_usage(argv[0]);
+                return 2;
+            }
         } else if (strcmp(argv[argument], "--prime") == 0 && argument + 2 < argc) {
             prime_mode = 1;
             if (!crng_crypto_parse_u64(argv[++argument], &minimum) ||
@@ -49,6 +335,12 @@ int main(int argc, char **argv) {
                 crng_crypto_usage(argv[0]);
                 return 2;
             }
+        } else if (strcmp(argv[argument], "--prime-table") == 0 && argument + 2 < argc) {
+            table_path = argv[++argument];
+            if (!crng_crypto_parse_u64(argv[++argument], &maximum)) {
+                crng_crypto_usage(argv[0]);
+                return 2;
+            }
         } else if (strcmp(argv[argument], "--attempts") == 0 && argument + 1 < argc) {
             if (!crng_crypto_parse_u64(argv[++argument], &attempts)) {
                 crng_crypto_usage(argv[0]);
@@ -63,6 +355,20 @@ int main(int argc, char **argv) {
         }
     }
 
+    if (table_path != NULL) {
+        crng_prime_table table;
+        crng_status status = crng_prime_table_build(&table, maximum);
+        if (status == CRNG_OK) {
+            status = crng_prime_table_save(&table, table_path);
+            crng_prime_table_free(&table);
+        }
+        if (status != CRNG_OK) {
+            fprintf(stderr, "prime table generation failed: %s\n", crng_status_string(status));
+            return 1;
+        }
+        return 0;
+    }
+
     if (prime_mode != 0) {
         uint64_t prime;
         crng_status status = crng_crypto_random_prime_u64(
@@ -79,26 +385,5 @@ int main(int argc, char **argv) {
         return 0;
     }
 
-    if (byte_count > UINT64_C(1048576)) {
-        fprintf(stderr, "refusing to print more than 1048576 bytes\n");
-        return 2;
-    }
-    while (byte_count != 0) {
-        unsigned char buffer[256];
-        const size_t chunk = byte_count > sizeof(buffer)
-            ? sizeof(buffer)
-            : (size_t)byte_count;
-        size_t index;
-        crng_status status = crng_secure_bytes(buffer, chunk);
-        if (status != CRNG_OK) {
-            fprintf(stderr, "secure random source failed: %s\n", crng_status_string(status));
-            return 1;
-        }
-        for (index = 0; index < chunk; ++index) {
-            printf("%02x", (unsigned int)buffer[index]);
-        }
-        byte_count -= chunk;
-    }
-    putchar('\n');
-    return 0;
+    return crng_crypto_emit_tokens(format, byte_count, token_count);
 }
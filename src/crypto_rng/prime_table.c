@@ -0,0 +1,362 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#  define _DEFAULT_SOURCE
+#endif
+#if defined(_MSC_VER) && !defined(_CRT_SECURE_NO_WARNINGS)
+#  define _CRT_SECURE_NO_WARNINGS /* fopen is used portably here. */
+#endif
+
+#include "classical_rng/crypto_rng.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#  define CRNG_PRIME_TABLE_USE_MMAP 1
+#endif
+
+/* File layout: magic, little-endian limit and byte count, then the bitmap. */
+#define CRNG_PRIME_TABLE_HEADER_BYTES 24U
+/* Bitmap bytes sieved per pass, sized to stay in a level-one data cache. */
+#define CRNG_PRIME_TABLE_SEGMENT_BYTES 32768U
+
+static const unsigned char crng_prime_table_magic[8] = {
+    'C', 'R', 'N', 'G', 'P', 'R', 'M', 1
+};
+
+/* The eight residues modulo 30 that are coprime to 30, one per bit. */
+static const unsigned char crng_wheel_residues[8] = {1, 7, 11, 13, 17, 19, 23, 29};
+
+/* Bit for each residue modulo 30, or zero when it shares a factor with 30. */
+static const unsigned char crng_wheel_masks[30] = {
+    0, 0x01, 0, 0, 0, 0, 0, 0x02, 0, 0,
+    0, 0x04, 0, 0x08, 0, 0, 0, 0x10, 0, 0x20,
+    0, 0, 0, 0x40, 0, 0, 0, 0, 0, 0x80
+};
+
+static void crng_store_le64(unsigned char *bytes, uint64_t value) {
+    unsigned int index;
+
+    for (index = 0; index < 8U; ++index) {
+        bytes[index] = (unsigned char)(value >> (8U * index));
+    }
+}
+
+static uint64_t crng_load_le64(const unsigned char *bytes) {
+    uint64_t value = 0;
+    unsigned int index;
+
+    for (index = 0; index < 8U; ++index) {
+        value |= (uint64_t)bytes[index] << (8U * index);
+    }
+    return value;
+}
+
+static size_t crng_prime_table_bytes(uint64_t limit) {
+    return (size_t)((limit + UINT64_C(29)) / UINT64_C(30));
+}
+
+/* Validate a header against the bytes that follow it. */
+static int crng_prime_table_header_valid(
+    const unsigned char *header,
+    size_t file_size,
+    uint64_t *limit
+) {
+    uint64_t byte_count;
+
+    if (file_size < CRNG_PRIME_TABLE_HEADER_BYTES ||
+        memcmp(header, crng_prime_table_magic, sizeof(crng_prime_table_magic)) != 0) {
+        return 0;
+    }
+    *limit = crng_load_le64(header + 8);
+    byte_count = crng_load_le64(header + 16);
+    return *limit != 0 && *limit <= CRNG_PRIME_TABLE_MAX_LIMIT &&
+           byte_count == (uint64_t)crng_prime_table_bytes(*limit) &&
+           byte_count == (uint64_t)(file_size - CRNG_PRIME_TABLE_HEADER_BYTES);
+}
+
+/*
+ * Clear composites from a wheel bitmap. For a sieving prime p and a
+ * multiplier m coprime to 30, p * m and p * (m + 30) share a bit position
+ * and lie exactly p bytes apart. Each prime is therefore eight byte-strided
+ * progressions, walked one cache-sized segment at a time.
+ */
+static crng_status crng_prime_table_sieve(unsigned char *bits, size_t size, uint64_t limit) {
+    uint32_t root = 1;
+    unsigned char *small;
+    uint64_t *next;
+    unsigned char *masks;
+    uint32_t *primes;
+    size_t prime_count = 0;
+    size_t segment;
+    size_t index;
+    uint32_t value;
+
+    while ((uint64_t)(root + 1U) * (root + 1U) < limit) {
+        ++root;
+    }
+    small = (unsigned char *)calloc((size_t)root + 1U, 1U);
+    primes = (uint32_t *)malloc(((size_t)root / 2U + 1U) * sizeof(*primes));
+    next = (uint64_t *)malloc(((size_t)root / 2U + 1U) * 8U * sizeof(*next));
+    masks = (unsigned char *)malloc(((size_t)root / 2U + 1U) * 8U);
+    if (small == NULL || primes == NULL || next == NULL || masks == NULL) {
+        free(small);
+        free(primes);
+        free(next);
+        free(masks);
+        return CRNG_ERR_NO_MEMORY;
+    }
+
+    /* Primes 7..root; 2, 3, and 5 are the wheel itself. */
+    for (value = 2; value <= root; ++value) {
+        uint32_t multiple;
+
+        if (small[value] != 0) {
+            continue;
+        }
+        for (multiple = value * value; multiple <= root; multiple += value) {
+            small[multiple] = 1;
+        }
+        if (value < 7U) {
+            continue;
+        }
+        for (index = 0; index < 8U; ++index) {
+            /* Start at p * m with m >= p, so p itself stays marked prime. */
+            const uint32_t residue = crng_wheel_residues[index];
+            const uint32_t shift = (residue + 30U - value % 30U) % 30U;
+            const uint64_t product = (uint64_t)value * (value + shift);
+
+            next[prime_count * 8U + index] = product / 30U;
+            masks[prime_count * 8U + index] =
+                (unsigned char)~crng_wheel_masks[product % 30U];
+        }
+        primes[prime_count++] = value;
+    }
+
+    memset(bits, 0xff, size);
+    bits[0] &= (unsigned char)~crng_wheel_masks[1]; /* One is not prime. */
+    for (segment = 0; segment < size; segment += CRNG_PRIME_TABLE_SEGMENT_BYTES) {
+        const uint64_t end = size - segment < CRNG_PRIME_TABLE_SEGMENT_BYTES
+            ? (uint64_t)size
+            : (uint64_t)(segment + CRNG_PRIME_TABLE_SEGMENT_BYTES);
+
+        for (index = 0; index < prime_count * 8U; ++index) {
+            const uint64_t stride = primes[index / 8U];
+            const unsigned char mask = masks[index];
+            uint64_t position = next[index];
+
+            for (; position < end; position += stride) {
+                bits[position] &= mask;
+            }
+            next[index] = position;
+        }
+    }
+
+    /* Clear the bits of the last byte that lie at or beyond the limit. */
+    for (index = 0; index < 8U; ++index) {
+        if (30U * (uint64_t)(size - 1U) + crng_wheel_residues[index] >= limit) {
+            bits[size - 1U] &= (unsigned char)~(1U << index);
+        }
+    }
+
+    free(small);
+    free(primes);
+    free(next);
+    free(masks);
+    return CRNG_OK;
+}
+
+crng_status crng_prime_table_build(crng_prime_table *table, uint64_t limit) {
+    unsigned char *storage;
+    size_t size;
+    crng_status status;
+
+    if (table == NULL) {
+        return CRNG_ERR_NULL;
+    }
+    memset(table, 0, sizeof(*table));
+    if (limit == 0 || limit > CRNG_PRIME_TABLE_MAX_LIMIT) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+
+    size = crng_prime_table_bytes(limit);
+    storage = (unsigned char *)malloc(size);
+    if (storage == NULL) {
+        return CRNG_ERR_NO_MEMORY;
+    }
+    status = crng_prime_table_sieve(storage, size, limit);
+    if (status != CRNG_OK) {
+        free(storage);
+        return status;
+    }
+
+    table->bits = storage;
+    table->limit = limit;
+    table->storage = storage;
+    table->storage_size = size;
+    table->mapped = 0;
+    return CRNG_OK;
+}
+
+crng_status crng_prime_table_save(const crng_prime_table *table, const char *path) {
+    unsigned char header[CRNG_PRIME_TABLE_HEADER_BYTES];
+    const size_t size = table != NULL ? crng_prime_table_bytes(table->limit) : 0;
+    FILE *file;
+    int failed;
+
+    if (table == NULL || table->bits == NULL || path == NULL) {
+        return CRNG_ERR_NULL;
+    }
+
+    memcpy(header, crng_prime_table_magic, sizeof(crng_prime_table_magic));
+    crng_store_le64(header + 8, table->limit);
+    crng_store_le64(header + 16, (uint64_t)size);
+
+    file = fopen(path, "wb");
+    if (file == NULL) {
+        return CRNG_ERR_IO;
+    }
+    failed = fwrite(header, 1U, sizeof(header), file) != sizeof(header) ||
+             fwrite(table->bits, 1U, size, file) != size;
+    failed |= fclose(file) != 0;
+    return failed ? CRNG_ERR_IO : CRNG_OK;
+}
+
+#if defined(CRNG_PRIME_TABLE_USE_MMAP)
+crng_status crng_prime_table_map(crng_prime_table *table, const char *path) {
+    struct stat info;
+    void *mapping;
+    size_t size;
+    uint64_t limit;
+    int descriptor;
+    int flags = O_RDONLY;
+
+    if (table == NULL || path == NULL) {
+        if (table != NULL) {
+            memset(table, 0, sizeof(*table));
+        }
+        return CRNG_ERR_NULL;
+    }
+    memset(table, 0, sizeof(*table));
+
+#  if defined(O_CLOEXEC)
+    flags |= O_CLOEXEC;
+#  endif
+    descriptor = open(path, flags);
+    if (descriptor < 0) {
+        return CRNG_ERR_IO;
+    }
+    if (fstat(descriptor, &info) != 0) {
+        close(descriptor);
+        return CRNG_ERR_IO;
+    }
+    if (info.st_size < (off_t)CRNG_PRIME_TABLE_HEADER_BYTES ||
+        (uint64_t)info.st_size > (uint64_t)SIZE_MAX) {
+        close(descriptor);
+        return CRNG_ERR_FORMAT;
+    }
+    size = (size_t)info.st_size;
+    mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, descriptor, 0);
+    close(descriptor);
+    if (mapping == MAP_FAILED) {
+        return CRNG_ERR_IO;
+    }
+    if (!crng_prime_table_header_valid((const unsigned char *)mapping, size, &limit)) {
+        munmap(mapping, size);
+        return CRNG_ERR_FORMAT;
+    }
+
+    table->bits = (const unsigned char *)mapping + CRNG_PRIME_TABLE_HEADER_BYTES;
+    table->limit = limit;
+    table->storage = mapping;
+    table->storage_size = size;
+    table->mapped = 1;
+    return CRNG_OK;
+}
+#else
+/* Without mmap, read the file into one heap block. */
+crng_status crng_prime_table_map(crng_prime_table *table, const char *path) {
+    unsigned char *storage;
+    uint64_t limit;
+    long length;
+    size_t size;
+    FILE *file;
+
+    if (table == NULL || path == NULL) {
+        if (table != NULL) {
+            memset(table, 0, sizeof(*table));
+        }
+        return CRNG_ERR_NULL;
+    }
+    memset(table, 0, sizeof(*table));
+
+    file = fopen(path, "rb");
+    if (file == NULL) {
+        return CRNG_ERR_IO;
+    }
+    if (fseek(file, 0, SEEK_END) != 0 || (length = ftell(file)) < 0 ||
+        fseek(file, 0, SEEK_SET) != 0) {
+        fclose(file);
+        return CRNG_ERR_IO;
+    }
+    if ((unsigned long)length < CRNG_PRIME_TABLE_HEADER_BYTES) {
+        fclose(file);
+        return CRNG_ERR_FORMAT;
+    }
+    size = (size_t)length;
+    storage = (unsigned char *)malloc(size);
+    if (storage == NULL) {
+        fclose(file);
+        return CRNG_ERR_NO_MEMORY;
+    }
+    if (fread(storage, 1U, size, file) != size) {
+        free(storage);
+        fclose(file);
+        return CRNG_ERR_IO;
+    }
+    fclose(file);
+    if (!crng_prime_table_header_valid(storage, size, &limit)) {
+        free(storage);
+        return CRNG_ERR_FORMAT;
+    }
+
+    table->bits = storage + CRNG_PRIME_TABLE_HEADER_BYTES;
+    table->limit = limit;
+    table->storage = storage;
+    table->storage_size = size;
+    table->mapped = 0;
+    return CRNG_OK;
+}
+#endif
+
+void crng_prime_table_free(crng_prime_table *table) {
+    if (table == NULL) {
+        return;
+    }
+#if defined(CRNG_PRIME_TABLE_USE_MMAP)
+    if (table->mapped != 0) {
+        munmap(table->storage, table->storage_size);
+    } else {
+        free(table->storage);
+    }
+#else
+    free(table->storage);
+#endif
+    memset(table, 0, sizeof(*table));
+}
+
+bool crng_prime_table_is_prime(const crng_prime_table *table, uint64_t value) {
+    if (table != NULL && value < table->limit) {
+        const unsigned char mask = crng_wheel_masks[value % 30U];
+
+        if (mask == 0) {
+            return value == 2U || value == 3U || value == 5U;
+        }
+        return (table->bits[value / 30U] & mask) != 0;
+    }
+    return crng_crypto_is_prime_u64(value);
+}
@@ -0,0 +1,321 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#  define _DEFAULT_SOURCE
+#endif
+
+#include "classical_rng/crypto_rng.h"
+#include "../common/probes.h"
+#include "../common/secure_zero.h"
+#include "../common/stats.h"
+#include "chacha20.h"
+
+#include <string.h>
+#include <time.h>
+
+#if !defined(_WIN32)
+#  include <sys/types.h>
+#  include <unistd.h>
+#  if defined(__linux__)
+#    include <sys/mman.h>
+#    if defined(MADV_WIPEONFORK) && !defined(__STDC_NO_ATOMICS__)
+#      include <stdatomic.h>
+#      define CRNG_POOL_USE_WIPEONFORK 1
+#    endif
+#  endif
+#endif
+
+#define CRNG_POOL_KEY_BYTES 32U
+
+/* Every refill uses a fresh key, so the nonce stays zero. */
+static const uint32_t crng_pool_nonce[3] = {0, 0, 0};
+
+#if defined(CRNG_POOL_USE_WIPEONFORK)
+/*
+ * One anonymous page marked MADV_WIPEONFORK. The kernel hands a forked child
+ * a zeroed copy, so a cleared flag means this process has not yet observed
+ * its own fork and must advance the generation that pools compare against.
+ */
+static atomic_uintptr_t crng_pool_fork_page;
+static atomic_int crng_pool_fork_page_failed;
+static atomic_uint_fast64_t crng_pool_fork_generation;
+
+static atomic_uint *crng_pool_fork_flag(void) {
+    uintptr_t page = atomic_load_explicit(&crng_pool_fork_page, memory_order_acquire);
+    uintptr_t expected = 0;
+    long page_size;
+    void *mapping;
+
+    if (page != 0) {
+        return (atomic_uint *)page;
+    }
+    if (atomic_load_explicit(&crng_pool_fork_page_failed, memory_order_relaxed) != 0) {
+        return NULL;
+    }
+
+    page_size = sysconf(_SC_PAGESIZE);
+    if (page_size <= 0) {
+        atomic_store_explicit(&crng_pool_fork_page_failed, 1, memory_order_relaxed);
+        return NULL;
+    }
+    mapping = mmap(NULL, (size_t)page_size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        atomic_store_explicit(&crng_pool_fork_page_failed, 1, memory_order_relaxed);
+        return NULL;
+    }
+    if (madvise(mapping, (size_t)page_size, MADV_WIPEONFORK) != 0) {
+        (void)munmap(mapping, (size_t)page_size);
+        atomic_store_explicit(&crng_pool_fork_page_failed, 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    atomic_store_explicit((atomic_uint *)mapping, 1U, memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(
+            &crng_pool_fork_page,
+            &expected,
+            (uintptr_t)mapping,
+            memory_order_acq_rel,
+            memory_order_acquire)) {
+        (void)munmap(mapping, (size_t)page_size);
+        return (atomic_uint *)expected;
+    }
+    return (atomic_uint *)mapping;
+}
+#endif
+
+/* Changes whenever the calling process is not the one that keyed a pool. */
+static uint64_t crng_pool_fork_token(void) {
+#if defined(_WIN32)
+    return 0;
+#else
+#  if defined(CRNG_POOL_USE_WIPEONFORK)
+    atomic_uint *flag = crng_pool_fork_flag();
+
+    if (flag != NULL) {
+        if (atomic_load_explicit(flag, memory_order_acquire) == 0U) {
+            (void)atomic_fetch_add_explicit(
+                &crng_pool_fork_generation,
+                1U,
+                memory_order_relaxed
+            );
+            atomic_store_explicit(flag, 1U, memory_order_release);
+        }
+        return (uint64_t)atomic_load_explicit(
+            &crng_pool_fork_generation,
+            memory_order_relaxed
+        );
+    }
+#  endif
+    /* The process-id fallback is tagged so it never equals a generation. */
+    return (UINT64_C(1) << 63) | (uint64_t)getpid();
+#endif
+}
+
+static int crng_pool_reseed_due(const crng_secure_pool *pool) {
+    const time_t now = time(NULL);
+
+    if (pool->output_since_reseed >= CRNG_SECURE_POOL_RESEED_BYTES) {
+        return 1;
+    }
+    if (now == (time_t)-1) {
+        return 0;
+    }
+    return (int64_t)now < pool->reseed_time
+           || (int64_t)now - pool->reseed_time >= CRNG_SECURE_POOL_RESEED_SECONDS;
+}
+
+static void crng_pool_refill(crng_secure_pool *pool) {
+    size_t block;
+    size_t index;
+
+#if defined(CRNG_CHACHA20_LANES)
+    for (block = 0; block < CRNG_SECURE_POOL_BUFFER_BYTES / CRNG_CHACHA20_BLOCK_BYTES;
+         block += CRNG_CHACHA20_LANES) {
+        crng_chacha20_blocks4(
+            pool->key,
+            (uint32_t)block,
+            crng_pool_nonce,
+            pool->buffer + block * CRNG_CHACHA20_BLOCK_BYTES
+        );
+    }
+#else
+    for (block = 0; block < CRNG_SECURE_POOL_BUFFER_BYTES / CRNG_CHACHA20_BLOCK_BYTES; ++block) {
+        crng_chacha20_block(
+            pool->key,
+            (uint32_t)block,
+            crng_pool_nonce,
+            pool->buffer + block * CRNG_CHACHA20_BLOCK_BYTES
+        );
+    }
+#endif
+
+    /* Fast key erasure: the first 32 keystream bytes become the next key. */
+    for (index = 0; index < 8; ++index) {
+        pool->key[index] = crng_chacha20_load_le32(pool->buffer + index * 4U);
+    }
+    crng_secure_zero(pool->buffer, CRNG_POOL_KEY_BYTES);
+    pool->position = CRNG_POOL_KEY_BYTES;
+}
+
+static crng_status crng_pool_reseed(crng_secure_pool *pool, uint64_t fork_token) {
+    unsigned char seed[CRNG_POOL_KEY_BYTES];
+    crng_status status;
+    size_t index;
+
+    status = crng_secure_bytes(seed, sizeof(seed));
+    if (status != CRNG_OK) {
+        crng_secure_zero(seed, sizeof(seed));
+        crng_secure_pool_wipe(pool);
+        return status;
+    }
+
+    /* Mixing keeps prior key material; a wiped pool starts from zero. */
+    for (index = 0; index < 8; ++index) {
+        pool->key[index] ^= crng_chacha20_load_le32(seed + index * 4U);
+    }
+    crng_secure_zero(seed, sizeof(seed));
+    crng_pool_refill(pool);
+    CRNG_SECURE_STAT_ADD(pool_reseeds, 1U);
+    CRNG_PROBE1(pool_reseed, pool);
+
+    pool->output_since_reseed = 0;
+    pool->reseed_time = (int64_t)time(NULL);
+    pool->fork_token = fork_token;
+    pool->seeded = 1;
+    return CRNG_OK;
+}
+
+static crng_status crng_pool_prepare(crng_secure_pool *pool) {
+    const uint64_t fork_token = crng_pool_fork_token();
+
+    if (pool->seeded == 0 || pool->fork_token != fork_token) {
+        return crng_pool_reseed(pool, fork_token);
+    }
+    return CRNG_OK;
+}
+
+crng_status crng_secure_pool_init(crng_secure_pool *pool) {
+    if (pool == NULL) {
+        return CRNG_ERR_NULL;
+    }
+    crng_secure_pool_wipe(pool);
+    return crng_pool_reseed(pool, crng_pool_fork_token());
+}
+
+void crng_secure_pool_wipe(crng_secure_pool *pool) {
+    if (pool == NULL) {
+        return;
+    }
+    crng_secure_zero(pool, sizeof(*pool));
+}
+
+crng_status crng_secure_pool_bytes(crng_secure_pool *pool, void *buffer, size_t size) {
+    unsigned char *bytes = (unsigned char *)buffer;
+    crng_status status;
+
+    if (pool == NULL || (buffer == NULL && size != 0)) {
+        return CRNG_ERR_NULL;
+    }
+    if (size == 0) {
+        return CRNG_OK;
+    }
+
+    status = crng_pool_prepare(pool);
+    if (status != CRNG_OK) {
+        return status;
+    }
+
+    while (size != 0) {
+        size_t chunk;
+
+        if (pool->position >= CRNG_SECURE_POOL_BUFFER_BYTES) {
+            if (crng_pool_reseed_due(pool)) {
+                status = crng_pool_reseed(pool, pool->fork_token);
+                if (status != CRNG_OK) {
+                    return status;
+                }
+            } else {
+                crng_pool_refill(pool);
+            }
+        }
+
+        chunk = CRNG_SECURE_POOL_BUFFER_BYTES - pool->position;
+        if (chunk > size) {
+            chunk = size;
+        }
+        memcpy(bytes, pool->buffer + pool->position, chunk);
+        memset(pool->buffer + pool->position, 0, chunk);
+        pool->position += chunk;
+        pool->output_since_reseed += chunk;
+        bytes += chunk;
+        size -= chunk;
+        CRNG_SECURE_STAT_ADD(pool_bytes, chunk);
+    }
+    return CRNG_OK;
+}
+
+crng_status crng_secure_pool_u64(crng_secure_pool *pool, uint64_t *out) {
+    if (out == NULL) {
+        return CRNG_ERR_NULL;
+    }
+    return crng_secure_pool_bytes(pool, out, sizeof(*out));
+}
+
+crng_status crng_secure_pool_uniform_u64(
+    crng_secure_pool *pool,
+    uint64_t upper_bound,
+    uint64_t *out
+) {
+    uint64_t value;
+    uint64_t threshold;
+    crng_status status;
+
+    if (pool == NULL || out == NULL) {
+        return CRNG_ERR_NULL;
+    }
+    if (upper_bound == 0) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+
+    threshold = (UINT64_C(0) - upper_bound) % upper_bound;
+    do {
+        status = crng_secure_pool_u64(pool, &value);
+        if (status != CRNG_OK) {
+            return status;
+        }
+        if (value < threshold) {
+            CRNG_SECURE_STAT_ADD(pool_uniform_rejections, 1U);
+            CRNG_PROBE2(pool_uniform_reject, pool, upper_bound);
+        }
+    } while (value < threshold);
+
+    CRNG_SECURE_STAT_ADD(pool_uniform_results, 1U);
+    *out = value % upper_bound;
+    return CRNG_OK;
+}
+
+crng_status crng_secure_pool_range_i32(
+    crng_secure_pool *pool,
+    int32_t minimum,
+    int32_t maximum,
+    int32_t *out
+) {
+    uint64_t offset;
+    uint64_t span;
+    crng_status status;
+
+    if (pool == NULL || out == NULL) {
+        return CRNG_ERR_NULL;
+    }
+    if (minimum > maximum) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+
+    span = (uint64_t)((int64_t)maximum - (int64_t)minimum) + UINT64_C(1);
+    status = crng_secure_pool_uniform_u64(pool, span, &offset);
+    if (status != CRNG_OK) {
+        return status;
+    }
+
+    *out = (int32_t)((int64_t)minimum + (int64_t)offset);
+    return CRNG_OK;
+}
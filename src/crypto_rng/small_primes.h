@@ -0,0 +1,281 @@
+#ifndef CLASSICAL_RNG_INTERNAL_SMALL_PRIMES_H
+#define CLASSICAL_RNG_INTERNAL_SMALL_PRIMES_H
+
+#include <stdint.h>
+
+/*
+ * The first 256 odd primes with their inverses modulo 2^64 and divisibility
+ * limits. For odd p, p divides n exactly when n * inverse (mod 2^64) is at
+ * most limit = floor((2^64 - 1) / p), so trial division needs one multiply
+ * and no hardware divide. Regenerate with:
+ *
+ *   inverse = pow(p, -1, 2**64); limit = (2**64 - 1) // p
+ */
+#define CRNG_SMALL_PRIME_COUNT 256
+
+typedef struct crng_small_prime {
+    uint64_t inverse;
+    uint64_t limit;
+    uint32_t prime;
+} crng_small_prime;
+
+static const crng_small_prime crng_small_primes[CRNG_SMALL_PRIME_COUNT] = {
+    { UINT64_C(0xaaaaaaaaaaaaaaab), UINT64_C(0x5555555555555555), 3U },
+    { UINT64_C(0xcccccccccccccccd), UINT64_C(0x3333333333333333), 5U },
+    { UINT64_C(0x6db6db6db6db6db7), UINT64_C(0x2492492492492492), 7U },
+    { UINT64_C(0x2e8ba2e8ba2e8ba3), UINT64_C(0x1745d1745d1745d1), 11U },
+    { UINT64_C(0x4ec4ec4ec4ec4ec5), UINT64_C(0x13b13b13b13b13b1), 13U },
+    { UINT64_C(0xf0f0f0f0f0f0f0f1), UINT64_C(0x0f0f0f0f0f0f0f0f), 17U },
+    { UINT64_C(0x86bca1af286bca1b), UINT64_C(0x0d79435e50d79435), 19U },
+    { UINT64_C(0xd37a6f4de9bd37a7), UINT64_C(0x0b21642c8590b216), 23U },
+    { UINT64_C(0x34f72c234f72c235), UINT64_C(0x08d3dcb08d3dcb08), 29U },
+    { UINT64_C(0xef7bdef7bdef7bdf), UINT64_C(0x0842108421084210), 31U },
+    { UINT64_C(0x14c1bacf914c1bad), UINT64_C(0x06eb3e45306eb3e4), 37U },
+    { UINT64_C(0x8f9c18f9c18f9c19), UINT64_C(0x063e7063e7063e70), 41U },
+    { UINT64_C(0x82fa0be82fa0be83), UINT64_C(0x05f417d05f417d05), 43U },
+    { UINT64_C(0x51b3bea3677d46cf), UINT64_C(0x0572620ae4c415c9), 47U },
+    { UINT64_C(0x21cfb2b78c13521d), UINT64_C(0x04d4873ecade304d), 53U },
+    { UINT64_C(0xcbeea4e1a08ad8f3), UINT64_C(0x0456c797dd49c341), 59U },
+    { UINT64_C(0x4fbcda3ac10c9715), UINT64_C(0x04325c53ef368eb0), 61U },
+    { UINT64_C(0xf0b7672a07a44c6b), UINT64_C(0x03d226357e16ece5), 67U },
+    { UINT64_C(0x193d4bb7e327a977), UINT64_C(0x039b0ad12073615a), 71U },
+    { UINT64_C(0x7e3f1f8fc7e3f1f9), UINT64_C(0x0381c0e070381c0e), 73U },
+    { UINT64_C(0x9b8b577e613716af), UINT64_C(0x033d91d2a2067b23), 79U },
+    { UINT64_C(0xa3784a062b2e43db), UINT64_C(0x03159721ed7e7534), 83U },
+    { UINT64_C(0xf47e8fd1fa3f47e9), UINT64_C(0x02e05c0b81702e05), 89U },
+    { UINT64_C(0xa3a0fd5c5f02a3a1), UINT64_C(0x02a3a0fd5c5f02a3), 97U },
+    { UINT64_C(0x3a4c0a237c32b16d), UINT64_C(0x0288df0cac5b3f5d), 101U },
+    { UINT64_C(0xdab7ec1dd3431b57), UINT64_C(0x027c45979c95204f), 103U },
+    { UINT64_C(0x77a04c8f8d28ac43), UINT64_C(0x02647c69456217ec), 107U },
+    { UINT64_C(0xa6c0964fda6c0965), UINT64_C(0x02593f69b02593f6), 109U },
+    { UINT64_C(0x90fdbc090fdbc091), UINT64_C(0x0243f6f0243f6f02), 113U },
+    { UINT64_C(0x7efdfbf7efdfbf7f), UINT64_C(0x0204081020408102), 127U },
+    { UINT64_C(0x03e88cb3c9484e2b), UINT64_C(0x01f44659e4a42715), 131U },
+    { UINT64_C(0xe21a291c077975b9), UINT64_C(0x01de5d6e3f8868a4), 137U },
+    { UINT64_C(0x3aef6ca970586723), UINT64_C(0x01d77b654b82c339), 139U },
+    { UINT64_C(0xdf5b0f768ce2cabd), UINT64_C(0x01b7d6c3dda338b2), 149U },
+    { UINT64_C(0x6fe4dfc9bf937f27), UINT64_C(0x01b2036406c80d90), 151U },
+    { UINT64_C(0x5b4fe5e92c0685b5), UINT64_C(0x01a16d3f97a4b01a), 157U },
+    { UINT64_C(0x1f693a1c451ab30b), UINT64_C(0x01920fb49d0e228d), 163U },
+    { UINT64_C(0x8d07aa27db35a717), UINT64_C(0x01886e5f0abb0499), 167U },
+    { UINT64_C(0x882383b30d516325), UINT64_C(0x017ad2208e0ecc35), 173U },
+    { UINT64_C(0xed6866f8d962ae7b), UINT64_C(0x016e1f76b4337c6c), 179U },
+    { UINT64_C(0x3454dca410f8ed9d), UINT64_C(0x016a13cd15372904), 181U },
+    { UINT64_C(0x1d7ca632ee936f3f), UINT64_C(0x01571ed3c506b39a), 191U },
+    { UINT64_C(0x70bf015390948f41), UINT64_C(0x015390948f40feac), 193U },
+    { UINT64_C(0xc96bdb9d3d137e0d), UINT64_C(0x014cab88725af6e7), 197U },
+    { UINT64_C(0x2697cc8aef46c0f7), UINT64_C(0x0149539e3b2d066e), 199U },
+    { UINT64_C(0xc0e8f2a76e68575b), UINT64_C(0x013698df3de07479), 211U },
+    { UINT64_C(0x687763dfdb43bb1f), UINT64_C(0x0125e22708092f11), 223U },
+    { UINT64_C(0x1b10ea929ba144cb), UINT64_C(0x0120b470c67c0d88), 227U },
+    { UINT64_C(0x1d10c4c0478bbced), UINT64_C(0x011e2ef3b3fb8744), 229U },
+    { UINT64_C(0x63fb9aeb1fdcd759), UINT64_C(0x0119453808ca29c0), 233U },
+    { UINT64_C(0x64afaa4f437b2e0f), UINT64_C(0x0112358e75d30336), 239U },
+    { UINT64_C(0xf010fef010fef011), UINT64_C(0x010fef010fef010f), 241U },
+    { UINT64_C(0x28cbfbeb9a020a33), UINT64_C(0x0105197f7d734041), 251U },
+    { UINT64_C(0xff00ff00ff00ff01), UINT64_C(0x00ff00ff00ff00ff), 257U },
+    { UINT64_C(0xd624fd1470e99cb7), UINT64_C(0x00f92fb2211855a8), 263U },
+    { UINT64_C(0x8fb3ddbd6205b5c5), UINT64_C(0x00f3a0d52cba8723), 269U },
+    { UINT64_C(0xd57da36ca27acdef), UINT64_C(0x00f1d48bcee0d399), 271U },
+    { UINT64_C(0xee70c03b25e4463d), UINT64_C(0x00ec979118f3fc4d), 277U },
+    { UINT64_C(0xc5b1a6b80749cb29), UINT64_C(0x00e939651fe2d8d3), 281U },
+    { UINT64_C(0x47768073c9b97113), UINT64_C(0x00e79372e225fe30), 283U },
+    { UINT64_C(0x2591e94884ce32ad), UINT64_C(0x00dfac1f74346c57), 293U },
+    { UINT64_C(0xf02806abc74be1fb), UINT64_C(0x00d578e97c3f5fe5), 307U },
+    { UINT64_C(0x7ec3e8f3a7198487), UINT64_C(0x00d2ba083b445250), 311U },
+    { UINT64_C(0x58550f8a39409d09), UINT64_C(0x00d161543e28e502), 313U },
+    { UINT64_C(0xec9e48ae6f71de15), UINT64_C(0x00cebcf8bb5b4169), 317U },
+    { UINT64_C(0x2ff3a018bfce8063), UINT64_C(0x00c5fe740317f9d0), 331U },
+    { UINT64_C(0x7f9ec3fcf61fe7b1), UINT64_C(0x00c2780613c0309e), 337U },
+    { UINT64_C(0x89f5abe570e046d3), UINT64_C(0x00bcdd535db1cc5b), 347U },
+    { UINT64_C(0xda971b23f1545af5), UINT64_C(0x00bbc8408cd63069), 349U },
+    { UINT64_C(0x79d5f00b9a7862a1), UINT64_C(0x00b9a7862a0ff465), 353U },
+    { UINT64_C(0x4dba1df32a128a57), UINT64_C(0x00b68d31340e4307), 359U },
+    { UINT64_C(0x87530217b7747d8f), UINT64_C(0x00b2927c29da5519), 367U },
+    { UINT64_C(0x30baae53bb5e06dd), UINT64_C(0x00afb321a1496fdf), 373U },
+    { UINT64_C(0xee70206c12e9b5b3), UINT64_C(0x00aceb0f891e6551), 379U },
+    { UINT64_C(0xcdde9462ec9dbe7f), UINT64_C(0x00ab1cbdd3e2970f), 383U },
+    { UINT64_C(0xafb64b05ec41cf4d), UINT64_C(0x00a87917088e262b), 389U },
+    { UINT64_C(0x02944ff5aec02945), UINT64_C(0x00a513fd6bb00a51), 397U },
+    { UINT64_C(0x2cb033128382df71), UINT64_C(0x00a36e71a2cb0331), 401U },
+    { UINT64_C(0x1ccacc0c84b1c2a9), UINT64_C(0x00a03c1688732b30), 409U },
+    { UINT64_C(0x19a93db575eb3a0b), UINT64_C(0x009c69169b30446d), 419U },
+    { UINT64_C(0xcebeef94fa86fe2d), UINT64_C(0x009baade8e4a2f6e), 421U },
+    { UINT64_C(0x6faa77fb3f8df54f), UINT64_C(0x00980e4156201301), 431U },
+    { UINT64_C(0x68a58af00975a751), UINT64_C(0x00975a750ff68a58), 433U },
+    { UINT64_C(0xd56e36d0c3efac07), UINT64_C(0x009548e4979e0829), 439U },
+    { UINT64_C(0xd8b44c47a8299b73), UINT64_C(0x0093efd1c50e726b), 443U },
+    { UINT64_C(0x02d9ccaf9ba70e41), UINT64_C(0x0091f5bcb8bb02d9), 449U },
+    { UINT64_C(0x0985e1c023d9e879), UINT64_C(0x008f67a1e3fdc261), 457U },
+    { UINT64_C(0x2a343316c494d305), UINT64_C(0x008e2917e0e702c6), 461U },
+    { UINT64_C(0x70cb7916ab67652f), UINT64_C(0x008d8be33f95d715), 463U },
+    { UINT64_C(0xd398f132fb10fe5b), UINT64_C(0x008c55841c815ed5), 467U },
+    { UINT64_C(0x6f2a38a6bf54fa1f), UINT64_C(0x0088d180cd3a4133), 479U },
+    { UINT64_C(0x211df689b98f81d7), UINT64_C(0x00869222b1acf1ce), 487U },
+    { UINT64_C(0x0e994983e90f1ec3), UINT64_C(0x0085797b917765ab), 491U },
+    { UINT64_C(0xad671e44bed87f3b), UINT64_C(0x008355ace3c897db), 499U },
+    { UINT64_C(0xf9623a0516e70fc7), UINT64_C(0x00824a4e60b3262b), 503U },
+    { UINT64_C(0x4b7129be9dece355), UINT64_C(0x0080c121b28bd1ba), 509U },
+    { UINT64_C(0x190f3b7473f62c39), UINT64_C(0x007dc9f3397d4c29), 521U },
+    { UINT64_C(0x63dacc9aad46f9a3), UINT64_C(0x007d4ece8fe88139), 523U },
+    { UINT64_C(0xc1108fda24e8d035), UINT64_C(0x0079237d65bcce50), 541U },
+    { UINT64_C(0xb77578472319bd8b), UINT64_C(0x0077cf53c5f7936c), 547U },
+    { UINT64_C(0x473d20a1c7ed9da5), UINT64_C(0x0075a8accfbdd11e), 557U },
+    { UINT64_C(0xfbe85af0fea2c8fb), UINT64_C(0x007467ac557c228e), 563U },
+    { UINT64_C(0x58a1f7e6ce0f4c09), UINT64_C(0x00732d70ed8db8e9), 569U },
+    { UINT64_C(0x1a00e58c544986f3), UINT64_C(0x0072c62a24c3797f), 571U },
+    { UINT64_C(0x7194a17f55a10dc1), UINT64_C(0x007194a17f55a10d), 577U },
+    { UINT64_C(0x7084944785e33763), UINT64_C(0x006fa549b41da7e7), 587U },
+    { UINT64_C(0xba10679bd84886b1), UINT64_C(0x006e8419e6f61221), 593U },
+    { UINT64_C(0xebe9c6bb31260967), UINT64_C(0x006d68b5356c207b), 599U },
+    { UINT64_C(0x97a3fe4bd1ff25e9), UINT64_C(0x006d0b803685c01b), 601U },
+    { UINT64_C(0x6c6388395b84d99f), UINT64_C(0x006bf790a8b2d207), 607U },
+    { UINT64_C(0x8c51da6a1335df6d), UINT64_C(0x006ae907ef4b96c2), 613U },
+    { UINT64_C(0x46f3234475d5add9), UINT64_C(0x006a37991a23aead), 617U },
+    { UINT64_C(0x905605ca3c619a43), UINT64_C(0x0069dfbdd4295b66), 619U },
+    { UINT64_C(0xcee8dff304767747), UINT64_C(0x0067dc4c45c8033e), 631U },
+    { UINT64_C(0xff99c27f00663d81), UINT64_C(0x00663d80ff99c27f), 641U },
+    { UINT64_C(0xacca407f671ddc2b), UINT64_C(0x0065ec17e3559948), 643U },
+    { UINT64_C(0xe71298bac1e12337), UINT64_C(0x00654ac835cfba5c), 647U },
+    { UINT64_C(0xfa1e94309cd09045), UINT64_C(0x00645c854ae10772), 653U },
+    { UINT64_C(0xbebccb8e91496b9b), UINT64_C(0x006372990e5f901f), 659U },
+    { UINT64_C(0x312fa30cc7d7b8bd), UINT64_C(0x006325913c07beef), 661U },
+    { UINT64_C(0x6160ff9e9f006161), UINT64_C(0x006160ff9e9f0061), 673U },
+    { UINT64_C(0x6b03673b5e28152d), UINT64_C(0x0060cdb520e5e88e), 677U },
+    { UINT64_C(0xfe802ffa00bfe803), UINT64_C(0x005ff4017fd005ff), 683U },
+    { UINT64_C(0xe66fe25c9e907c7b), UINT64_C(0x005ed79e31a4dccd), 691U },
+    { UINT64_C(0x3f8b236c76528895), UINT64_C(0x005d7d42d48ac5ef), 701U },
+    { UINT64_C(0xf6f923bf01ce2c0d), UINT64_C(0x005c6f35ccba5028), 709U },
+    { UINT64_C(0x6c3d3d98bed7c42f), UINT64_C(0x005b2618ec6ad0a5), 719U },
+    { UINT64_C(0x30981efcd4b010e7), UINT64_C(0x005a2553748e42e7), 727U },
+    { UINT64_C(0x6f691fc81ebbe575), UINT64_C(0x0059686cf744cd5b), 733U },
+    { UINT64_C(0xb10480ddb47b52cb), UINT64_C(0x0058ae97bab79976), 739U },
+    { UINT64_C(0x74cd59ed64f3f0d7), UINT64_C(0x0058345f1876865f), 743U },
+    { UINT64_C(0x0105cb81316d6c0f), UINT64_C(0x005743d5bb24795a), 751U },
+    { UINT64_C(0x9be64c6d91c1195d), UINT64_C(0x005692c4d1ab74ab), 757U },
+    { UINT64_C(0x71b3f945a27b1f49), UINT64_C(0x00561e46a4d5f337), 761U },
+    { UINT64_C(0x77d80d50e508fd01), UINT64_C(0x005538ed06533997), 769U },
+    { UINT64_C(0xa5eb778e133551cd), UINT64_C(0x0054c807f2c0bec2), 773U },
+    { UINT64_C(0x18657d3c2d8a3f1b), UINT64_C(0x005345efbc572d36), 787U },
+    { UINT64_C(0x2e40e220c34ad735), UINT64_C(0x00523a758f941345), 797U },
+    { UINT64_C(0xa76593c70a714919), UINT64_C(0x005102370f816c89), 809U },
+    { UINT64_C(0x1eef452124eea383), UINT64_C(0x0050cf129fb94acf), 811U },
+    { UINT64_C(0x38206dc242ba771d), UINT64_C(0x004fd31941cafdd1), 821U },
+    { UINT64_C(0x4cd4c35807772287), UINT64_C(0x004fa1704aa75945), 823U },
+    { UINT64_C(0x83de917d5e69ddf3), UINT64_C(0x004f3ed6d45a63ad), 827U },
+    { UINT64_C(0x882ef0403b4a6c15), UINT64_C(0x004f0de57154ebed), 829U },
+    { UINT64_C(0xf8fb6c51c606b677), UINT64_C(0x004e1cae8815f811), 839U },
+    { UINT64_C(0xb4abaac446d3e1fd), UINT64_C(0x004cd47ba5f6ff19), 853U },
+    { UINT64_C(0xa9f83bbe484a14e9), UINT64_C(0x004c78ae734df709), 857U },
+    { UINT64_C(0x0bebbc0d1ce874d3), UINT64_C(0x004c4b19ed85cfb8), 859U },
+    { UINT64_C(0xbd418eaf0473189f), UINT64_C(0x004bf093221d1218), 863U },
+    { UINT64_C(0x44e3af6f372b7e65), UINT64_C(0x004aba3c21dc633f), 877U },
+    { UINT64_C(0xc87fdace4f9e5d91), UINT64_C(0x004a6360c344de00), 881U },
+    { UINT64_C(0xec93479c446bd9bb), UINT64_C(0x004a383e9f74d68a), 883U },
+    { UINT64_C(0xdac4d592e777c647), UINT64_C(0x0049e28fbabb9940), 887U },
+    { UINT64_C(0xa63ea8c8f61f0c23), UINT64_C(0x0048417b57c78cd7), 907U },
+    { UINT64_C(0xe476062ea5cbbb6f), UINT64_C(0x0047f043713f3a2b), 911U },
+    { UINT64_C(0xdf68761c69daac27), UINT64_C(0x00474ff2a10281cf), 919U },
+    { UINT64_C(0xb813d737637aa061), UINT64_C(0x00468b6f9a978f91), 929U },
+    { UINT64_C(0xa3a77aac1fb15099), UINT64_C(0x0045f13f1caff2e2), 937U },
+    { UINT64_C(0x17f0c3e0712c5825), UINT64_C(0x0045a5228cec23e9), 941U },
+    { UINT64_C(0xfd912a70ff30637b), UINT64_C(0x0045342c556c66b9), 947U },
+    { UINT64_C(0xfbb3b5dc01131289), UINT64_C(0x0044c4a23feeced7), 953U },
+    { UINT64_C(0x856d560a0f5acdf7), UINT64_C(0x0043c5c20d3c9fe6), 967U },
+    { UINT64_C(0x96472f314d3f89e3), UINT64_C(0x00437e494b239798), 971U },
+    { UINT64_C(0xa76f5c7ed2253531), UINT64_C(0x0043142d118e47cb), 977U },
+    { UINT64_C(0x816eae7c7bf69fe7), UINT64_C(0x0042ab5c73a13458), 983U },
+    { UINT64_C(0xb6a2bea4cfb1781f), UINT64_C(0x004221950db0f3db), 991U },
+    { UINT64_C(0xa3900c53318e81ed), UINT64_C(0x0041bbb2f80a4553), 997U },
+    { UINT64_C(0x60aa7f5d9f148d11), UINT64_C(0x0040f391612c6680), 1009U },
+    { UINT64_C(0x6be8c0102c7a505d), UINT64_C(0x0040b1e94173fefd), 1013U },
+    { UINT64_C(0x8ff3f0ed28728f33), UINT64_C(0x004050647d9d0445), 1019U },
+    { UINT64_C(0x680e0a87e5ec7155), UINT64_C(0x004030241b144f3b), 1021U },
+    { UINT64_C(0xbbf70fa49fe829b7), UINT64_C(0x003f90c2ab542cb1), 1031U },
+    { UINT64_C(0xd69d1e7b6a50ca39), UINT64_C(0x003f71412d59f597), 1033U },
+    { UINT64_C(0x1a1e0f46b6d26aef), UINT64_C(0x003f137701b98841), 1039U },
+    { UINT64_C(0x7429f9a7a8251829), UINT64_C(0x003e79886b60e278), 1049U },
+    { UINT64_C(0xd9c2219d1b863613), UINT64_C(0x003e5b1916a7181d), 1051U },
+    { UINT64_C(0x91406c1820d077ad), UINT64_C(0x003dc4a50968f524), 1061U },
+    { UINT64_C(0x521f4ec02e3d2b97), UINT64_C(0x003da6e4c9550321), 1063U },
+    { UINT64_C(0xbb8283b63dc8eba5), UINT64_C(0x003d4e4f06f1def3), 1069U },
+    { UINT64_C(0x431eda153229ebbf), UINT64_C(0x003c4a6bdd24f9a4), 1087U },
+    { UINT64_C(0xaf0bf78d7e01686b), UINT64_C(0x003c11d54b525c73), 1091U },
+    { UINT64_C(0xa9ced0742c086e8d), UINT64_C(0x003bf5b1c5721065), 1093U },
+    { UINT64_C(0xc26458ad9f632df9), UINT64_C(0x003bbdb9862f23b4), 1097U },
+    { UINT64_C(0xbbff1255dff892af), UINT64_C(0x003b6a8801db5440), 1103U },
+    { UINT64_C(0xcbd49a333f04d8fd), UINT64_C(0x003b183cf0fed886), 1109U },
+    { UINT64_C(0xec84ed6f9cfdeff5), UINT64_C(0x003aabe394bdc3f4), 1117U },
+    { UINT64_C(0x97980cc40bda9d4b), UINT64_C(0x003a5ba3e76156da), 1123U },
+    { UINT64_C(0x777f34d524f5cbd9), UINT64_C(0x003a0c3e953378db), 1129U },
+    { UINT64_C(0x2797051d94cbbb7f), UINT64_C(0x0038f03561320b1e), 1151U },
+    { UINT64_C(0xea769051b4f43b81), UINT64_C(0x0038d6ecaef5908a), 1153U },
+    { UINT64_C(0xce7910f3034d4323), UINT64_C(0x003859cf221e6069), 1163U },
+    { UINT64_C(0x92791d1374f5b99b), UINT64_C(0x0037f7415dc9588a), 1171U },
+    { UINT64_C(0x89a5645cc68ea1b5), UINT64_C(0x00377df0d3902626), 1181U },
+    { UINT64_C(0x5f8aacf796c0cf0b), UINT64_C(0x00373622136907fa), 1187U },
+    { UINT64_C(0xf2e90a15e33edf99), UINT64_C(0x0036ef0c3b39b92f), 1193U },
+    { UINT64_C(0x8e99e5feb897c451), UINT64_C(0x0036915f47d55e6d), 1201U },
+    { UINT64_C(0xaca2eda38fb91695), UINT64_C(0x0036072cf3f866fd), 1213U },
+    { UINT64_C(0x5d9b737be5ea8b41), UINT64_C(0x0035d9b737be5ea8), 1217U },
+    { UINT64_C(0x4aefe1db93fd7cf7), UINT64_C(0x0035961559cc81c7), 1223U },
+    { UINT64_C(0xa0994ef20b3f8805), UINT64_C(0x0035531c897a4592), 1229U },
+    { UINT64_C(0x103890bda912822f), UINT64_C(0x00353ceebd3e98a4), 1231U },
+    { UINT64_C(0xb441659d13a9147d), UINT64_C(0x0034fad381585e5e), 1237U },
+    { UINT64_C(0x1e2134440c4c3f21), UINT64_C(0x00347884d1103130), 1249U },
+    { UINT64_C(0x263a27727a6883c3), UINT64_C(0x00340dd3ac39bf56), 1259U },
+    { UINT64_C(0x78e221472ab33855), UINT64_C(0x003351fdfecc140c), 1277U },
+    { UINT64_C(0x95eac88e82e6faff), UINT64_C(0x00333d72b089b524), 1279U },
+    { UINT64_C(0xf66c258317be8dab), UINT64_C(0x0033148d44d6b261), 1283U },
+    { UINT64_C(0x09ee202c7cb91939), UINT64_C(0x0032d7aef8412458), 1289U },
+    { UINT64_C(0x8d2fca1042a09ea3), UINT64_C(0x0032c3850e79c0f1), 1291U },
+    { UINT64_C(0x82779c856d8b8bf1), UINT64_C(0x00328766d59048a2), 1297U },
+    { UINT64_C(0x3879361cba8a223d), UINT64_C(0x00325fa18cb11833), 1301U },
+    { UINT64_C(0xf23f43639c3182a7), UINT64_C(0x00324bd659327e22), 1303U },
+    { UINT64_C(0xa03868fc474bcd13), UINT64_C(0x0032246e784360f4), 1307U },
+    { UINT64_C(0x651e78b8c5311a97), UINT64_C(0x0031afa5f1a33a08), 1319U },
+    { UINT64_C(0x8ffce639c00c6719), UINT64_C(0x00319c63ff398e70), 1321U },
+    { UINT64_C(0xf7b460754b0b61cf), UINT64_C(0x003162f7519a86a7), 1327U },
+    { UINT64_C(0x7b03f3359b8e63b1), UINT64_C(0x0030271fc9d3fc3c), 1361U },
+    { UINT64_C(0xa55c5326041eb667), UINT64_C(0x002ff104ae89750b), 1367U },
+    { UINT64_C(0x647f88ab896a76f5), UINT64_C(0x002fbb62a236d133), 1373U },
+    { UINT64_C(0x8fd971434a55a46d), UINT64_C(0x002f74997d2070b4), 1381U },
+    { UINT64_C(0x9fbf969958046447), UINT64_C(0x002ed84aa8b6fce3), 1399U },
+    { UINT64_C(0x9986feba69be3a81), UINT64_C(0x002e832df7a46dbd), 1409U },
+    { UINT64_C(0xa668b3e6d053796f), UINT64_C(0x002e0e0846857cab), 1423U },
+    { UINT64_C(0x97694e6589f4e09b), UINT64_C(0x002decfbdfb55ee6), 1427U },
+    { UINT64_C(0x37890c00b7721dbd), UINT64_C(0x002ddc876f3ff488), 1429U },
+    { UINT64_C(0x5ac094a235f37ea9), UINT64_C(0x002dbbc1d4c482c4), 1433U },
+    { UINT64_C(0x31cff775f2d5d65f), UINT64_C(0x002d8af0e0de0556), 1439U },
+    { UINT64_C(0xddad8e6b36505217), UINT64_C(0x002d4a7b7d14b30a), 1447U },
+    { UINT64_C(0x5a27df897062cd03), UINT64_C(0x002d2a85073bcf4e), 1451U },
+    { UINT64_C(0xe2396fe0fdb5a625), UINT64_C(0x002d1a9ab13e8be4), 1453U },
+    { UINT64_C(0xb352a4957e82317b), UINT64_C(0x002ceb1eb4b9fd8b), 1459U },
+    { UINT64_C(0xd8ab3f2c60c2ea3f), UINT64_C(0x002c8d503a79794c), 1471U },
+    { UINT64_C(0x6893f702f0452479), UINT64_C(0x002c404d708784ed), 1481U },
+    { UINT64_C(0x9686fdc182acf7e3), UINT64_C(0x002c31066315ec52), 1483U },
+    { UINT64_C(0x6854037173dce12f), UINT64_C(0x002c1297d80f2664), 1487U },
+    { UINT64_C(0x7f0ded1685c27331), UINT64_C(0x002c037044c55f6b), 1489U },
+    { UINT64_C(0xeeda72e1fe490b7d), UINT64_C(0x002be5404cd13086), 1493U },
+    { UINT64_C(0x9e7bfc959a8e6e53), UINT64_C(0x002bb845adaf0cce), 1499U },
+    { UINT64_C(0x49b314d6d4753dd7), UINT64_C(0x002b5f62c639f16d), 1511U },
+    { UINT64_C(0x2e8f8c5ac4aa1b3b), UINT64_C(0x002b07e6734f2b88), 1523U },
+    { UINT64_C(0xb8ef723481163d33), UINT64_C(0x002ace569d8342b7), 1531U },
+    { UINT64_C(0x6a2ec96a594287b7), UINT64_C(0x002a791d5dbd4dcf), 1543U },
+    { UINT64_C(0xdba41c6d13aab8c5), UINT64_C(0x002a4eff8113017c), 1549U },
+    { UINT64_C(0xc2adbe648dc3aaf1), UINT64_C(0x002a3319e156df32), 1553U },
+    { UINT64_C(0x87a2bade565f91a7), UINT64_C(0x002a0986286526ea), 1559U },
+    { UINT64_C(0x4d6fe8798c01f5df), UINT64_C(0x0029d29551d91e39), 1567U },
+    { UINT64_C(0x3791310c8c23d98b), UINT64_C(0x0029b7529e109f0a), 1571U },
+    { UINT64_C(0xf80e446b01228883), UINT64_C(0x00298137491ea465), 1579U },
+    { UINT64_C(0x9aed1436fbf500cf), UINT64_C(0x0029665e1eb9f9da), 1583U },
+    { UINT64_C(0x7839b54cc8b24115), UINT64_C(0x002909752e019a5e), 1597U },
+    { UINT64_C(0xc128c646ad0309c1), UINT64_C(0x0028ef35e2e5efb0), 1601U },
+    { UINT64_C(0x14de631624a3c377), UINT64_C(0x0028c815aa4b8278), 1607U },
+    { UINT64_C(0x3f7b9fe68b0ecbf9), UINT64_C(0x0028bb1b867199da), 1609U },
+    { UINT64_C(0x284ffd75ec00a285), UINT64_C(0x0028a13ff5d7b002), 1613U },
+    { UINT64_C(0x37803cb80dea2ddb), UINT64_C(0x00287ab3f173e755), 1619U },
+    { UINT64_C(0x86b63f7c9ac4c6fd), UINT64_C(0x00286dead67713bd), 1621U }
+};
+
+#endif /* CLASSICAL_RNG_INTERNAL_SMALL_PRIMES_H */
@@ -0,0 +1,241 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#  define _DEFAULT_SOURCE
+#endif
+
+#include "classical_rng/crypto_rng.h"
+#include "../common/probes.h"
+#include "../common/secure_zero.h"
+
+#include <string.h>
+#include <time.h>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#elif !defined(__STDC_NO_ATOMICS__)
+#  include <stdatomic.h>
+#  define CRNG_UUID_USE_STDATOMIC 1
+#endif
+
+/*
+ * Version 7 ordering state: the next unused (unix_ms << 16 | sequence)
+ * value. Each call reserves one value per UUID with a single atomic update,
+ * so UUIDs from every thread of the process strictly increase. A sequence
+ * that passes 0xffff carries into the timestamp, running it ahead of the
+ * clock until the clock catches up.
+ */
+#if defined(_WIN32)
+static volatile LONG64 crng_uuid_v7_next;
+#elif defined(CRNG_UUID_USE_STDATOMIC)
+static atomic_uint_fast64_t crng_uuid_v7_next;
+#else
+static uint64_t crng_uuid_v7_next; /* Without C11 atomics, callers serialize. */
+#endif
+
+static crng_status crng_uuid_unix_ms(uint64_t *out) {
+#if defined(_WIN32)
+    FILETIME now;
+    ULARGE_INTEGER ticks;
+
+    GetSystemTimePreciseAsFileTime(&now);
+    ticks.LowPart = now.dwLowDateTime;
+    ticks.HighPart = now.dwHighDateTime;
+    /* 100 ns ticks since 1601-01-01. */
+    if (ticks.QuadPart < UINT64_C(116444736000000000)) {
+        return CRNG_ERR_SYSTEM;
+    }
+    *out = (ticks.QuadPart - UINT64_C(116444736000000000)) / UINT64_C(10000);
+    return CRNG_OK;
+#else
+    struct timespec now;
+
+    if (clock_gettime(CLOCK_REALTIME, &now) != 0 || now.tv_sec < 0) {
+        return CRNG_ERR_SYSTEM;
+    }
+    *out = (uint64_t)now.tv_sec * UINT64_C(1000) + (uint64_t)now.tv_nsec / UINT64_C(1000000);
+    return CRNG_OK;
+#endif
+}
+
+/* Reserve count consecutive ordering values no earlier than now_ms. */
+static int crng_uuid_v7_reserve(uint64_t now_ms, uint64_t count, uint64_t *first) {
+    const uint64_t floor = now_ms << 16;
+    uint64_t base;
+#if defined(_WIN32)
+    LONG64 expected = crng_uuid_v7_next;
+
+    for (;;) {
+        LONG64 observed;
+
+        base = (uint64_t)expected > floor ? (uint64_t)expected : floor;
+        if (UINT64_MAX - base < count) {
+            return 0;
+        }
+        observed = InterlockedCompareExchange64(
+            &crng_uuid_v7_next, (LONG64)(base + count), expected);
+        if (observed == expected) {
+            break;
+        }
+        expected = observed;
+    }
+#elif defined(CRNG_UUID_USE_STDATOMIC)
+    uint_fast64_t expected = atomic_load_explicit(&crng_uuid_v7_next, memory_order_relaxed);
+
+    do {
+        base = (uint64_t)expected > floor ? (uint64_t)expected : floor;
+        if (UINT64_MAX - base < count) {
+            return 0;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(
+        &crng_uuid_v7_next, &expected, (uint_fast64_t)(base + count),
+        memory_order_relaxed, memory_order_relaxed));
+#else
+    base = crng_uuid_v7_next > floor ? crng_uuid_v7_next : floor;
+    if (UINT64_MAX - base < count) {
+        return 0;
+    }
+    crng_uuid_v7_next = base + count;
+#endif
+    *first = base;
+    return 1;
+}
+
+crng_status crng_secure_uuid_v4_array(unsigned char *out, size_t count) {
+    crng_status status;
+    size_t index;
+
+    if (out == NULL && count != 0) {
+        return CRNG_ERR_NULL;
+    }
+    if (count > SIZE_MAX / CRNG_UUID_BYTES) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+
+    CRNG_PROBE2(uuid_batch_entry, count, 4);
+    status = crng_secure_bytes(out, count * CRNG_UUID_BYTES);
+    if (status != CRNG_OK) {
+        crng_secure_zero(out, count * CRNG_UUID_BYTES);
+        CRNG_PROBE2(uuid_batch_return, count, (int)status);
+        return status;
+    }
+    for (index = 0; index < count; ++index) {
+        unsigned char *uuid = out + index * CRNG_UUID_BYTES;
+
+        uuid[6] = (unsigned char)((uuid[6] & 0x0fU) | 0x40U);
+        uuid[8] = (unsigned char)((uuid[8] & 0x3fU) | 0x80U);
+    }
+    CRNG_PROBE2(uuid_batch_return, count, (int)CRNG_OK);
+    return CRNG_OK;
+}
+
+crng_status crng_secure_uuid_v7_array(unsigned char *out, size_t count) {
+    uint64_t now_ms;
+    uint64_t next = 0;
+    crng_status status;
+    size_t index;
+
+    if (out == NULL && count != 0) {
+        return CRNG_ERR_NULL;
+    }
+    if (count > SIZE_MAX / CRNG_UUID_BYTES) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+
+    CRNG_PROBE2(uuid_batch_entry, count, 7);
+    status = crng_uuid_unix_ms(&now_ms);
+    if (status == CRNG_OK) {
+        status = crng_secure_bytes(out, count * CRNG_UUID_BYTES);
+    }
+    /* Reserve only after the entropy read so a failure consumes no order. */
+    if (status == CRNG_OK && !crng_uuid_v7_reserve(now_ms, (uint64_t)count, &next)) {
+        status = CRNG_ERR_INVALID_RANGE;
+    }
+    if (status != CRNG_OK) {
+        crng_secure_zero(out, count * CRNG_UUID_BYTES);
+        CRNG_PROBE2(uuid_batch_return, count, (int)status);
+        return status;
+    }
+
+    /*
+     * RFC 9562 layout: 48-bit unix_ms, version, the sequence's top 12 bits
+     * as rand_a, variant, then its low 4 bits ahead of 58 random bits.
+     */
+    for (index = 0; index < count; ++index, ++next) {
+        unsigned char *uuid = out + index * CRNG_UUID_BYTES;
+        const uint64_t unix_ms = next >> 16;
+        const unsigned int sequence = (unsigned int)(next & 0xffffU);
+
+        uuid[0] = (unsigned char)(unix_ms >> 40);
+        uuid[1] = (unsigned char)(unix_ms >> 32);
+        uuid[2] = (unsigned char)(unix_ms >> 24);
+        uuid[3] = (unsigned char)(unix_ms >> 16);
+        uuid[4] = (unsigned char)(unix_ms >> 8);
+        uuid[5] = (unsigned char)unix_ms;
+        uuid[6] = (unsigned char)(0x70U | sequence >> 12);
+        uuid[7] = (unsigned char)(sequence >> 4);
+        uuid[8] = (unsigned char)(0x80U | (sequence & 0x0fU) << 2 | (uuid[8] & 0x03U));
+    }
+    CRNG_PROBE2(uuid_batch_return, count, (int)CRNG_OK);
+    return CRNG_OK;
+}
+
+/*
+ * Eight lowercase hex digits for a 32-bit value, most significant digit in
+ * the top byte. The nibbles are spread one per byte and converted together:
+ * adding 6 carries into bit 4 exactly for digits 10-15, which then get the
+ * 39 that separates 'a' from '9' + 1.
+ */
+static uint64_t crng_uuid_hex8(uint32_t value) {
+    uint64_t nibbles = value;
+
+    nibbles = (nibbles | nibbles << 16) & UINT64_C(0x0000ffff0000ffff);
+    nibbles = (nibbles | nibbles << 8) & UINT64_C(0x00ff00ff00ff00ff);
+    nibbles = (nibbles | nibbles << 4) & UINT64_C(0x0f0f0f0f0f0f0f0f);
+    return nibbles + UINT64_C(0x3030303030303030) +
+           ((nibbles + UINT64_C(0x0606060606060606)) >> 4 & UINT64_C(0x0101010101010101)) *
+               UINT64_C(39);
+}
+
+static void crng_uuid_store_be64(char *out, uint64_t value) {
+    unsigned int index;
+
+    for (index = 0; index < 8U; ++index) {
+        out[index] = (char)(value >> (56U - 8U * index));
+    }
+}
+
+static uint32_t crng_uuid_load_be32(const unsigned char *bytes) {
+    return (uint32_t)bytes[0] << 24 | (uint32_t)bytes[1] << 16 |
+           (uint32_t)bytes[2] << 8 | (uint32_t)bytes[3];
+}
+
+crng_status crng_uuid_format_array(const unsigned char *uuids, char *out, size_t count) {
+    size_t index;
+
+    if ((uuids == NULL || out == NULL) && count != 0) {
+        return CRNG_ERR_NULL;
+    }
+    if (count > SIZE_MAX / CRNG_UUID_STRING_LENGTH) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+
+    for (index = 0; index < count; ++index) {
+        const unsigned char *uuid = uuids + index * CRNG_UUID_BYTES;
+        char *text = out + index * CRNG_UUID_STRING_LENGTH;
+        char digits[32];
+
+        crng_uuid_store_be64(digits, crng_uuid_hex8(crng_uuid_load_be32(uuid)));
+        crng_uuid_store_be64(digits + 8, crng_uuid_hex8(crng_uuid_load_be32(uuid + 4)));
+        crng_uuid_store_be64(digits + 16, crng_uuid_hex8(crng_uuid_load_be32(uuid + 8)));
+        crng_uuid_store_be64(digits + 24, crng_uuid_hex8(crng_uuid_load_be32(uuid + 12)));
+        memcpy(text, digits, 8);
+        text[8] = '-';
+        memcpy(text + 9, digits + 8, 4);
+        text[13] = '-';
+        memcpy(text + 14, digits + 12, 4);
+        text[18] = '-';
+        memcpy(text + 19, digits + 16, 4);
+        text[23] = '-';
+        memcpy(text + 24, digits + 20, 12);
+    }
+    return CRNG_OK;
+}
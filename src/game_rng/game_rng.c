@@ -1,5 +1,8 @@
 #include "classical_rng.h"
+#include "classical_rng/game_rng_inline.h"
 #include "../common/constants.h"
+#include "../common/probes.h"
+#include "../common/stats.h"
 
 #include <ctype.h>
 #include <string.h>
@@ -16,9 +19,11 @@ static const char crng_e_decimal[] =
     "475945713821785251664274274663919320030599218174135966290435729003342952605956"
     "3073813232862794349076323382988075319525101901";
 
+/* Parse `text`, keeping at most `fractional_limit` fractional digits. */
 static int crng_fixed_decimal_parse(
     crng_high_precision_decimal *out,
-    const char *text
+    const char *text,
+    size_t fractional_limit
 ) {
     int after_decimal = 0;
 
@@ -39,6 +44,9 @@ static int crng_fixed_decimal_parse(
         if (!isdigit((unsigned char)*text)) {
             return 0;
         }
+        if (after_decimal != 0 && out->fractional_digits == fractional_limit) {
+            break;
+        }
 
         carry = (uint64_t)(unsigned int)(*text - '0');
         for (index = 0; index < out->used; ++index) {
@@ -61,27 +69,40 @@ static int crng_fixed_decimal_parse(
     return 1;
 }
 
-static uint32_t crng_fixed_decimal_div_small(
-    const crng_high_precision_decimal *value,
-    uint32_t divisor,
-    crng_high_precision_decimal *quotient
+/* Fractional digits of the pi/e tables per algorithm; zero means no tables. */
+static size_t crng_algorithm_digits(crng_game_rng_algorithm algorithm) {
+    switch (algorithm) {
+        case CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_200:
+            return 200U;
+        case CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_18:
+            return 18U;
+        case CRNG_GAME_RNG_ALGORITHM_XOSHIRO256SS:
+        default:
+            return 0U;
+    }
+}
+
+static int crng_algorithm_known(unsigned int value) {
+    return value == CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_200 ||
+           value == CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_18 ||
+           value == CRNG_GAME_RNG_ALGORITHM_XOSHIRO256SS;
+}
+
+/* Build the pi/e tables an algorithm divides, or empty ones for xoshiro256**. */
+static void crng_load_constants(
+    crng_high_precision_decimal *pi,
+    crng_high_precision_decimal *e,
+    crng_game_rng_algorithm algorithm
 ) {
-    uint64_t remainder = 0;
-    size_t index;
+    const size_t digits = crng_algorithm_digits(algorithm);
 
-    memset(quotient, 0, sizeof(*quotient));
-    quotient->used = value->used;
-    quotient->fractional_digits = value->fractional_digits;
-    for (index = value->used; index > 0; --index) {
-        const uint64_t current = remainder * CRNG_DECIMAL_LIMB_BASE
-                                 + value->limbs[index - 1];
-        quotient->limbs[index - 1] = (uint32_t)(current / divisor);
-        remainder = current % divisor;
-    }
-    while (quotient->used > 1 && quotient->limbs[quotient->used - 1] == 0) {
-        --quotient->used;
+    if (digits == 0) {
+        memset(pi, 0, sizeof(*pi));
+        memset(e, 0, sizeof(*e));
+        return;
     }
-    return (uint32_t)remainder;
+    (void)crng_fixed_decimal_parse(pi, crng_pi_decimal, digits);
+    (void)crng_fixed_decimal_parse(e, crng_e_decimal, digits);
 }
 
 static uint64_t crng_splitmix64(uint64_t *state) {
@@ -94,54 +115,6 @@ static uint64_t crng_splitmix64(uint64_t *state) {
     return value ^ (value >> 31);
 }
 
-static uint64_t crng_rotate_left_64(uint64_t value, unsigned int shift) {
-    return (value << shift) | (value >> (64U - shift));
-}
-
-static uint64_t crng_avalanche64(uint64_t value) {
-    value = (value ^ (value >> 30)) * CRNG_CONSTANT_E;
-    value = (value ^ (value >> 27)) * CRNG_CONSTANT_PI;
-    return value ^ (value >> 31);
-}
-
-static uint32_t crng_roundoff_divisor(uint64_t value) {
-    uint32_t divisor = (uint32_t)(value ^ (value >> 32));
-    divisor |= UINT32_C(1);
-    return divisor < UINT32_C(3) ? UINT32_C(3) : divisor;
-}
-
-static uint64_t crng_collect_roundoff(crng_game_rng *rng, uint64_t raw) {
-    crng_high_precision_decimal quotient;
-    const uint32_t pi_divisor = crng_roundoff_divisor(
-        raw ^ rng->state[0] ^ rng->step
-    );
-    const uint32_t e_divisor = crng_roundoff_divisor(
-        crng_rotate_left_64(raw, 29U) ^ rng->state[3] ^ (rng->step * CRNG_CONSTANT_E)
-    );
-    uint64_t residue_word;
-
-    rng->last_roundoff.step = rng->step;
-    rng->last_roundoff.pi.divisor = pi_divisor;
-    rng->last_roundoff.pi.remainder = crng_fixed_decimal_div_small(
-        &rng->pi,
-        pi_divisor,
-        &quotient
-    );
-    rng->last_roundoff.e.divisor = e_divisor;
-    rng->last_roundoff.e.remainder = crng_fixed_decimal_div_small(
-        &rng->e,
-        e_divisor,
-        &quotient
-    );
-
-    residue_word = ((uint64_t)rng->last_roundoff.pi.remainder << 32)
-                   | rng->last_roundoff.e.remainder;
-    residue_word ^= ((uint64_t)pi_divisor << 17);
-    residue_word ^= crng_rotate_left_64((uint64_t)e_divisor, 43U);
-    rng->last_roundoff.mixed_residue = crng_avalanche64(residue_word);
-    return rng->last_roundoff.mixed_residue;
-}
-
 const char *crng_game_rng_constant_decimal(const char *name) {
     if (name == NULL) {
         return NULL;
@@ -166,20 +139,47 @@ crng_status crng_game_rng_last_roundoff(
     return CRNG_OK;
 }
 
-void crng_game_rng_seed(crng_game_rng *rng, uint64_t seed) {
+crng_status crng_game_rng_seed_algorithm(
+    crng_game_rng *rng,
+    uint64_t seed,
+    crng_game_rng_algorithm algorithm
+) {
     size_t index;
 
     if (rng == NULL) {
-        return;
+        return CRNG_ERR_NULL;
+    }
+    if (!crng_algorithm_known((unsigned int)algorithm)) {
+        return CRNG_ERR_INVALID_RANGE;
     }
 
+    CRNG_PROBE2(game_seed, rng, seed);
     for (index = 0; index < 4; ++index) {
         rng->state[index] = crng_splitmix64(&seed);
     }
     rng->step = 0;
+    rng->algorithm = algorithm;
     memset(&rng->last_roundoff, 0, sizeof(rng->last_roundoff));
-    (void)crng_fixed_decimal_parse(&rng->pi, crng_pi_decimal);
-    (void)crng_fixed_decimal_parse(&rng->e, crng_e_decimal);
+    memset(&rng->stats, 0, sizeof(rng->stats));
+    crng_load_constants(&rng->pi, &rng->e, algorithm);
+    return CRNG_OK;
+}
+
+void crng_game_rng_seed(crng_game_rng *rng, uint64_t seed) {
+    (void)crng_game_rng_seed_algorithm(rng, seed, CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_200);
+}
+
+const char *crng_game_rng_algorithm_name(crng_game_rng_algorithm algorithm) {
+    switch (algorithm) {
+        case CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_200:
+            return "roundoff-200";
+        case CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_18:
+            return "roundoff-18";
+        case CRNG_GAME_RNG_ALGORITHM_XOSHIRO256SS:
+            return "xoshiro256**";
+        default:
+            return "unknown";
+    }
 }
 
 crng_status crng_game_rng_seed_auto(crng_game_rng *rng) {
@@ -201,26 +201,46 @@ crng_status crng_game_rng_seed_auto(crng_game_rng *rng) {
     return CRNG_OK;
 }
 
-uint64_t crng_game_rng_next_u64(crng_game_rng *rng) {
-    const uint64_t raw = crng_rotate_left_64(rng->state[1] * UINT64_C(5), 7U)
-                         * UINT64_C(9);
-    const uint64_t temporary = rng->state[1] << 17;
-    uint64_t roundoff;
+/*
+ * Inverse of the xoshiro256 transition in crng_game_rng_next_u64. With a and
+ * b the words before and after, b3 = rotl(a3 ^ a1, 45) and b0 = a0 ^ a3 ^ a1
+ * give a0; b1 ^ b2 = a1 ^ (a1 << 17), undone by three more shifted XORs;
+ * then b1 = a0 ^ a1 ^ a2 gives a2.
+ */
+static void crng_xoshiro_unstep(uint64_t state[4]) {
+    const uint64_t mixed = crng_inline_rotate_left_64(state[3], 19U);
+    const uint64_t shifted = state[1] ^ state[2];
+    const uint64_t word0 = state[0] ^ mixed;
+    const uint64_t word1 = shifted ^ (shifted << 17) ^ (shifted << 34) ^ (shifted << 51);
+
+    state[2] = state[1] ^ word0 ^ word1;
+    state[3] = mixed ^ word1;
+    state[0] = word0;
+    state[1] = word1;
+}
 
-    rng->state[2] ^= rng->state[0];
-    rng->state[3] ^= rng->state[1];
-    rng->state[1] ^= rng->state[2];
-    rng->state[0] ^= rng->state[3];
-    rng->state[2] ^= temporary;
-    rng->state[3] = crng_rotate_left_64(rng->state[3], 45U);
+/*
+ * Recompute last_roundoff for the current step, or clear it at step zero and
+ * for xoshiro256**, which records none.
+ */
+static void crng_restore_roundoff(crng_game_rng *rng) {
+    uint64_t previous[4];
 
-    ++rng->step;
-    roundoff = crng_collect_roundoff(rng, raw);
-    return crng_avalanche64(raw ^ roundoff ^ (rng->step * CRNG_CONSTANT_ROOT2));
+    if (rng->step == 0 || rng->algorithm == CRNG_GAME_RNG_ALGORITHM_XOSHIRO256SS) {
+        memset(&rng->last_roundoff, 0, sizeof(rng->last_roundoff));
+        return;
+    }
+    memcpy(previous, rng->state, sizeof(previous));
+    crng_xoshiro_unstep(previous);
+    (void)crng_inline_collect_roundoff(rng, crng_inline_xoshiro_raw(previous[1]));
+}
+
+uint64_t crng_game_rng_next_u64(crng_game_rng *rng) {
+    return crng_game_rng_inline_next_u64(rng);
 }
 
 uint32_t crng_game_rng_next_u32(crng_game_rng *rng) {
-    return (uint32_t)(crng_game_rng_next_u64(rng) >> 32);
+    return crng_game_rng_inline_next_u32(rng);
 }
 
 crng_status crng_game_rng_fill(crng_game_rng *rng, void *buffer, size_t size) {
@@ -230,6 +250,7 @@ crng_status crng_game_rng_fill(crng_game_rng *rng, void *buffer, size_t size) {
         return CRNG_ERR_NULL;
     }
 
+    CRNG_PROBE2(game_fill_entry, rng, size);
     while (size != 0) {
         uint64_t value = crng_game_rng_next_u64(rng);
         size_t index;
@@ -240,7 +261,9 @@ crng_status crng_game_rng_fill(crng_game_rng *rng, void *buffer, size_t size) {
         }
         bytes += chunk;
         size -= chunk;
+        CRNG_GAME_STAT_ADD(rng, fill_discarded_bytes, sizeof(value) - chunk);
     }
+    CRNG_PROBE2(game_fill_return, rng, rng->step);
     return CRNG_OK;
 }
 
@@ -262,8 +285,13 @@ crng_status crng_game_rng_uniform_u64(
     threshold = (UINT64_C(0) - upper_bound) % upper_bound;
     do {
         value = crng_game_rng_next_u64(rng);
+        if (value < threshold) {
+            CRNG_GAME_STAT_ADD(rng, uniform_rejections, 1U);
+            CRNG_PROBE2(game_uniform_reject, rng, upper_bound);
+        }
     } while (value < threshold);
 
+    CRNG_GAME_STAT_ADD(rng, uniform_results, 1U);
     *out = value % upper_bound;
     return CRNG_OK;
 }
@@ -295,6 +323,234 @@ crng_status crng_game_rng_range_i32(
     return CRNG_OK;
 }
 
+uint64_t crng_game_rng_prev_u64(crng_game_rng *rng) {
+    uint64_t output;
+
+    if (rng->step == 0) {
+        return 0;
+    }
+    if (rng->algorithm == CRNG_GAME_RNG_ALGORITHM_XOSHIRO256SS) {
+        crng_xoshiro_unstep(rng->state);
+        --rng->step;
+        return crng_inline_xoshiro_raw(rng->state[1]);
+    }
+    /* A restored record carries no sample for the current step. */
+    if (rng->last_roundoff.step != rng->step) {
+        crng_restore_roundoff(rng);
+    }
+    output = rng->last_roundoff.mixed_residue ^ (rng->step * CRNG_CONSTANT_ROOT2);
+    crng_xoshiro_unstep(rng->state);
+    output = crng_inline_avalanche64(crng_inline_xoshiro_raw(rng->state[1]) ^ output);
+    --rng->step;
+    crng_restore_roundoff(rng);
+    return output;
+}
+
+crng_status crng_game_rng_rewind(crng_game_rng *rng, uint64_t count) {
+    uint64_t index;
+
+    if (rng == NULL) {
+        return CRNG_ERR_NULL;
+    }
+    if (count > rng->step) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+    if (count == 0) {
+        return CRNG_OK;
+    }
+    for (index = 0; index < count; ++index) {
+        crng_xoshiro_unstep(rng->state);
+    }
+    rng->step -= count;
+    crng_restore_roundoff(rng);
+    return CRNG_OK;
+}
+
 double crng_game_rng_next_double(crng_game_rng *rng) {
-    return (double)(crng_game_rng_next_u64(rng) >> 11) * 0x1.0p-53;
+    return crng_game_rng_inline_next_double(rng);
+}
+
+crng_status crng_game_rng_read_stats(
+    const crng_game_rng *rng,
+    crng_game_rng_stats *out
+) {
+    if (rng == NULL || out == NULL) {
+        return CRNG_ERR_NULL;
+    }
+#if defined(CRNG_ENABLE_STATS)
+    *out = rng->stats;
+    return CRNG_OK;
+#else
+    return CRNG_ERR_UNSUPPORTED;
+#endif
+}
+
+crng_status crng_game_rng_reset_stats(crng_game_rng *rng) {
+    if (rng == NULL) {
+        return CRNG_ERR_NULL;
+    }
+#if defined(CRNG_ENABLE_STATS)
+    memset(&rng->stats, 0, sizeof(rng->stats));
+    return CRNG_OK;
+#else
+    return CRNG_ERR_UNSUPPORTED;
+#endif
+}
+
+/*
+ * Serialized record, all integers little-endian:
+ *   0..1   magic "CG"
+ *   2      record format version
+ *   3      algorithm identifier
+ *   4..35  xoshiro state words 0-3
+ *   36..43 step
+ *   44..47 CRC-32 (IEEE) of bytes 0..43
+ * The pi/e tables are constants and are rebuilt on load; last_roundoff is
+ * diagnostic and restarts at zero, as after seeding.
+ */
+#define CRNG_GAME_RECORD_VERSION 1U
+#define CRNG_GAME_RECORD_CHECKED_BYTES 44U
+
+static uint32_t crng_record_crc32(const unsigned char *bytes, size_t size) {
+    /* Four bits at a time with the reflected 0xedb88320 polynomial. */
+    static const uint32_t table[16] = {
+        UINT32_C(0x00000000), UINT32_C(0x1db71064), UINT32_C(0x3b6e20c8), UINT32_C(0x26d930ac),
+        UINT32_C(0x76dc4190), UINT32_C(0x6b6b51f4), UINT32_C(0x4db26158), UINT32_C(0x5005713c),
+        UINT32_C(0xedb88320), UINT32_C(0xf00f9344), UINT32_C(0xd6d6a3e8), UINT32_C(0xcb61b38c),
+        UINT32_C(0x9b64c2b0), UINT32_C(0x86d3d2d4), UINT32_C(0xa00ae278), UINT32_C(0xbdbdf21c)
+    };
+    uint32_t crc = UINT32_MAX;
+    size_t index;
+
+    for (index = 0; index < size; ++index) {
+        crc ^= bytes[index];
+        crc = (crc >> 4) ^ table[crc & 15U];
+        crc = (crc >> 4) ^ table[crc & 15U];
+    }
+    return ~crc;
+}
+
+static void crng_record_store_le(unsigned char *bytes, uint64_t value, size_t size) {
+    size_t index;
+
+    for (index = 0; index < size; ++index) {
+        bytes[index] = (unsigned char)(value >> (index * 8U));
+    }
+}
+
+static uint64_t crng_record_load_le(const unsigned char *bytes, size_t size) {
+    uint64_t value = 0;
+    size_t index;
+
+    for (index = size; index != 0; --index) {
+        value = (value << 8) | bytes[index - 1U];
+    }
+    return value;
+}
+
+static void crng_record_encode(const crng_game_rng *rng, unsigned char *out) {
+    size_t index;
+
+    out[0] = 'C';
+    out[1] = 'G';
+    out[2] = (unsigned char)CRNG_GAME_RECORD_VERSION;
+    out[3] = (unsigned char)rng->algorithm;
+    for (index = 0; index < 4; ++index) {
+        crng_record_store_le(out + 4U + index * 8U, rng->state[index], 8U);
+    }
+    crng_record_store_le(out + 36U, rng->step, 8U);
+    crng_record_store_le(
+        out + CRNG_GAME_RECORD_CHECKED_BYTES,
+        crng_record_crc32(out, CRNG_GAME_RECORD_CHECKED_BYTES),
+        4U
+    );
+}
+
+static int crng_record_valid(const unsigned char *record) {
+    if (record[0] != 'C' || record[1] != 'G' ||
+        record[2] != CRNG_GAME_RECORD_VERSION || !crng_algorithm_known(record[3])) {
+        return 0;
+    }
+    if (crng_record_load_le(record + CRNG_GAME_RECORD_CHECKED_BYTES, 4U)
+        != crng_record_crc32(record, CRNG_GAME_RECORD_CHECKED_BYTES)) {
+        return 0;
+    }
+    /* An all-zero xoshiro state never leaves zero; no seed produces it. */
+    return (crng_record_load_le(record + 4U, 8U) | crng_record_load_le(record + 12U, 8U) |
+            crng_record_load_le(record + 20U, 8U) | crng_record_load_le(record + 28U, 8U)) != 0;
+}
+
+crng_status crng_game_rng_serialize(const crng_game_rng *rng, unsigned char *out) {
+    return crng_game_rng_serialize_array(rng, out, 1U);
+}
+
+crng_status crng_game_rng_deserialize(crng_game_rng *rng, const unsigned char *record) {
+    return crng_game_rng_deserialize_array(rng, record, 1U);
+}
+
+crng_status crng_game_rng_serialize_array(
+    const crng_game_rng *rngs,
+    unsigned char *out,
+    size_t count
+) {
+    size_t index;
+
+    if ((rngs == NULL || out == NULL) && count != 0) {
+        return CRNG_ERR_NULL;
+    }
+    if (count > SIZE_MAX / CRNG_GAME_RNG_RECORD_BYTES) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+    for (index = 0; index < count; ++index) {
+        crng_record_encode(&rngs[index], out + index * CRNG_GAME_RNG_RECORD_BYTES);
+    }
+    return CRNG_OK;
+}
+
+crng_status crng_game_rng_deserialize_array(
+    crng_game_rng *rngs,
+    const unsigned char *records,
+    size_t count
+) {
+    crng_high_precision_decimal pi;
+    crng_high_precision_decimal e;
+    crng_game_rng_algorithm loaded = CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_200;
+    size_t index;
+
+    if ((rngs == NULL || records == NULL) && count != 0) {
+        return CRNG_ERR_NULL;
+    }
+    if (count > SIZE_MAX / CRNG_GAME_RNG_RECORD_BYTES) {
+        return CRNG_ERR_INVALID_RANGE;
+    }
+    /* Check every record first so a bad one leaves all generators untouched. */
+    for (index = 0; index < count; ++index) {
+        if (!crng_record_valid(records + index * CRNG_GAME_RNG_RECORD_BYTES)) {
+            return CRNG_ERR_FORMAT;
+        }
+    }
+
+    for (index = 0; index < count; ++index) {
+        const unsigned char *record = records + index * CRNG_GAME_RNG_RECORD_BYTES;
+        const crng_game_rng_algorithm algorithm = (crng_game_rng_algorithm)record[3];
+        crng_game_rng *rng = &rngs[index];
+        size_t word;
+
+        /* Batches usually share one algorithm; parse its tables once. */
+        if (index == 0 || algorithm != loaded) {
+            crng_load_constants(&pi, &e, algorithm);
+            loaded = algorithm;
+        }
+
+        for (word = 0; word < 4; ++word) {
+            rng->state[word] = crng_record_load_le(record + 4U + word * 8U, 8U);
+        }
+        rng->step = crng_record_load_le(record + 36U, 8U);
+        rng->algorithm = algorithm;
+        rng->pi = pi;
+        rng->e = e;
+        memset(&rng->last_roundoff, 0, sizeof(rng->last_roundoff));
+        memset(&rng->stats, 0, sizeof(rng->stats));
+    }
+    return CRNG_OK;
 }
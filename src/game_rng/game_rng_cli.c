@@ -1,14 +1,51 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#  define _DEFAULT_SOURCE
+#endif
+#if defined(_MSC_VER) && !defined(_CRT_SECURE_NO_WARNINGS)
+#  define _CRT_SECURE_NO_WARNINGS /* strerror is used portably here. */
+#endif
+
 #include "classical_rng/game_rng.h"
 
 #include <errno.h>
 #include <inttypes.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(_WIN32)
+#  include <fcntl.h>
+#  include <io.h>
+#else
+#  include <signal.h>
+#  include <unistd.h>
+#endif
+
+/* Generated bytes per write; a multiple of 32 so hex lines never split. */
+#define CRNG_GAME_CHUNK_BYTES ((size_t)1 << 20)
+#define CRNG_GAME_HEX_LINE_BYTES 32U
+
+typedef enum crng_game_format {
+    CRNG_GAME_FORMAT_DECIMAL,
+    CRNG_GAME_FORMAT_RAW,
+    CRNG_GAME_FORMAT_HEX,
+    CRNG_GAME_FORMAT_U64LE
+} crng_game_format;
+
+typedef enum crng_game_write_result {
+    CRNG_GAME_WRITE_OK,
+    CRNG_GAME_WRITE_CLOSED,
+    CRNG_GAME_WRITE_FAILED
+} crng_game_write_result;
+
 static void crng_game_usage(const char *program) {
     fprintf(stderr,
-            "usage: %s [--seed N] [--count N] [--show-roundoff]\n",
+            "usage: %s [--seed N] [--algorithm NAME] [--count N] [--show-roundoff]\n"
+            "       %s [--seed N] [--algorithm NAME] --format raw|hex|u64le [--count N]\n"
+            "          [--bytes N|unbounded]\n"
+            "algorithms: roundoff-200 (default), roundoff-18, xoshiro256**\n",
+            program,
             program);
 }
 
@@ -28,9 +65,137 @@ static int crng_parse_u64(const char *text, uint64_t *out) {
     return 1;
 }
 
+static int crng_parse_algorithm(const char *text, crng_game_rng_algorithm *out) {
+    int value;
+
+    for (value = CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_200;
+         value <= CRNG_GAME_RNG_ALGORITHM_XOSHIRO256SS;
+         ++value) {
+        if (strcmp(text, crng_game_rng_algorithm_name((crng_game_rng_algorithm)value)) == 0) {
+            *out = (crng_game_rng_algorithm)value;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Write everything, retrying short writes; a closed reader is not an error. */
+static crng_game_write_result crng_game_write_all(const unsigned char *data, size_t size) {
+#if defined(_WIN32)
+    if (fwrite(data, 1, size, stdout) != size) {
+        return errno == EPIPE || errno == EINVAL ? CRNG_GAME_WRITE_CLOSED
+                                                 : CRNG_GAME_WRITE_FAILED;
+    }
+    return CRNG_GAME_WRITE_OK;
+#else
+    while (size != 0) {
+        const ssize_t written = write(STDOUT_FILENO, data, size);
+
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EPIPE ? CRNG_GAME_WRITE_CLOSED : CRNG_GAME_WRITE_FAILED;
+        }
+        data += written;
+        size -= (size_t)written;
+    }
+    return CRNG_GAME_WRITE_OK;
+#endif
+}
+
+static size_t crng_game_hex_encode(
+    unsigned char *out,
+    const unsigned char *bytes,
+    size_t size
+) {
+    static const char digits[] = "0123456789abcdef";
+    size_t length = 0;
+    size_t index;
+
+    for (index = 0; index < size; ++index) {
+        out[length++] = (unsigned char)digits[bytes[index] >> 4];
+        out[length++] = (unsigned char)digits[bytes[index] & 15U];
+        if ((index + 1U) % CRNG_GAME_HEX_LINE_BYTES == 0 || index + 1U == size) {
+            out[length++] = '\n';
+        }
+    }
+    return length;
+}
+
+/*
+ * Binary and hex output. Every chunk but the last is a whole number of words,
+ * so the bytes match one crng_game_rng_fill call of the full length.
+ */
+static int crng_game_stream(
+    crng_game_rng *rng,
+    crng_game_format format,
+    uint64_t bytes,
+    int unbounded
+) {
+    const size_t hex_capacity = CRNG_GAME_CHUNK_BYTES * 2U +
+                                CRNG_GAME_CHUNK_BYTES / CRNG_GAME_HEX_LINE_BYTES;
+    const size_t allocation = CRNG_GAME_CHUNK_BYTES +
+                              (format == CRNG_GAME_FORMAT_HEX ? hex_capacity : 0U);
+    unsigned char *storage;
+    unsigned char *chunk;
+    unsigned char *encoded;
+    int result = 0;
+
+    /* Page-aligned so the kernel copies whole pages out of the buffer. */
+    storage = (unsigned char *)malloc(allocation + 4095U);
+    if (storage == NULL) {
+        fprintf(stderr, "game_rng_cli: out of memory\n");
+        return 1;
+    }
+    chunk = storage + ((4096U - (uintptr_t)storage % 4096U) % 4096U);
+    encoded = chunk + CRNG_GAME_CHUNK_BYTES;
+
+#if defined(_WIN32)
+    (void)_setmode(_fileno(stdout), _O_BINARY);
+#else
+    signal(SIGPIPE, SIG_IGN);
+#endif
+    while (unbounded || bytes != 0) {
+        const size_t size = !unbounded && bytes < CRNG_GAME_CHUNK_BYTES ? (size_t)bytes
+                                                                        : CRNG_GAME_CHUNK_BYTES;
+        crng_game_write_result written;
+
+        (void)crng_game_rng_fill(rng, chunk, size);
+        if (format == CRNG_GAME_FORMAT_HEX) {
+            written = crng_game_write_all(encoded, crng_game_hex_encode(encoded, chunk, size));
+        } else {
+            written = crng_game_write_all(chunk, size);
+        }
+        if (written == CRNG_GAME_WRITE_CLOSED) {
+            break;
+        }
+        if (written == CRNG_GAME_WRITE_FAILED) {
+            fprintf(stderr, "game_rng_cli: write failed: %s\n", strerror(errno));
+            result = 1;
+            break;
+        }
+        if (!unbounded) {
+            bytes -= size;
+        }
+    }
+#if defined(_WIN32)
+    if (result == 0 && fflush(stdout) != 0 && errno != EPIPE && errno != EINVAL) {
+        result = 1;
+    }
+#endif
+    free(storage);
+    return result;
+}
+
 int main(int argc, char **argv) {
     uint64_t seed = UINT64_C(2026);
     uint64_t count = UINT64_C(10);
+    uint64_t bytes = 0;
+    crng_game_format format = CRNG_GAME_FORMAT_DECIMAL;
+    crng_game_rng_algorithm algorithm = CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_200;
+    int have_bytes = 0;
+    int unbounded = 0;
     int show_roundoff = 0;
     crng_game_rng rng;
     int argument;
@@ -46,6 +211,35 @@ int main(int argc, char **argv) {
                 crng_game_usage(argv[0]);
                 return 2;
             }
+        } else if (strcmp(argv[argument], "--bytes") == 0 && argument + 1 < argc) {
+            ++argument;
+            if (strcmp(argv[argument], "unbounded") == 0) {
+                unbounded = 1;
+            } else if (!crng_parse_u64(argv[argument], &bytes)) {
+                crng_game_usage(argv[0]);
+                return 2;
+            }
+            have_bytes = 1;
+        } else if (strcmp(argv[argument], "--format") == 0 && argument + 1 < argc) {
+            const char *name = argv[++argument];
+
+            if (strcmp(name, "decimal") == 0) {
+                format = CRNG_GAME_FORMAT_DECIMAL;
+            } else if (strcmp(name, "raw") == 0) {
+                format = CRNG_GAME_FORMAT_RAW;
+            } else if (strcmp(name, "hex") == 0) {
+                format = CRNG_GAME_FORMAT_HEX;
+            } else if (strcmp(name, "u64le") == 0) {
+                format = CRNG_GAME_FORMAT_U64LE;
+            } else {
+                crng_game_usage(argv[0]);
+                return 2;
+            }
+        } else if (strcmp(argv[argument], "--algorithm") == 0 && argument + 1 < argc) {
+            if (!crng_parse_algorithm(argv[++argument], &algorithm)) {
+                crng_game_usage(argv[0]);
+                return 2;
+            }
         } else if (strcmp(argv[argument], "--show-roundoff") == 0) {
             show_roundoff = 1;
         } else if (strcmp(argv[argument], "--help") == 0) {
@@ -57,7 +251,22 @@ int main(int argc, char **argv) {
         }
     }
 
-    crng_game_rng_seed(&rng, seed);
+    (void)crng_game_rng_seed_algorithm(&rng, seed, algorithm);
+    if (format != CRNG_GAME_FORMAT_DECIMAL) {
+        /* --count is in 64-bit values, --bytes in bytes; u64le keeps whole values. */
+        if (show_roundoff != 0 ||
+            (format == CRNG_GAME_FORMAT_U64LE && !unbounded && bytes % 8U != 0) ||
+            (!have_bytes && count > UINT64_MAX / 8U)) {
+            crng_game_usage(argv[0]);
+            return 2;
+        }
+        return crng_game_stream(&rng, format, have_bytes ? bytes : count * 8U, unbounded);
+    }
+    if (have_bytes) {
+        crng_game_usage(argv[0]);
+        return 2;
+    }
+
     while (count-- != 0) {
         const uint64_t value = crng_game_rng_next_u64(&rng);
         printf("%" PRIu64, value);
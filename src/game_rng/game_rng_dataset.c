@@ -0,0 +1,715 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#  define _DEFAULT_SOURCE
+#endif
+
+#include "classical_rng/game_rng.h"
+#include "classical_rng/game_rng_inline.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Reproducible column datasets in a memory-mapped file. Each column is cut
+ * into blocks of CRNG_DATASET_BLOCK_ROWS rows and every block draws from its
+ * own generator, seeded from the dataset seed and the block's coordinates,
+ * so worker threads take blocks in any order and the bytes never depend on
+ * the thread count. POSIX only.
+ */
+#define CRNG_DATASET_MAGIC "CRNGDSET"
+#define CRNG_DATASET_VERSION 1U
+#define CRNG_DATASET_HEADER_BYTES 4096U
+#define CRNG_DATASET_DESCRIPTOR_OFFSET 64U
+#define CRNG_DATASET_DESCRIPTOR_BYTES 32U
+#define CRNG_DATASET_MAX_COLUMNS \
+    ((CRNG_DATASET_HEADER_BYTES - CRNG_DATASET_DESCRIPTOR_OFFSET) / CRNG_DATASET_DESCRIPTOR_BYTES)
+#define CRNG_DATASET_BLOCK_ROWS UINT64_C(65536)
+/* Columns start on 2 MiB boundaries, the huge page size of x86-64 and AArch64. */
+#define CRNG_DATASET_ALIGNMENT UINT64_C(2097152)
+#define CRNG_DATASET_MAX_THREADS 256U
+
+typedef enum crng_dataset_type {
+    CRNG_DATASET_U64 = 1,
+    CRNG_DATASET_F64 = 2,
+    CRNG_DATASET_I32 = 3
+} crng_dataset_type;
+
+typedef struct crng_dataset_column {
+    crng_dataset_type type;
+    uint32_t width;
+    uint64_t offset;
+    int32_t minimum;
+    int32_t maximum;
+} crng_dataset_column;
+
+typedef struct crng_dataset {
+    uint64_t seed;
+    crng_game_rng_algorithm algorithm;
+    uint64_t rows;
+    uint64_t block_rows;
+    uint64_t file_bytes;
+    uint32_t column_count;
+    crng_dataset_column columns[CRNG_DATASET_MAX_COLUMNS];
+} crng_dataset;
+
+/* Shared by the workers; next_task and the mismatch fields are under lock. */
+typedef struct crng_dataset_work {
+    const crng_dataset *dataset;
+    unsigned char *map;
+    int verify;
+    uint64_t blocks_per_column;
+    uint64_t task_count;
+    uint64_t next_task;
+    pthread_mutex_t lock;
+    int failed;
+    uint32_t failed_column;
+    uint64_t failed_block;
+} crng_dataset_work;
+
+static void crng_dataset_usage(const char *program) {
+    fprintf(stderr,
+            "usage: %s --output PATH --columns LIST (--rows N | --size BYTES)\n"
+            "          [--seed N] [--algorithm NAME] [--threads N]\n"
+            "       %s --verify PATH [--threads N]\n"
+            "columns: comma-separated u64, f64, i32:MIN:MAX\n"
+            "algorithms: roundoff-200 (default), roundoff-18, xoshiro256**\n",
+            program,
+            program);
+}
+
+static int crng_parse_u64(const char *text, uint64_t *out) {
+    char *end = NULL;
+    unsigned long long value;
+
+    if (text[0] == '-') {
+        return 0;
+    }
+    errno = 0;
+    value = strtoull(text, &end, 0);
+    if (errno != 0 || end == text || *end != '\0') {
+        return 0;
+    }
+    *out = (uint64_t)value;
+    return 1;
+}
+
+static int crng_parse_algorithm(const char *text, crng_game_rng_algorithm *out) {
+    int value;
+
+    for (value = CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_200;
+         value <= CRNG_GAME_RNG_ALGORITHM_XOSHIRO256SS;
+         ++value) {
+        if (strcmp(text, crng_game_rng_algorithm_name((crng_game_rng_algorithm)value)) == 0) {
+            *out = (crng_game_rng_algorithm)value;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Parse a decimal int32; returns the end of the number, or NULL. */
+static const char *crng_parse_i32(const char *text, int32_t *out) {
+    char *end = NULL;
+    long long value;
+
+    errno = 0;
+    value = strtoll(text, &end, 10);
+    if (errno != 0 || end == text || value < INT32_MIN || value > INT32_MAX) {
+        return NULL;
+    }
+    *out = (int32_t)value;
+    return end;
+}
+
+static int crng_dataset_parse_columns(crng_dataset *dataset, const char *text) {
+    dataset->column_count = 0;
+    for (;;) {
+        crng_dataset_column *column;
+
+        if (dataset->column_count == CRNG_DATASET_MAX_COLUMNS) {
+            return 0;
+        }
+        column = &dataset->columns[dataset->column_count++];
+        memset(column, 0, sizeof(*column));
+        if (strncmp(text, "u64", 3) == 0) {
+            column->type = CRNG_DATASET_U64;
+            column->width = 8U;
+            text += 3;
+        } else if (strncmp(text, "f64", 3) == 0) {
+            column->type = CRNG_DATASET_F64;
+            column->width = 8U;
+            text += 3;
+        } else if (strncmp(text, "i32:", 4) == 0) {
+            column->type = CRNG_DATASET_I32;
+            column->width = 4U;
+            text = crng_parse_i32(text + 4, &column->minimum);
+            if (text == NULL || *text != ':') {
+                return 0;
+            }
+            text = crng_parse_i32(text + 1, &column->maximum);
+            if (text == NULL || column->minimum > column->maximum) {
+                return 0;
+            }
+        } else {
+            return 0;
+        }
+        if (*text == '\0') {
+            return 1;
+        }
+        if (*text++ != ',') {
+            return 0;
+        }
+    }
+}
+
+/*
+ * Place each column on the next aligned offset after the header and the
+ * previous column. Returns 0 if the layout does not fit in 64 bits.
+ */
+static int crng_dataset_layout(crng_dataset *dataset) {
+    uint64_t offset = CRNG_DATASET_ALIGNMENT;
+    uint32_t index;
+
+    for (index = 0; index < dataset->column_count; ++index) {
+        crng_dataset_column *column = &dataset->columns[index];
+
+        if (index != 0) {
+            if (offset > UINT64_MAX - (CRNG_DATASET_ALIGNMENT - 1U)) {
+                return 0;
+            }
+            offset = (offset + CRNG_DATASET_ALIGNMENT - 1U) & ~(CRNG_DATASET_ALIGNMENT - 1U);
+        }
+        if (dataset->rows > (UINT64_MAX - offset) / column->width) {
+            return 0;
+        }
+        column->offset = offset;
+        offset += dataset->rows * column->width;
+    }
+    dataset->file_bytes = offset;
+    return 1;
+}
+
+/*
+ * The most rows whose layout fits in `size` bytes, which becomes the file
+ * length. Alignment adds under one unit per column, so the answer lies
+ * between the row estimates with and without that padding.
+ */
+static int crng_dataset_rows_for_size(crng_dataset *dataset, uint64_t size) {
+    const uint64_t padding = CRNG_DATASET_ALIGNMENT * dataset->column_count;
+    uint64_t row_bytes = 0;
+    uint64_t low;
+    uint64_t high;
+    uint32_t index;
+
+    for (index = 0; index < dataset->column_count; ++index) {
+        row_bytes += dataset->columns[index].width;
+    }
+    if (size <= padding || (size - padding) / row_bytes == 0) {
+        return 0;
+    }
+    low = (size - padding) / row_bytes;
+    high = size / row_bytes;
+    while (low < high) {
+        const uint64_t middle = low + (high - low + 1U) / 2U;
+
+        dataset->rows = middle;
+        if (crng_dataset_layout(dataset) && dataset->file_bytes <= size) {
+            low = middle;
+        } else {
+            high = middle - 1U;
+        }
+    }
+    dataset->rows = low;
+    (void)crng_dataset_layout(dataset);
+    dataset->file_bytes = size;
+    return 1;
+}
+
+static void crng_dataset_store_le(unsigned char *out, uint64_t value, unsigned int bytes) {
+    unsigned int index;
+
+    for (index = 0; index < bytes; ++index) {
+        out[index] = (unsigned char)(value >> (8U * index));
+    }
+}
+
+static uint64_t crng_dataset_load_le(const unsigned char *in, unsigned int bytes) {
+    uint64_t value = 0;
+    unsigned int index;
+
+    for (index = bytes; index > 0; --index) {
+        value = (value << 8) | in[index - 1U];
+    }
+    return value;
+}
+
+/*
+ * Header, little-endian: magic, version, header bytes, seed, algorithm
+ * identifier, column count, rows, block rows, file bytes, then one 32-byte
+ * descriptor per column: type, element width, data offset, minimum, maximum.
+ */
+static void crng_dataset_encode_header(const crng_dataset *dataset, unsigned char *header) {
+    uint32_t index;
+
+    memset(header, 0, CRNG_DATASET_HEADER_BYTES);
+    crng_dataset_store_le(header + 8, CRNG_DATASET_VERSION, 4U);
+    crng_dataset_store_le(header + 12, CRNG_DATASET_HEADER_BYTES, 4U);
+    crng_dataset_store_le(header + 16, dataset->seed, 8U);
+    crng_dataset_store_le(header + 24, (uint64_t)dataset->algorithm, 4U);
+    crng_dataset_store_le(header + 28, dataset->column_count, 4U);
+    crng_dataset_store_le(header + 32, dataset->rows, 8U);
+    crng_dataset_store_le(header + 40, dataset->block_rows, 8U);
+    crng_dataset_store_le(header + 48, dataset->file_bytes, 8U);
+    for (index = 0; index < dataset->column_count; ++index) {
+        const crng_dataset_column *column = &dataset->columns[index];
+        unsigned char *descriptor = header + CRNG_DATASET_DESCRIPTOR_OFFSET +
+                                    index * CRNG_DATASET_DESCRIPTOR_BYTES;
+
+        crng_dataset_store_le(descriptor, (uint64_t)column->type, 4U);
+        crng_dataset_store_le(descriptor + 4, column->width, 4U);
+        crng_dataset_store_le(descriptor + 8, column->offset, 8U);
+        crng_dataset_store_le(descriptor + 16, (uint32_t)column->minimum, 4U);
+        crng_dataset_store_le(descriptor + 20, (uint32_t)column->maximum, 4U);
+    }
+    /* The magic goes in last, so an interrupted run never looks complete. */
+    memcpy(header, CRNG_DATASET_MAGIC, 8U);
+}
+
+/* Decode and check a header against the mapped file size. */
+static int crng_dataset_decode_header(
+    crng_dataset *dataset,
+    const unsigned char *header,
+    uint64_t size
+) {
+    crng_game_rng probe;
+    uint64_t end = CRNG_DATASET_HEADER_BYTES;
+    uint32_t index;
+
+    if (memcmp(header, CRNG_DATASET_MAGIC, 8U) != 0 ||
+        crng_dataset_load_le(header + 8, 4U) != CRNG_DATASET_VERSION ||
+        crng_dataset_load_le(header + 12, 4U) != CRNG_DATASET_HEADER_BYTES) {
+        return 0;
+    }
+    dataset->seed = crng_dataset_load_le(header + 16, 8U);
+    dataset->algorithm = (crng_game_rng_algorithm)crng_dataset_load_le(header + 24, 4U);
+    dataset->column_count = (uint32_t)crng_dataset_load_le(header + 28, 4U);
+    dataset->rows = crng_dataset_load_le(header + 32, 8U);
+    dataset->block_rows = crng_dataset_load_le(header + 40, 8U);
+    dataset->file_bytes = crng_dataset_load_le(header + 48, 8U);
+    if (crng_game_rng_seed_algorithm(&probe, 0U, dataset->algorithm) != CRNG_OK ||
+        dataset->column_count == 0 || dataset->column_count > CRNG_DATASET_MAX_COLUMNS ||
+        dataset->rows == 0 || dataset->block_rows == 0 ||
+        dataset->block_rows > SIZE_MAX / 8U || dataset->file_bytes != size) {
+        return 0;
+    }
+    for (index = 0; index < dataset->column_count; ++index) {
+        crng_dataset_column *column = &dataset->columns[index];
+        const unsigned char *descriptor = header + CRNG_DATASET_DESCRIPTOR_OFFSET +
+                                          index * CRNG_DATASET_DESCRIPTOR_BYTES;
+
+        column->type = (crng_dataset_type)crng_dataset_load_le(descriptor, 4U);
+        column->width = (uint32_t)crng_dataset_load_le(descriptor + 4, 4U);
+        column->offset = crng_dataset_load_le(descriptor + 8, 8U);
+        column->minimum = (int32_t)(uint32_t)crng_dataset_load_le(descriptor + 16, 4U);
+        column->maximum = (int32_t)(uint32_t)crng_dataset_load_le(descriptor + 20, 4U);
+        if (!((column->type == CRNG_DATASET_U64 && column->width == 8U) ||
+              (column->type == CRNG_DATASET_F64 && column->width == 8U) ||
+              (column->type == CRNG_DATASET_I32 && column->width == 4U &&
+               column->minimum <= column->maximum))) {
+            return 0;
+        }
+        /* Columns are ordered, disjoint, and inside the file. */
+        if (column->offset < end || column->offset > size ||
+            dataset->rows > (size - column->offset) / column->width) {
+            return 0;
+        }
+        end = column->offset + dataset->rows * column->width;
+    }
+    return 1;
+}
+
+/* Two rounds of the SplitMix64 finalizer over the block's coordinates. */
+static uint64_t crng_dataset_block_seed(uint64_t seed, uint32_t column, uint64_t block) {
+    const uint64_t coordinates = ((uint64_t)column << 40) | block;
+
+    return crng_inline_avalanche64(seed ^ crng_inline_avalanche64(coordinates));
+}
+
+/* Generate one block of one column into `out`, in file byte order. */
+static void crng_dataset_generate_block(
+    const crng_dataset *dataset,
+    uint32_t column_index,
+    uint64_t block,
+    unsigned char *out
+) {
+    const crng_dataset_column *column = &dataset->columns[column_index];
+    const uint64_t first = block * dataset->block_rows;
+    const uint64_t rows = dataset->rows - first < dataset->block_rows ? dataset->rows - first
+                                                                      : dataset->block_rows;
+    crng_game_rng rng;
+    uint64_t row;
+
+    (void)crng_game_rng_seed_algorithm(
+        &rng, crng_dataset_block_seed(dataset->seed, column_index, block), dataset->algorithm
+    );
+    switch (column->type) {
+        case CRNG_DATASET_U64:
+            (void)crng_game_rng_fill(&rng, out, (size_t)rows * 8U);
+            break;
+        case CRNG_DATASET_F64:
+            for (row = 0; row < rows; ++row) {
+                const double value = crng_game_rng_inline_next_double(&rng);
+                uint64_t bits;
+
+                memcpy(&bits, &value, sizeof(bits));
+                crng_dataset_store_le(out + row * 8U, bits, 8U);
+            }
+            break;
+        case CRNG_DATASET_I32:
+            for (row = 0; row < rows; ++row) {
+                int32_t value = 0;
+
+                (void)crng_game_rng_inline_range_i32(
+                    &rng,
+                    column->minimum,
+                    column->maximum,
+                    &value
+                );
+                crng_dataset_store_le(out + row * 4U, (uint32_t)value, 4U);
+            }
+            break;
+    }
+}
+
+static void *crng_dataset_worker(void *argument) {
+    crng_dataset_work *work = (crng_dataset_work *)argument;
+    const crng_dataset *dataset = work->dataset;
+    unsigned char *scratch = NULL;
+
+    if (work->verify) {
+        scratch = (unsigned char *)malloc((size_t)dataset->block_rows * 8U);
+        if (scratch == NULL) {
+            pthread_mutex_lock(&work->lock);
+            work->failed = -1;
+            pthread_mutex_unlock(&work->lock);
+            return NULL;
+        }
+    }
+    for (;;) {
+        uint64_t task;
+        uint32_t column_index;
+        uint64_t block;
+        const crng_dataset_column *column;
+        unsigned char *data;
+        uint64_t rows;
+
+        pthread_mutex_lock(&work->lock);
+        task = work->failed != 0 ? work->task_count : work->next_task;
+        if (task < work->task_count) {
+            ++work->next_task;
+        }
+        pthread_mutex_unlock(&work->lock);
+        if (task == work->task_count) {
+            break;
+        }
+
+        column_index = (uint32_t)(task / work->blocks_per_column);
+        block = task % work->blocks_per_column;
+        column = &dataset->columns[column_index];
+        data = work->map + column->offset + block * dataset->block_rows * column->width;
+        if (!work->verify) {
+            crng_dataset_generate_block(dataset, column_index, block, data);
+            continue;
+        }
+        rows = dataset->rows - block * dataset->block_rows;
+        if (rows > dataset->block_rows) {
+            rows = dataset->block_rows;
+        }
+        crng_dataset_generate_block(dataset, column_index, block, scratch);
+        if (memcmp(scratch, data, (size_t)(rows * column->width)) != 0) {
+            pthread_mutex_lock(&work->lock);
+            if (work->failed == 0) {
+                work->failed = 1;
+                work->failed_column = column_index;
+                work->failed_block = block;
+            }
+            pthread_mutex_unlock(&work->lock);
+        }
+    }
+    free(scratch);
+    return NULL;
+}
+
+/* Run every (column, block) task on `threads` workers; 0 if none started. */
+static int crng_dataset_run(crng_dataset_work *work, unsigned int threads) {
+    pthread_t workers[CRNG_DATASET_MAX_THREADS];
+    unsigned int started;
+    unsigned int index;
+
+    work->blocks_per_column = (work->dataset->rows + work->dataset->block_rows - 1U) /
+                              work->dataset->block_rows;
+    work->task_count = work->blocks_per_column * work->dataset->column_count;
+    work->next_task = 0;
+    work->failed = 0;
+    if (pthread_mutex_init(&work->lock, NULL) != 0) {
+        return 0;
+    }
+    for (started = 0; started < threads; ++started) {
+        if (pthread_create(&workers[started], NULL, crng_dataset_worker, work) != 0) {
+            break;
+        }
+    }
+    for (index = 0; index < started; ++index) {
+        pthread_join(workers[index], NULL);
+    }
+    pthread_mutex_destroy(&work->lock);
+    return started != 0;
+}
+
+/* Ask for huge pages on the mapping; a hint only, so failure is ignored. */
+static void crng_dataset_advise(void *map, uint64_t size) {
+#if defined(MADV_HUGEPAGE)
+    (void)madvise(map, (size_t)size, MADV_HUGEPAGE);
+#else
+    (void)map;
+    (void)size;
+#endif
+}
+
+/*
+ * Reserve the file's blocks before writing through the mapping, so a full
+ * disk fails here instead of raising SIGBUS mid-fill. Where that is not
+ * available only the length is set.
+ */
+static int crng_dataset_reserve(int fd, uint64_t size) {
+#if defined(__linux__)
+    const int status = posix_fallocate(fd, 0, (off_t)size);
+
+    if (status == 0) {
+        return 1;
+    }
+    if (status != EINVAL && status != EOPNOTSUPP) {
+        errno = status;
+        return 0;
+    }
+#endif
+    return ftruncate(fd, (off_t)size) == 0;
+}
+
+static int crng_dataset_create(const char *path, crng_dataset *dataset, unsigned int threads) {
+    crng_dataset_work work;
+    unsigned char *map;
+    int fd;
+
+    if ((uint64_t)(size_t)dataset->file_bytes != dataset->file_bytes ||
+        (uint64_t)(off_t)dataset->file_bytes != dataset->file_bytes) {
+        fprintf(stderr, "game_rng_dataset: %s: dataset too large for this platform\n", path);
+        return 1;
+    }
+    fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0666);
+    if (fd < 0) {
+        fprintf(stderr, "game_rng_dataset: %s: %s\n", path, strerror(errno));
+        return 1;
+    }
+    if (!crng_dataset_reserve(fd, dataset->file_bytes)) {
+        fprintf(stderr, "game_rng_dataset: %s: %s\n", path, strerror(errno));
+        close(fd);
+        unlink(path);
+        return 1;
+    }
+    map = (unsigned char *)mmap(
+        NULL, (size_t)dataset->file_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0
+    );
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "game_rng_dataset: %s: mmap: %s\n", path, strerror(errno));
+        close(fd);
+        unlink(path);
+        return 1;
+    }
+    crng_dataset_advise(map, dataset->file_bytes);
+
+    memset(&work, 0, sizeof(work));
+    work.dataset = dataset;
+    work.map = map;
+    if (!crng_dataset_run(&work, threads)) {
+        fprintf(stderr, "game_rng_dataset: cannot start worker threads\n");
+        munmap(map, (size_t)dataset->file_bytes);
+        close(fd);
+        unlink(path);
+        return 1;
+    }
+    crng_dataset_encode_header(dataset, map);
+    munmap(map, (size_t)dataset->file_bytes);
+    close(fd);
+
+    printf("%s: %" PRIu64 " rows, %" PRIu32 " columns, %" PRIu64 " bytes, seed %" PRIu64 ", %s\n",
+           path,
+           dataset->rows,
+           dataset->column_count,
+           dataset->file_bytes,
+           dataset->seed,
+           crng_game_rng_algorithm_name(dataset->algorithm));
+    return 0;
+}
+
+static int crng_dataset_verify(const char *path, unsigned int threads) {
+    crng_dataset dataset;
+    crng_dataset_work work;
+    struct stat status;
+    unsigned char *map;
+    int result = 0;
+    int fd;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0 || fstat(fd, &status) != 0) {
+        fprintf(stderr, "game_rng_dataset: %s: %s\n", path, strerror(errno));
+        if (fd >= 0) {
+            close(fd);
+        }
+        return 1;
+    }
+    if ((uint64_t)status.st_size < CRNG_DATASET_HEADER_BYTES ||
+        (uint64_t)(size_t)status.st_size != (uint64_t)status.st_size) {
+        fprintf(stderr, "game_rng_dataset: %s: not a dataset\n", path);
+        close(fd);
+        return 1;
+    }
+    map = (unsigned char *)mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "game_rng_dataset: %s: mmap: %s\n", path, strerror(errno));
+        return 1;
+    }
+    if (!crng_dataset_decode_header(&dataset, map, (uint64_t)status.st_size)) {
+        fprintf(stderr, "game_rng_dataset: %s: not a dataset\n", path);
+        munmap(map, (size_t)status.st_size);
+        return 1;
+    }
+    crng_dataset_advise(map, (uint64_t)status.st_size);
+
+    memset(&work, 0, sizeof(work));
+    work.dataset = &dataset;
+    work.map = map;
+    work.verify = 1;
+    if (!crng_dataset_run(&work, threads) || work.failed < 0) {
+        fprintf(stderr, "game_rng_dataset: cannot start verification\n");
+        result = 1;
+    } else if (work.failed != 0) {
+        fprintf(stderr,
+                "game_rng_dataset: %s: column %" PRIu32 " differs from row %" PRIu64 "\n",
+                path,
+                work.failed_column,
+                work.failed_block * dataset.block_rows);
+        result = 1;
+    } else {
+        printf("%s: %" PRIu64 " rows, %" PRIu32 " columns, seed %" PRIu64 ", %s: verified\n",
+               path,
+               dataset.rows,
+               dataset.column_count,
+               dataset.seed,
+               crng_game_rng_algorithm_name(dataset.algorithm));
+    }
+    munmap(map, (size_t)status.st_size);
+    return result;
+}
+
+int main(int argc, char **argv) {
+    crng_dataset dataset;
+    const char *output = NULL;
+    const char *verify = NULL;
+    const char *columns = NULL;
+    uint64_t rows = 0;
+    uint64_t size = 0;
+    uint64_t threads = 0;
+    long online;
+    int argument;
+
+    memset(&dataset, 0, sizeof(dataset));
+    dataset.seed = UINT64_C(2026);
+    dataset.algorithm = CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_200;
+    dataset.block_rows = CRNG_DATASET_BLOCK_ROWS;
+
+    for (argument = 1; argument < argc; ++argument) {
+        if (strcmp(argv[argument], "--output") == 0 && argument + 1 < argc) {
+            output = argv[++argument];
+        } else if (strcmp(argv[argument], "--verify") == 0 && argument + 1 < argc) {
+            verify = argv[++argument];
+        } else if (strcmp(argv[argument], "--columns") == 0 && argument + 1 < argc) {
+            columns = argv[++argument];
+        } else if (strcmp(argv[argument], "--rows") == 0 && argument + 1 < argc) {
+            if (!crng_parse_u64(argv[++argument], &rows) || rows == 0) {
+                crng_dataset_usage(argv[0]);
+                return 2;
+            }
+        } else if (strcmp(argv[argument], "--size") == 0 && argument + 1 < argc) {
+            if (!crng_parse_u64(argv[++argument], &size) || size == 0) {
+                crng_dataset_usage(argv[0]);
+                return 2;
+            }
+        } else if (strcmp(argv[argument], "--seed") == 0 && argument + 1 < argc) {
+            if (!crng_parse_u64(argv[++argument], &dataset.seed)) {
+                crng_dataset_usage(argv[0]);
+                return 2;
+            }
+        } else if (strcmp(argv[argument], "--threads") == 0 && argument + 1 < argc) {
+            if (!crng_parse_u64(argv[++argument], &threads) || threads == 0 ||
+                threads > CRNG_DATASET_MAX_THREADS) {
+                crng_dataset_usage(argv[0]);
+                return 2;
+            }
+        } else if (strcmp(argv[argument], "--algorithm") == 0 && argument + 1 < argc) {
+            if (!crng_parse_algorithm(argv[++argument], &dataset.algorithm)) {
+                crng_dataset_usage(argv[0]);
+                return 2;
+            }
+        } else if (strcmp(argv[argument], "--help") == 0) {
+            crng_dataset_usage(argv[0]);
+            return 0;
+        } else {
+            crng_dataset_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (threads == 0) {
+        online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online < 1 ? 1U
+                  : (uint64_t)online > CRNG_DATASET_MAX_THREADS ? CRNG_DATASET_MAX_THREADS
+                                                                : (uint64_t)online;
+    }
+    if (verify != NULL) {
+        if (output != NULL || columns != NULL || rows != 0 || size != 0) {
+            crng_dataset_usage(argv[0]);
+            return 2;
+        }
+        return crng_dataset_verify(verify, (unsigned int)threads);
+    }
+
+    if (output == NULL || columns == NULL || (rows != 0) == (size != 0) ||
+        !crng_dataset_parse_columns(&dataset, columns)) {
+        crng_dataset_usage(argv[0]);
+        return 2;
+    }
+    if (rows != 0) {
+        dataset.rows = rows;
+        if (!crng_dataset_layout(&dataset)) {
+            fprintf(stderr, "game_rng_dataset: --rows too large\n");
+            return 2;
+        }
+    } else if (!crng_dataset_rows_for_size(&dataset, size)) {
+        fprintf(stderr,
+                "game_rng_dataset: --size must exceed %" PRIu64 " bytes for %" PRIu32 " columns\n",
+                CRNG_DATASET_ALIGNMENT * dataset.column_count,
+                dataset.column_count);
+        return 2;
+    }
+    return crng_dataset_create(output, &dataset, (unsigned int)threads);
+}
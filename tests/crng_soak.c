@@ -0,0 +1,348 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#  define _DEFAULT_SOURCE
+#endif
+
+#include "classical_rng.h"
+#include "test_utils/statistical_tests.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <pthread.h>
+#  include <unistd.h>
+#endif
+
+#define CRNG_SOAK_MAX_SHARDS 256U
+#define CRNG_SOAK_BLOCK_WORDS 4096U
+
+/*
+ * Soak driver for the streaming battery. Each shard runs its own generator
+ * stream and battery on its own thread; the counts are merged at the end so
+ * the reported p-values cover every word generated.
+ */
+typedef enum crng_soak_path {
+    CRNG_SOAK_NEXT_U64,
+    CRNG_SOAK_NEXT_U32,
+    CRNG_SOAK_FILL,
+    CRNG_SOAK_SECURE,
+    CRNG_SOAK_POOL
+} crng_soak_path;
+
+typedef struct crng_soak_shard {
+    crng_soak_path path;
+    uint64_t seed;
+    uint64_t words;
+    crng_test_battery *battery;
+    crng_status status;
+} crng_soak_shard;
+
+static const char *const crng_soak_path_names[] = {
+    "next_u64", "next_u32", "fill", "secure", "pool"
+};
+
+static uint64_t crng_soak_now_ns(void) {
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)counter.QuadPart / (uint64_t)frequency.QuadPart * UINT64_C(1000000000) +
+           (uint64_t)counter.QuadPart % (uint64_t)frequency.QuadPart * UINT64_C(1000000000) /
+               (uint64_t)frequency.QuadPart;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * UINT64_C(1000000000) + (uint64_t)now.tv_nsec;
+#endif
+}
+
+static unsigned int crng_soak_default_shards(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors == 0 ? 1U : (unsigned int)info.dwNumberOfProcessors;
+#else
+    const long online = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return online < 1 ? 1U : (unsigned int)online;
+#endif
+}
+
+static void crng_soak_load_words(uint64_t *words, const unsigned char *bytes, size_t count) {
+    size_t index;
+
+    for (index = 0; index < count; ++index) {
+        const unsigned char *word = bytes + index * 8U;
+
+        words[index] = (uint64_t)word[0] | (uint64_t)word[1] << 8 | (uint64_t)word[2] << 16 |
+                       (uint64_t)word[3] << 24 | (uint64_t)word[4] << 32 |
+                       (uint64_t)word[5] << 40 | (uint64_t)word[6] << 48 |
+                       (uint64_t)word[7] << 56;
+    }
+}
+
+static crng_status crng_soak_run_shard(crng_soak_shard *shard) {
+    uint64_t words[CRNG_SOAK_BLOCK_WORDS];
+    unsigned char bytes[CRNG_SOAK_BLOCK_WORDS * 8U];
+    crng_game_rng rng;
+    crng_secure_pool pool;
+    uint64_t remaining = shard->words;
+    crng_status status = CRNG_OK;
+
+    crng_game_rng_seed(&rng, shard->seed);
+    if (shard->path == CRNG_SOAK_POOL) {
+        status = crng_secure_pool_init(&pool);
+        if (status != CRNG_OK) {
+            return status;
+        }
+    }
+    while (remaining != 0 && status == CRNG_OK) {
+        const size_t count = remaining < CRNG_SOAK_BLOCK_WORDS ? (size_t)remaining
+                                                               : CRNG_SOAK_BLOCK_WORDS;
+        size_t index;
+
+        switch (shard->path) {
+        case CRNG_SOAK_NEXT_U64:
+            for (index = 0; index < count; ++index) {
+                words[index] = crng_game_rng_next_u64(&rng);
+            }
+            break;
+        case CRNG_SOAK_NEXT_U32:
+            for (index = 0; index < count; ++index) {
+                const uint64_t high = crng_game_rng_next_u32(&rng);
+
+                words[index] = high << 32 | crng_game_rng_next_u32(&rng);
+            }
+            break;
+        case CRNG_SOAK_FILL:
+            status = crng_game_rng_fill(&rng, bytes, count * 8U);
+            crng_soak_load_words(words, bytes, count);
+            break;
+        case CRNG_SOAK_SECURE:
+            status = crng_secure_bytes(bytes, count * 8U);
+            crng_soak_load_words(words, bytes, count);
+            break;
+        case CRNG_SOAK_POOL:
+            status = crng_secure_pool_bytes(&pool, bytes, count * 8U);
+            crng_soak_load_words(words, bytes, count);
+            break;
+        }
+        crng_test_battery_update(shard->battery, words, count);
+        remaining -= count;
+    }
+    if (shard->path == CRNG_SOAK_POOL) {
+        crng_secure_pool_wipe(&pool);
+    }
+    return status;
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI crng_soak_thread(LPVOID argument) {
+    crng_soak_shard *shard = (crng_soak_shard *)argument;
+
+    shard->status = crng_soak_run_shard(shard);
+    return 0;
+}
+#else
+static void *crng_soak_thread(void *argument) {
+    crng_soak_shard *shard = (crng_soak_shard *)argument;
+
+    shard->status = crng_soak_run_shard(shard);
+    return NULL;
+}
+#endif
+
+/* Runs shards 1..count-1 on new threads and shard 0 on the calling thread. */
+static int crng_soak_run_all(crng_soak_shard *shards, unsigned int count) {
+#if defined(_WIN32)
+    HANDLE threads[CRNG_SOAK_MAX_SHARDS];
+#else
+    pthread_t threads[CRNG_SOAK_MAX_SHARDS];
+#endif
+    unsigned int started;
+    unsigned int index;
+    int result = 1;
+
+    for (started = 1; started < count; ++started) {
+#if defined(_WIN32)
+        threads[started] = CreateThread(NULL, 0, crng_soak_thread, &shards[started], 0, NULL);
+        if (threads[started] == NULL) {
+            result = 0;
+            break;
+        }
+#else
+        if (pthread_create(&threads[started], NULL, crng_soak_thread, &shards[started]) != 0) {
+            result = 0;
+            break;
+        }
+#endif
+    }
+    if (result) {
+        shards[0].status = crng_soak_run_shard(&shards[0]);
+    }
+    for (index = 1; index < started; ++index) {
+#if defined(_WIN32)
+        WaitForSingleObject(threads[index], INFINITE);
+        CloseHandle(threads[index]);
+#else
+        pthread_join(threads[index], NULL);
+#endif
+    }
+    return result;
+}
+
+static void crng_soak_usage(const char *program) {
+    fprintf(stderr,
+            "usage: %s [--words N] [--shards N] [--seed N] [--alpha P]\n"
+            "       [--path next_u64|next_u32|fill|secure|pool]\n",
+            program);
+}
+
+static int crng_soak_parse_u64(const char *text, uint64_t *out) {
+    char *end = NULL;
+    unsigned long long value;
+
+    if (text[0] == '-') {
+        return 0;
+    }
+    errno = 0;
+    value = strtoull(text, &end, 0);
+    if (errno != 0 || end == text || *end != '\0') {
+        return 0;
+    }
+    *out = (uint64_t)value;
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    crng_test_result results[CRNG_TEST_BATTERY_TESTS];
+    crng_soak_shard shards[CRNG_SOAK_MAX_SHARDS];
+    crng_test_battery *batteries;
+    crng_soak_path path = CRNG_SOAK_NEXT_U64;
+    uint64_t words = UINT64_C(1) << 24;
+    uint64_t seed = 1;
+    uint64_t value;
+    uint64_t started;
+    double seconds;
+    double alpha = 1e-6;
+    unsigned int shard_count = crng_soak_default_shards();
+    unsigned int index;
+    int argument;
+    int exit_code = 0;
+
+    for (argument = 1; argument < argc; ++argument) {
+        if (strcmp(argv[argument], "--words") == 0 && argument + 1 < argc) {
+            if (!crng_soak_parse_u64(argv[++argument], &words) || words == 0) {
+                crng_soak_usage(argv[0]);
+                return 2;
+            }
+        } else if (strcmp(argv[argument], "--shards") == 0 && argument + 1 < argc) {
+            if (!crng_soak_parse_u64(argv[++argument], &value) || value == 0 ||
+                value > CRNG_SOAK_MAX_SHARDS) {
+                crng_soak_usage(argv[0]);
+                return 2;
+            }
+            shard_count = (unsigned int)value;
+        } else if (strcmp(argv[argument], "--seed") == 0 && argument + 1 < argc) {
+            if (!crng_soak_parse_u64(argv[++argument], &seed)) {
+                crng_soak_usage(argv[0]);
+                return 2;
+            }
+        } else if (strcmp(argv[argument], "--alpha") == 0 && argument + 1 < argc) {
+            char *end = NULL;
+
+            alpha = strtod(argv[++argument], &end);
+            if (end == argv[argument] || *end != '\0' || !(alpha > 0.0 && alpha < 0.5)) {
+                crng_soak_usage(argv[0]);
+                return 2;
+            }
+        } else if (strcmp(argv[argument], "--path") == 0 && argument + 1 < argc) {
+            const char *name = argv[++argument];
+            size_t candidate;
+
+            for (candidate = 0;
+                 candidate < sizeof(crng_soak_path_names) / sizeof(crng_soak_path_names[0]);
+                 ++candidate) {
+                if (strcmp(name, crng_soak_path_names[candidate]) == 0) {
+                    break;
+                }
+            }
+            if (candidate == sizeof(crng_soak_path_names) / sizeof(crng_soak_path_names[0])) {
+                crng_soak_usage(argv[0]);
+                return 2;
+            }
+            path = (crng_soak_path)candidate;
+        } else if (strcmp(argv[argument], "--help") == 0) {
+            crng_soak_usage(argv[0]);
+            return 0;
+        } else {
+            crng_soak_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (shard_count > CRNG_SOAK_MAX_SHARDS) {
+        shard_count = CRNG_SOAK_MAX_SHARDS;
+    }
+    if ((uint64_t)shard_count > words) {
+        shard_count = (unsigned int)words;
+    }
+
+    batteries = (crng_test_battery *)malloc(sizeof(*batteries) * shard_count);
+    if (batteries == NULL) {
+        fprintf(stderr, "crng_soak: out of memory\n");
+        return 3;
+    }
+    /* Shard i takes seed + i and an equal share of the words. */
+    for (index = 0; index < shard_count; ++index) {
+        crng_test_battery_reset(&batteries[index]);
+        shards[index].path = path;
+        shards[index].seed = seed + index;
+        shards[index].words = words / shard_count + (index < words % shard_count ? 1U : 0U);
+        shards[index].battery = &batteries[index];
+        shards[index].status = CRNG_OK;
+    }
+
+    started = crng_soak_now_ns();
+    if (!crng_soak_run_all(shards, shard_count)) {
+        fprintf(stderr, "crng_soak: could not start shard threads\n");
+        free(batteries);
+        return 3;
+    }
+    seconds = (double)(crng_soak_now_ns() - started) / 1e9;
+    for (index = 0; index < shard_count; ++index) {
+        if (shards[index].status != CRNG_OK) {
+            fprintf(stderr, "crng_soak: shard %u: %s\n", index,
+                    crng_status_string(shards[index].status));
+            free(batteries);
+            return 3;
+        }
+        if (index != 0) {
+            crng_test_battery_merge(&batteries[0], &batteries[index]);
+        }
+    }
+
+    crng_test_battery_finish(&batteries[0], results);
+    printf("{\"schema\":\"classical_rng-soak-1\",\"path\":\"%s\",\"seed\":%" PRIu64
+           ",\"words\":%" PRIu64 ",\"shards\":%u,\"seconds\":%.3f,\"words_per_second\":%.4g,",
+           crng_soak_path_names[path], seed, words, shard_count, seconds,
+           seconds > 0.0 ? (double)words / seconds : 0.0);
+    crng_test_battery_print_json(results, alpha);
+    printf("}\n");
+    if (!crng_test_battery_passed(results, alpha)) {
+        exit_code = 1;
+    }
+    free(batteries);
+    return exit_code;
+}
@@ -1,8 +1,20 @@
+#if defined(_MSC_VER) && !defined(_CRT_SECURE_NO_WARNINGS)
+#  define _CRT_SECURE_NO_WARNINGS /* fopen is used portably here. */
+#endif
+
 #include "classical_rng.h"
+#include "../src/crypto_rng/chacha20.h"
 
 #include <limits.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
+
+#if !defined(_WIN32)
+#  include <sys/types.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
 
 static int failures = 0;
 static int checks = 0;
@@ -154,6 +166,252 @@ static void test_floating_point(void) {
     }
 }
 
+static void test_state_records(void) {
+    /* Seed 1 after three draws; the CRC matches zlib's crc32 of bytes 0-43. */
+    static const unsigned char expected[CRNG_GAME_RNG_RECORD_BYTES] = {
+        0x43, 0x47, 0x01, 0x01, 0x3d, 0xf2, 0xf0, 0x18,
+        0x81, 0xf7, 0xe6, 0xec, 0xd4, 0x48, 0x58, 0x88,
+        0x45, 0x90, 0xcb, 0xdf, 0x1e, 0xdd, 0x42, 0x1c,
+        0x39, 0x8f, 0x81, 0xe4, 0x9c, 0x49, 0x43, 0x29,
+        0x23, 0x3c, 0xe2, 0xcb, 0x03, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0xe5, 0x08, 0x1c, 0x77
+    };
+    unsigned char record[CRNG_GAME_RNG_RECORD_BYTES];
+    unsigned char records[3 * CRNG_GAME_RNG_RECORD_BYTES];
+    crng_game_rng original[3];
+    crng_game_rng restored[3];
+    crng_game_rng untouched;
+    crng_roundoff_sample sample;
+    size_t index;
+
+    crng_game_rng_seed(&original[0], UINT64_C(1));
+    for (index = 0; index < 3; ++index) {
+        (void)crng_game_rng_next_u64(&original[0]);
+    }
+    CHECK(crng_game_rng_serialize(&original[0], record) == CRNG_OK);
+    CHECK(memcmp(record, expected, sizeof(expected)) == 0);
+    CHECK(crng_game_rng_deserialize(&restored[0], record) == CRNG_OK);
+    CHECK(restored[0].step == 3U);
+    CHECK(crng_game_rng_last_roundoff(&restored[0], &sample) == CRNG_OK);
+    CHECK(sample.step == 0U && sample.mixed_residue == 0U);
+    CHECK(crng_game_rng_next_u64(&restored[0]) == UINT64_C(0x00b2ccd9528e7e96));
+    CHECK(crng_game_rng_next_u64(&original[0]) == UINT64_C(0x00b2ccd9528e7e96));
+    for (index = 0; index < 100; ++index) {
+        CHECK(crng_game_rng_next_u64(&original[0]) == crng_game_rng_next_u64(&restored[0]));
+    }
+
+    CHECK(crng_game_rng_serialize(NULL, record) == CRNG_ERR_NULL);
+    CHECK(crng_game_rng_serialize(&original[0], NULL) == CRNG_ERR_NULL);
+    CHECK(crng_game_rng_deserialize(&restored[0], NULL) == CRNG_ERR_NULL);
+    CHECK(crng_game_rng_serialize_array(NULL, NULL, 0) == CRNG_OK);
+    CHECK(crng_game_rng_serialize_array(original, records, SIZE_MAX / 16U) ==
+          CRNG_ERR_INVALID_RANGE);
+
+    /* Tag, revision, payload, and checksum damage are all refused. */
+    crng_game_rng_seed(&untouched, UINT64_C(5));
+    restored[1] = untouched;
+    for (index = 0; index < CRNG_GAME_RNG_RECORD_BYTES; ++index) {
+        memcpy(record, expected, sizeof(record));
+        record[index] ^= 0x10U;
+        CHECK(crng_game_rng_deserialize(&restored[1], record) == CRNG_ERR_FORMAT);
+    }
+    CHECK(memcmp(restored[1].state, untouched.state, sizeof(untouched.state)) == 0);
+    restored[2] = untouched;
+    memset(restored[2].state, 0, sizeof(restored[2].state));
+    CHECK(crng_game_rng_serialize(&restored[2], record) == CRNG_OK);
+    CHECK(crng_game_rng_deserialize(&restored[1], record) == CRNG_ERR_FORMAT);
+
+    for (index = 0; index < 3; ++index) {
+        crng_game_rng_seed(&original[index], UINT64_C(100) + index);
+        (void)crng_game_rng_next_u64(&original[index]);
+        restored[index] = untouched;
+    }
+    CHECK(crng_game_rng_serialize_array(original, records, 3) == CRNG_OK);
+    records[2 * CRNG_GAME_RNG_RECORD_BYTES + 40] ^= 1U;
+    CHECK(crng_game_rng_deserialize_array(restored, records, 3) == CRNG_ERR_FORMAT);
+    CHECK(restored[0].step == untouched.step && restored[0].state[0] == untouched.state[0]);
+    records[2 * CRNG_GAME_RNG_RECORD_BYTES + 40] ^= 1U;
+    CHECK(crng_game_rng_deserialize_array(restored, records, 3) == CRNG_OK);
+    for (index = 0; index < 3; ++index) {
+        CHECK(crng_game_rng_next_u64(&original[index]) == crng_game_rng_next_u64(&restored[index]));
+    }
+}
+
+static int same_position(const crng_game_rng *a, const crng_game_rng *b) {
+    return memcmp(a->state, b->state, sizeof(a->state)) == 0 && a->step == b->step &&
+           memcmp(&a->last_roundoff, &b->last_roundoff, sizeof(a->last_roundoff)) == 0;
+}
+
+static void test_reverse_stepping(void) {
+    enum { STEPS = 64 };
+    static crng_game_rng history[STEPS + 1];
+    uint64_t outputs[STEPS];
+    unsigned char record[CRNG_GAME_RNG_RECORD_BYTES];
+    crng_game_rng rng;
+    crng_game_rng restored;
+    size_t index;
+
+    crng_game_rng_seed(&rng, UINT64_C(0x5eed));
+    history[0] = rng;
+    for (index = 0; index < STEPS; ++index) {
+        outputs[index] = crng_game_rng_next_u64(&rng);
+        history[index + 1] = rng;
+    }
+
+    /* Each undo returns the undone output and restores the earlier object. */
+    for (index = STEPS; index > STEPS / 2; --index) {
+        CHECK(crng_game_rng_prev_u64(&rng) == outputs[index - 1]);
+        CHECK(same_position(&rng, &history[index - 1]));
+    }
+    CHECK(crng_game_rng_next_u64(&rng) == outputs[STEPS / 2]);
+    CHECK(same_position(&rng, &history[STEPS / 2 + 1]));
+
+    CHECK(crng_game_rng_rewind(&rng, 0) == CRNG_OK);
+    CHECK(same_position(&rng, &history[STEPS / 2 + 1]));
+    CHECK(crng_game_rng_rewind(&rng, STEPS / 2 + 2) == CRNG_ERR_INVALID_RANGE);
+    CHECK(same_position(&rng, &history[STEPS / 2 + 1]));
+    CHECK(crng_game_rng_rewind(NULL, 1) == CRNG_ERR_NULL);
+    CHECK(crng_game_rng_rewind(&rng, 10) == CRNG_OK);
+    CHECK(same_position(&rng, &history[STEPS / 2 - 9]));
+    CHECK(crng_game_rng_rewind(&rng, STEPS / 2 - 9) == CRNG_OK);
+    CHECK(same_position(&rng, &history[0]));
+    CHECK(crng_game_rng_prev_u64(&rng) == 0U);
+    CHECK(same_position(&rng, &history[0]));
+
+    /* A restored record has no sample yet; undo recomputes it. */
+    CHECK(crng_game_rng_serialize(&history[STEPS], record) == CRNG_OK);
+    CHECK(crng_game_rng_deserialize(&restored, record) == CRNG_OK);
+    CHECK(crng_game_rng_prev_u64(&restored) == outputs[STEPS - 1]);
+    CHECK(same_position(&restored, &history[STEPS - 1]));
+}
+
+/* Reference xoshiro256** seeded by splitmix64, written from the published algorithm. */
+static uint64_t reference_rotl(uint64_t value, unsigned int shift) {
+    return (value << shift) | (value >> (64U - shift));
+}
+
+static uint64_t reference_xoshiro256ss(uint64_t state[4]) {
+    const uint64_t result = reference_rotl(state[1] * 5U, 7U) * 9U;
+    const uint64_t shifted = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= shifted;
+    state[3] = reference_rotl(state[3], 45U);
+    return result;
+}
+
+static void test_algorithm_tiers(void) {
+    static const uint64_t expected[3][4] = {
+        {UINT64_C(0xbdfd01ff6a8c2511), UINT64_C(0x6ab3566f9b72364d),
+         UINT64_C(0xe5ba6e07554a49ab), UINT64_C(0x00b2ccd9528e7e96)},
+        {UINT64_C(0x557ec9c9b4e45b02), UINT64_C(0xc51015f2a693ea23),
+         UINT64_C(0x52e7f18fa4978afb), UINT64_C(0xddf814bf870033d8)},
+        {UINT64_C(0xb3f2af6d0fc710c5), UINT64_C(0x853b559647364cea),
+         UINT64_C(0x92f89756082a4514), UINT64_C(0x642e1c7bc266a3a7)}
+    };
+    static const crng_game_rng_algorithm algorithms[3] = {
+        CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_200,
+        CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_18,
+        CRNG_GAME_RNG_ALGORITHM_XOSHIRO256SS
+    };
+    unsigned char record[CRNG_GAME_RNG_RECORD_BYTES];
+    unsigned char records[3 * CRNG_GAME_RNG_RECORD_BYTES];
+    crng_game_rng tiers[3];
+    crng_game_rng restored[3];
+    crng_game_rng rng;
+    crng_game_rng untouched;
+    crng_roundoff_sample sample;
+    uint64_t reference[4];
+    uint64_t seed = 1U;
+    uint64_t value = 0;
+    size_t tier;
+    size_t index;
+
+    /* Known answers for seed 1; the default seed is the first tier. */
+    for (tier = 0; tier < 3; ++tier) {
+        CHECK(crng_game_rng_seed_algorithm(&rng, UINT64_C(1), algorithms[tier]) == CRNG_OK);
+        CHECK(rng.algorithm == algorithms[tier]);
+        for (index = 0; index < 4; ++index) {
+            CHECK(crng_game_rng_next_u64(&rng) == expected[tier][index]);
+        }
+    }
+    crng_game_rng_seed(&rng, UINT64_C(1));
+    CHECK(rng.algorithm == CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_200);
+    CHECK(CRNG_GAME_RNG_ALGORITHM_REVISION == CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_200);
+
+    /* The reduced tier divides the 19-digit truncations of pi and e. */
+    CHECK(crng_game_rng_seed_algorithm(&rng, UINT64_C(1), CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_18) ==
+          CRNG_OK);
+    CHECK(rng.pi.fractional_digits == 18U && rng.e.fractional_digits == 18U);
+    (void)crng_game_rng_next_u64(&rng);
+    CHECK(crng_game_rng_last_roundoff(&rng, &sample) == CRNG_OK);
+    CHECK(sample.pi.divisor == UINT32_C(3772506329));
+    CHECK(sample.pi.remainder == UINT64_C(3141592653589793238) % sample.pi.divisor);
+    CHECK(sample.e.divisor == UINT32_C(1911668157));
+    CHECK(sample.e.remainder == UINT64_C(2718281828459045235) % sample.e.divisor);
+    CHECK(sample.mixed_residue == UINT64_C(0xcc40bc962153638c));
+
+    /* Plain xoshiro256** is the published generator and records no sample. */
+    for (index = 0; index < 4; ++index) {
+        uint64_t mixed = (seed += UINT64_C(0x9e3779b97f4a7c15));
+        mixed = (mixed ^ (mixed >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+        mixed = (mixed ^ (mixed >> 27)) * UINT64_C(0x94d049bb133111eb);
+        reference[index] = mixed ^ (mixed >> 31);
+    }
+    CHECK(crng_game_rng_seed_algorithm(&rng, UINT64_C(1), CRNG_GAME_RNG_ALGORITHM_XOSHIRO256SS) ==
+          CRNG_OK);
+    for (index = 0; index < 10000; ++index) {
+        CHECK(crng_game_rng_next_u64(&rng) == reference_xoshiro256ss(reference));
+    }
+    CHECK(crng_game_rng_last_roundoff(&rng, &sample) == CRNG_OK);
+    CHECK(sample.step == 0U && sample.mixed_residue == 0U);
+    CHECK(crng_game_rng_prev_u64(&rng) != 0U);
+    CHECK(crng_game_rng_rewind(&rng, 9998U) == CRNG_OK);
+    CHECK(rng.step == 1U);
+    CHECK(crng_game_rng_prev_u64(&rng) == expected[2][0]);
+    CHECK(crng_game_rng_next_u64(&rng) == expected[2][0]);
+
+    /* Unknown identifiers are refused without touching the generator. */
+    crng_game_rng_seed(&untouched, UINT64_C(5));
+    rng = untouched;
+    CHECK(crng_game_rng_seed_algorithm(&rng, 1U, (crng_game_rng_algorithm)0) ==
+          CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_game_rng_seed_algorithm(&rng, 1U, (crng_game_rng_algorithm)4) ==
+          CRNG_ERR_INVALID_RANGE);
+    CHECK(same_position(&rng, &untouched));
+    CHECK(crng_game_rng_seed_algorithm(NULL, 1U, CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_18) ==
+          CRNG_ERR_NULL);
+    CHECK(strcmp(crng_game_rng_algorithm_name(CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_200),
+                 "roundoff-200") == 0);
+    CHECK(strcmp(crng_game_rng_algorithm_name(CRNG_GAME_RNG_ALGORITHM_ROUNDOFF_18),
+                 "roundoff-18") == 0);
+    CHECK(strcmp(crng_game_rng_algorithm_name(CRNG_GAME_RNG_ALGORITHM_XOSHIRO256SS),
+                 "xoshiro256**") == 0);
+    CHECK(strcmp(crng_game_rng_algorithm_name((crng_game_rng_algorithm)9), "unknown") == 0);
+
+    /* Records carry each tier, and a mixed batch restores every stream. */
+    for (tier = 0; tier < 3; ++tier) {
+        CHECK(crng_game_rng_seed_algorithm(&tiers[tier], UINT64_C(1), algorithms[tier]) == CRNG_OK);
+        CHECK(crng_game_rng_uniform_u64(&tiers[tier], 6U, &value) == CRNG_OK);
+        CHECK(crng_game_rng_serialize(&tiers[tier], record) == CRNG_OK);
+        CHECK(record[3] == (unsigned char)algorithms[tier]);
+        restored[tier] = untouched;
+    }
+    CHECK(crng_game_rng_serialize_array(tiers, records, 3) == CRNG_OK);
+    CHECK(crng_game_rng_deserialize_array(restored, records, 3) == CRNG_OK);
+    for (tier = 0; tier < 3; ++tier) {
+        CHECK(restored[tier].algorithm == algorithms[tier]);
+        CHECK(restored[tier].pi.used == tiers[tier].pi.used);
+        CHECK(crng_game_rng_prev_u64(&restored[tier]) == crng_game_rng_prev_u64(&tiers[tier]));
+        for (index = 0; index < 4; ++index) {
+            CHECK(crng_game_rng_next_u64(&restored[tier]) == expected[tier][index]);
+        }
+    }
+}
+
 static void test_operating_system_randomness(void) {
     crng_game_rng automatic;
     unsigned char first[32] = {0};
@@ -178,6 +436,358 @@ static void test_operating_system_randomness(void) {
     CHECK(crng_game_rng_seed_auto(NULL) == CRNG_ERR_NULL);
 }
 
+static void test_secure_batches(void) {
+    enum { DRAWS = 600 };
+    uint64_t bounded[DRAWS];
+    int32_t signed_values[DRAWS];
+    uint64_t counts[6] = {0};
+    int saw_negative = 0;
+    int saw_nonnegative = 0;
+    size_t index;
+
+    CHECK(crng_secure_uniform_u64_array(6, NULL, 0) == CRNG_OK);
+    CHECK(crng_secure_uniform_u64_array(6, NULL, 1) == CRNG_ERR_NULL);
+    CHECK(crng_secure_uniform_u64_array(0, bounded, 1) == CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_secure_uniform_u64_array(1, bounded, 3) == CRNG_OK);
+    CHECK(bounded[0] == 0 && bounded[1] == 0 && bounded[2] == 0);
+
+    /* More than one batch, so the refill path is exercised. */
+    CHECK(crng_secure_uniform_u64_array(6, bounded, DRAWS) == CRNG_OK);
+    for (index = 0; index < DRAWS; ++index) {
+        CHECK(bounded[index] < 6U);
+        if (bounded[index] < 6U) {
+            ++counts[bounded[index]];
+        }
+    }
+    for (index = 0; index < 6; ++index) {
+        CHECK(counts[index] > 0U);
+    }
+    CHECK(crng_secure_uniform_u64_array(UINT64_C(0x8000000000000001), bounded, DRAWS) == CRNG_OK);
+    for (index = 0; index < DRAWS; ++index) {
+        CHECK(bounded[index] < UINT64_C(0x8000000000000001));
+    }
+
+    CHECK(crng_secure_range_i32_array(0, 1, NULL, 0) == CRNG_OK);
+    CHECK(crng_secure_range_i32_array(0, 1, NULL, 2) == CRNG_ERR_NULL);
+    CHECK(crng_secure_range_i32_array(9, 4, signed_values, 2) == CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_secure_range_i32_array(-20, -10, signed_values, DRAWS) == CRNG_OK);
+    for (index = 0; index < DRAWS; ++index) {
+        CHECK(signed_values[index] >= -20 && signed_values[index] <= -10);
+    }
+    CHECK(crng_secure_range_i32_array(INT32_MIN, INT32_MAX, signed_values, DRAWS) == CRNG_OK);
+    for (index = 0; index < DRAWS; ++index) {
+        saw_negative |= signed_values[index] < 0;
+        saw_nonnegative |= signed_values[index] >= 0;
+    }
+    CHECK(saw_negative);
+    CHECK(saw_nonnegative);
+}
+
+static void test_secure_token(void) {
+    enum { SYMBOLS = 62, PER_SYMBOL = 2000, TOKENS = 300, TOKEN_LENGTH = 22 };
+    static char text[SYMBOLS * PER_SYMBOL];
+    static const size_t lengths[] = {2, 3, 7, 10, 16, 32, 36, 62, 64, 200, 255, 256};
+    char alphabet[256];
+    char sentinel[4] = {'x', 'x', 'x', 'x'};
+    uint64_t counts[256];
+    size_t index;
+    size_t case_index;
+
+    for (index = 0; index < sizeof(alphabet); ++index) {
+        alphabet[index] = (char)(unsigned char)index;
+    }
+    CHECK(crng_secure_token(CRNG_TOKEN_HEX, 16, NULL, 0) == CRNG_OK);
+    CHECK(crng_secure_token(NULL, 16, text, 4) == CRNG_ERR_NULL);
+    CHECK(crng_secure_token(CRNG_TOKEN_HEX, 16, NULL, 4) == CRNG_ERR_NULL);
+    CHECK(crng_secure_token("a", 1, sentinel, 4) == CRNG_ERR_INVALID_RANGE);
+    CHECK(sentinel[0] == 0 && sentinel[3] == 0);
+    CHECK(crng_secure_token(alphabet, 257, text, 4) == CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_secure_token_array(CRNG_TOKEN_HEX, 16, text, SIZE_MAX / 2U, 3) ==
+          CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_secure_token_array(CRNG_TOKEN_HEX, 16, NULL, 8, 0) == CRNG_OK);
+
+    /* Every alphabet size class: fields, digit groups, and the full byte set. */
+    for (case_index = 0; case_index < sizeof(lengths) / sizeof(lengths[0]); ++case_index) {
+        const size_t length = lengths[case_index];
+        const size_t draws = length * 40U;
+        size_t seen = 0;
+
+        memset(counts, 0, sizeof(counts));
+        CHECK(crng_secure_token(alphabet, length, text, draws) == CRNG_OK);
+        for (index = 0; index < draws; ++index) {
+            const unsigned char symbol = (unsigned char)text[index];
+
+            CHECK(symbol < length);
+            if (counts[symbol]++ == 0) {
+                ++seen;
+            }
+        }
+        CHECK(seen == length);
+    }
+
+    /* Base62 takes ten digits per accepted word; expected 2000 per symbol. */
+    memset(counts, 0, sizeof(counts));
+    CHECK(crng_secure_token(CRNG_TOKEN_ALPHANUMERIC, SYMBOLS, text, sizeof(text)) == CRNG_OK);
+    for (index = 0; index < sizeof(text); ++index) {
+        const char *found = (const char *)memchr(CRNG_TOKEN_ALPHANUMERIC, text[index], SYMBOLS);
+
+        CHECK(found != NULL);
+        if (found != NULL) {
+            ++counts[found - CRNG_TOKEN_ALPHANUMERIC];
+        }
+    }
+    for (index = 0; index < SYMBOLS; ++index) {
+        CHECK(counts[index] > 1600U && counts[index] < 2400U);
+    }
+
+    CHECK(crng_secure_token_array(CRNG_TOKEN_BASE64URL, 64, text, TOKEN_LENGTH, TOKENS) ==
+          CRNG_OK);
+    for (index = 0; index < TOKEN_LENGTH * TOKENS; ++index) {
+        CHECK(memchr(CRNG_TOKEN_BASE64URL, text[index], 64) != NULL);
+    }
+    for (index = 1; index < TOKENS; ++index) {
+        CHECK(memcmp(text, text + index * TOKEN_LENGTH, TOKEN_LENGTH) != 0);
+    }
+    CHECK(crng_secure_token(CRNG_TOKEN_BASE32, 32, text, 26) == CRNG_OK);
+    for (index = 0; index < 26; ++index) {
+        CHECK(memchr(CRNG_TOKEN_BASE32, text[index], 32) != NULL);
+    }
+}
+
+static void test_secure_uuid(void) {
+    enum { UUIDS = 5000 };
+    static unsigned char uuids[UUIDS * CRNG_UUID_BYTES];
+    static char text[UUIDS * CRNG_UUID_STRING_LENGTH];
+    static const unsigned char known[CRNG_UUID_BYTES] = {
+        0x01, 0x7f, 0x22, 0xe2, 0x79, 0xb0, 0x7c, 0xc3,
+        0x98, 0xc4, 0xdc, 0x0c, 0x0c, 0x07, 0x39, 0x8f
+    };
+    unsigned char previous[CRNG_UUID_BYTES];
+    unsigned char sentinel[CRNG_UUID_BYTES];
+    char hex[3];
+    uint64_t unix_ms;
+    size_t index;
+    size_t position;
+
+    CHECK(crng_secure_uuid_v4_array(NULL, 0) == CRNG_OK);
+    CHECK(crng_secure_uuid_v4_array(NULL, 1) == CRNG_ERR_NULL);
+    CHECK(crng_secure_uuid_v7_array(NULL, 1) == CRNG_ERR_NULL);
+    CHECK(crng_secure_uuid_v4_array(uuids, SIZE_MAX / 8U) == CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_uuid_format_array(NULL, text, 1) == CRNG_ERR_NULL);
+    CHECK(crng_uuid_format_array(uuids, NULL, 0) == CRNG_OK);
+
+    /* RFC 9562 appendix A.6 example. */
+    CHECK(crng_uuid_format_array(known, text, 1) == CRNG_OK);
+    CHECK(memcmp(text, "017f22e2-79b0-7cc3-98c4-dc0c0c07398f", CRNG_UUID_STRING_LENGTH) == 0);
+
+    CHECK(crng_secure_uuid_v4_array(uuids, UUIDS) == CRNG_OK);
+    for (index = 0; index < UUIDS; ++index) {
+        const unsigned char *uuid = uuids + index * CRNG_UUID_BYTES;
+
+        CHECK((uuid[6] & 0xf0U) == 0x40U);
+        CHECK((uuid[8] & 0xc0U) == 0x80U);
+    }
+    CHECK(memcmp(uuids, uuids + CRNG_UUID_BYTES, CRNG_UUID_BYTES) != 0);
+
+    /* Strictly increasing within a batch and across calls. */
+    CHECK(crng_secure_uuid_v7_array(previous, 1) == CRNG_OK);
+    CHECK(crng_secure_uuid_v7_array(uuids, UUIDS) == CRNG_OK);
+    CHECK(memcmp(previous, uuids, CRNG_UUID_BYTES) < 0);
+    for (index = 0; index < UUIDS; ++index) {
+        const unsigned char *uuid = uuids + index * CRNG_UUID_BYTES;
+
+        CHECK((uuid[6] & 0xf0U) == 0x70U);
+        CHECK((uuid[8] & 0xc0U) == 0x80U);
+        if (index != 0) {
+            CHECK(memcmp(uuid - CRNG_UUID_BYTES, uuid, CRNG_UUID_BYTES) < 0);
+        }
+    }
+    unix_ms = 0;
+    for (index = 0; index < 6; ++index) {
+        unix_ms = unix_ms << 8 | uuids[index];
+    }
+    /* Later than 2025-01-01 and no further ahead than the batch itself. */
+    CHECK(unix_ms > UINT64_C(1735689600000));
+    CHECK(unix_ms <= (uint64_t)time(NULL) * 1000U + 2000U);
+    CHECK(crng_secure_uuid_v7_array(previous, 1) == CRNG_OK);
+    CHECK(memcmp(uuids + (UUIDS - 1) * CRNG_UUID_BYTES, previous, CRNG_UUID_BYTES) < 0);
+
+    CHECK(crng_uuid_format_array(uuids, text, UUIDS) == CRNG_OK);
+    for (index = 0; index < UUIDS; ++index) {
+        const char *uuid_text = text + index * CRNG_UUID_STRING_LENGTH;
+
+        for (position = 0; position < CRNG_UUID_BYTES; ++position) {
+            const size_t offset = position * 2U + (position >= 4U) + (position >= 6U) +
+                                  (position >= 8U) + (position >= 10U);
+
+            snprintf(hex, sizeof(hex), "%02x",
+                     (unsigned int)uuids[index * CRNG_UUID_BYTES + position]);
+            CHECK(memcmp(uuid_text + offset, hex, 2) == 0);
+        }
+        CHECK(uuid_text[8] == '-' && uuid_text[13] == '-' && uuid_text[18] == '-' &&
+              uuid_text[23] == '-');
+    }
+    memset(sentinel, 0xff, sizeof(sentinel));
+    CHECK(crng_uuid_format_array(sentinel, text, 1) == CRNG_OK);
+    CHECK(memcmp(text, "ffffffff-ffff-ffff-ffff-ffffffffffff", CRNG_UUID_STRING_LENGTH) == 0);
+}
+
+static void test_secure_backend(void) {
+    const crng_secure_backend backend = crng_secure_backend_active();
+    unsigned char bytes[3];
+
+    CHECK(backend >= CRNG_SECURE_BACKEND_BCRYPT);
+    CHECK(backend <= CRNG_SECURE_BACKEND_URANDOM);
+    CHECK(crng_secure_backend_active() == backend);
+    CHECK(strcmp(crng_secure_backend_name(backend), "unknown") != 0);
+    CHECK(strcmp(crng_secure_backend_name(CRNG_SECURE_BACKEND_URANDOM),
+                 "/dev/urandom") == 0);
+    CHECK(strcmp(crng_secure_backend_name((crng_secure_backend)99), "unknown") == 0);
+#if defined(_WIN32)
+    CHECK(backend == CRNG_SECURE_BACKEND_BCRYPT);
+#elif defined(__APPLE__)
+    CHECK(backend == CRNG_SECURE_BACKEND_ARC4RANDOM);
+#endif
+    /* Small odd-sized requests take the same cached path as word requests. */
+    CHECK(crng_secure_bytes(bytes, sizeof(bytes)) == CRNG_OK);
+    CHECK(crng_secure_bytes(bytes, 1) == CRNG_OK);
+}
+
+/* Both ChaCha20 block functions, against RFC 8439 and each other. */
+static void test_chacha20_blocks(void) {
+    /* RFC 8439 section 2.3.2: key 00..1f, counter 1. */
+    static const uint32_t nonce[3] = {UINT32_C(0x09000000), UINT32_C(0x4a000000), 0};
+    static const unsigned char expected[CRNG_CHACHA20_BLOCK_BYTES] = {
+        0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15,
+        0x50, 0x0f, 0xdd, 0x1f, 0xa3, 0x20, 0x71, 0xc4,
+        0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0, 0x68, 0x03,
+        0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e,
+        0xd2, 0x82, 0x64, 0x46, 0x07, 0x9f, 0xaa, 0x09,
+        0x14, 0xc2, 0xd7, 0x05, 0xd9, 0x8b, 0x02, 0xa2,
+        0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e, 0xb9,
+        0xcb, 0xd0, 0x83, 0xe8, 0xa2, 0x50, 0x3c, 0x4e
+    };
+    unsigned char key_bytes[32];
+    uint32_t key[8];
+    unsigned char block[CRNG_CHACHA20_BLOCK_BYTES];
+    size_t index;
+
+    for (index = 0; index < sizeof(key_bytes); ++index) {
+        key_bytes[index] = (unsigned char)index;
+    }
+    for (index = 0; index < 8; ++index) {
+        key[index] = crng_chacha20_load_le32(key_bytes + index * 4U);
+    }
+    crng_chacha20_block(key, 1U, nonce, block);
+    CHECK(memcmp(block, expected, sizeof(block)) == 0);
+
+#if defined(CRNG_CHACHA20_LANES)
+    {
+        static const uint32_t starts[] = {0U, 1U, UINT32_C(0xfffffffe)};
+        unsigned char lanes[CRNG_CHACHA20_BLOCK_BYTES * CRNG_CHACHA20_LANES];
+        size_t start;
+        size_t lane;
+
+        crng_chacha20_blocks4(key, 1U, nonce, lanes);
+        CHECK(memcmp(lanes, expected, sizeof(expected)) == 0);
+        /* Counters 0-3, and a run that wraps the 32-bit counter. */
+        for (start = 0; start < sizeof(starts) / sizeof(starts[0]); ++start) {
+            crng_chacha20_blocks4(key, starts[start], nonce, lanes);
+            for (lane = 0; lane < CRNG_CHACHA20_LANES; ++lane) {
+                crng_chacha20_block(key, starts[start] + (uint32_t)lane, nonce, block);
+                CHECK(memcmp(lanes + lane * CRNG_CHACHA20_BLOCK_BYTES, block, sizeof(block)) == 0);
+            }
+        }
+    }
+#endif
+}
+
+static void test_secure_pool(void) {
+    crng_secure_pool pool;
+    crng_secure_pool lazy;
+    unsigned char first[700];
+    unsigned char second[700];
+    uint64_t bounded = UINT64_MAX;
+    int32_t signed_value = 0;
+    int index;
+
+    CHECK(crng_secure_pool_init(NULL) == CRNG_ERR_NULL);
+    CHECK(crng_secure_pool_init(&pool) == CRNG_OK);
+    CHECK(crng_secure_pool_bytes(&pool, NULL, 0) == CRNG_OK);
+    CHECK(crng_secure_pool_bytes(&pool, NULL, 1) == CRNG_ERR_NULL);
+    CHECK(crng_secure_pool_bytes(NULL, first, 1) == CRNG_ERR_NULL);
+    CHECK(crng_secure_pool_bytes(&pool, first, sizeof(first)) == CRNG_OK);
+    CHECK(crng_secure_pool_bytes(&pool, second, sizeof(second)) == CRNG_OK);
+    CHECK(memcmp(first, second, sizeof(first)) != 0);
+    CHECK(crng_secure_pool_u64(&pool, NULL) == CRNG_ERR_NULL);
+    CHECK(crng_secure_pool_uniform_u64(&pool, 0, &bounded) == CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_secure_pool_uniform_u64(&pool, 1, &bounded) == CRNG_OK);
+    CHECK(bounded == 0);
+    for (index = 0; index < 1000; ++index) {
+        CHECK(crng_secure_pool_uniform_u64(&pool, 6, &bounded) == CRNG_OK);
+        CHECK(bounded < 6U);
+    }
+    CHECK(crng_secure_pool_range_i32(&pool, 9, 4, &signed_value) == CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_secure_pool_range_i32(&pool, -3, -3, &signed_value) == CRNG_OK);
+    CHECK(signed_value == -3);
+    CHECK(crng_secure_pool_range_i32(&pool, INT32_MIN, INT32_MAX, &signed_value) == CRNG_OK);
+
+    /* Byte-count reseeding crosses the threshold without failing a request. */
+    for (index = 0; index < 1600; ++index) {
+        CHECK(crng_secure_pool_bytes(&pool, first, sizeof(first)) == CRNG_OK);
+    }
+
+    crng_secure_pool_wipe(&pool);
+    CHECK(pool.seeded == 0);
+    CHECK(pool.key[0] == 0 && pool.key[7] == 0);
+    crng_secure_pool_wipe(NULL);
+
+    memset(&lazy, 0, sizeof(lazy));
+    CHECK(crng_secure_pool_u64(&lazy, &bounded) == CRNG_OK);
+    CHECK(lazy.seeded != 0);
+    crng_secure_pool_wipe(&lazy);
+
+#if !defined(_WIN32)
+    {
+        int descriptors[2];
+        pid_t child;
+
+        CHECK(crng_secure_pool_init(&pool) == CRNG_OK);
+        CHECK(crng_secure_pool_u64(&pool, &bounded) == CRNG_OK);
+        CHECK(pipe(descriptors) == 0);
+        child = fork();
+        CHECK(child >= 0);
+        if (child == 0) {
+            unsigned char child_bytes[64];
+            int exit_code = 1;
+
+            (void)close(descriptors[0]);
+            if (crng_secure_pool_bytes(&pool, child_bytes, sizeof(child_bytes)) == CRNG_OK &&
+                write(descriptors[1], child_bytes, sizeof(child_bytes)) ==
+                    (ssize_t)sizeof(child_bytes)) {
+                exit_code = 0;
+            }
+            _exit(exit_code);
+        } else if (child > 0) {
+            unsigned char parent_bytes[64];
+            unsigned char child_bytes[64];
+            int child_status = 0;
+
+            (void)close(descriptors[1]);
+            CHECK(crng_secure_pool_bytes(&pool, parent_bytes, sizeof(parent_bytes)) == CRNG_OK);
+            CHECK(read(descriptors[0], child_bytes, sizeof(child_bytes)) ==
+                  (ssize_t)sizeof(child_bytes));
+            (void)close(descriptors[0]);
+            CHECK(waitpid(child, &child_status, 0) == child);
+            CHECK(WIFEXITED(child_status) && WEXITSTATUS(child_status) == 0);
+            /* A forked child must reseed instead of repeating buffered output. */
+            CHECK(memcmp(parent_bytes, child_bytes, sizeof(parent_bytes)) != 0);
+        }
+        crng_secure_pool_wipe(&pool);
+    }
+#endif
+}
+
 static void test_number_theory_layer(void) {
     uint64_t prime = 0;
 
@@ -188,6 +798,16 @@ static void test_number_theory_layer(void) {
     CHECK(!crng_crypto_is_prime_u64(UINT64_C(561))); /* Carmichael number */
     CHECK(!crng_crypto_is_prime_u64(UINT64_MAX));
     CHECK(crng_crypto_is_prime_u64(UINT64_C(18446744073709551557)));
+    /* Both sides of the 32-bit and Baillie-PSW split. */
+    CHECK(crng_crypto_is_prime_u64(UINT64_C(4294967291)));
+    CHECK(crng_crypto_is_prime_u64(UINT64_C(4294967311)));
+    CHECK(!crng_crypto_is_prime_u64(UINT64_C(3215031751))); /* spsp(2, 3, 5, 7) */
+    /* Strong base-2 pseudoprimes that the Lucas step must reject. */
+    CHECK(!crng_crypto_is_prime_u64(UINT64_C(4294967297)));
+    CHECK(!crng_crypto_is_prime_u64(UINT64_C(4759123141)));
+    CHECK(!crng_crypto_is_prime_u64(UINT64_C(3825123056546413051)));
+    CHECK(!crng_crypto_is_prime_u64(UINT64_C(18446744030759878681))); /* square */
+    CHECK(!crng_crypto_is_prime_u64(UINT64_C(18446743979220271189)));
     CHECK(crng_crypto_random_prime_u64(17, 17, 1, &prime) == CRNG_OK);
     CHECK(prime == UINT64_C(17));
     CHECK(crng_crypto_random_prime_u64(14, 16, 8, &prime) == CRNG_ERR_NOT_FOUND);
@@ -196,11 +816,375 @@ static void test_number_theory_layer(void) {
     CHECK(crng_crypto_random_prime_u64(2, 10, 8, NULL) == CRNG_ERR_NULL);
 }
 
+static void test_sieved_prime_search(void) {
+    uint64_t prime = 0;
+    int seen[64] = {0};
+    int index;
+
+    CHECK(crng_crypto_random_prime_u64_sieved(2, 10, 8, NULL) == CRNG_ERR_NULL);
+    CHECK(crng_crypto_random_prime_u64_sieved(9, 4, 8, &prime) == CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_crypto_random_prime_u64_sieved(2, 10, 0, &prime) == CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_crypto_random_prime_u64_sieved(0, 1, 8, &prime) == CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_crypto_random_prime_u64_sieved(14, 16, 8, &prime) == CRNG_ERR_NOT_FOUND);
+    CHECK(crng_crypto_random_prime_u64_sieved(2, 2, 1, &prime) == CRNG_OK);
+    CHECK(prime == UINT64_C(2));
+    /* Sieving primes must not reject themselves. */
+    CHECK(crng_crypto_random_prime_u64_sieved(311, 311, 1, &prime) == CRNG_OK);
+    CHECK(prime == UINT64_C(311));
+    /* The only prime in range sits below any start, so the walk must wrap. */
+    CHECK(crng_crypto_random_prime_u64_sieved(1327, 1360, 17, &prime) == CRNG_OK);
+    CHECK(prime == UINT64_C(1327));
+    /* No prime lies above 2^64 - 59. */
+    CHECK(crng_crypto_random_prime_u64_sieved(
+        UINT64_C(18446744073709551558), UINT64_MAX, 64, &prime) == CRNG_ERR_NOT_FOUND);
+
+    for (index = 0; index < 2000; ++index) {
+        CHECK(crng_crypto_random_prime_u64_sieved(0, 63, 64, &prime) == CRNG_OK);
+        CHECK(prime < 64U && crng_crypto_is_prime_u64(prime));
+        ++seen[prime];
+    }
+    for (index = 0; index < 64; ++index) {
+        CHECK((seen[index] != 0) == crng_crypto_is_prime_u64((uint64_t)index));
+    }
+
+    for (index = 0; index < 50; ++index) {
+        const uint64_t minimum = UINT64_C(1) << 62;
+        CHECK(crng_crypto_random_prime_u64_sieved(
+            minimum, minimum + UINT64_C(100000), 100000, &prime) == CRNG_OK);
+        CHECK(prime >= minimum && prime <= minimum + UINT64_C(100000));
+        CHECK(crng_crypto_is_prime_u64(prime));
+    }
+}
+
+static void test_special_prime_search(void) {
+    static const uint64_t safe_primes[] = {5, 7, 11, 23, 47, 59, 83};
+    uint64_t prime = 0;
+    int seen[100] = {0};
+    size_t safe_index = 0;
+    int index;
+
+    CHECK(crng_crypto_random_prime_congruent_u64(2, 10, 1, 4, 8, NULL) == CRNG_ERR_NULL);
+    CHECK(crng_crypto_random_prime_congruent_u64(2, 10, 0, 0, 8, &prime) ==
+          CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_crypto_random_prime_congruent_u64(2, 10, 4, 4, 8, &prime) ==
+          CRNG_ERR_INVALID_RANGE);
+    /* Classes sharing a factor with the modulus hold at most one prime. */
+    CHECK(crng_crypto_random_prime_congruent_u64(0, 100, 0, 17, 8, &prime) == CRNG_OK);
+    CHECK(prime == UINT64_C(17));
+    CHECK(crng_crypto_random_prime_congruent_u64(0, 100, 6, 9, 8, &prime) ==
+          CRNG_ERR_NOT_FOUND);
+    CHECK(crng_crypto_random_prime_congruent_u64(0, 6, 2, 5, 1, &prime) == CRNG_OK);
+    CHECK(prime == UINT64_C(2));
+    /* An odd modulus above 2^63 leaves one odd member: 4 + modulus. */
+    CHECK(crng_crypto_random_prime_congruent_u64(
+        0, UINT64_MAX, 4, UINT64_C(18446744073709551553), 4, &prime) == CRNG_OK);
+    CHECK(prime == UINT64_C(18446744073709551557));
+
+    for (index = 0; index < 2000; ++index) {
+        CHECK(crng_crypto_random_prime_congruent_u64(0, 99, 3, 4, 64, &prime) == CRNG_OK);
+        CHECK(prime < 100U && prime % 4U == 3U && crng_crypto_is_prime_u64(prime));
+        ++seen[prime];
+    }
+    for (index = 0; index < 100; ++index) {
+        CHECK((seen[index] != 0) ==
+              (index % 4 == 3 && crng_crypto_is_prime_u64((uint64_t)index)));
+    }
+    for (index = 0; index < 50; ++index) {
+        const uint64_t minimum = UINT64_C(1) << 62;
+        CHECK(crng_crypto_random_prime_congruent_u64(
+            minimum, UINT64_MAX, 1, UINT64_C(1) << 20, 100000, &prime) == CRNG_OK);
+        CHECK(prime >= minimum && (prime & ((UINT64_C(1) << 20) - 1U)) == 1U);
+        CHECK(crng_crypto_is_prime_u64(prime));
+    }
+
+    CHECK(crng_crypto_random_safe_prime_u64(5, 10, 8, NULL) == CRNG_ERR_NULL);
+    CHECK(crng_crypto_random_safe_prime_u64(0, 4, 8, &prime) == CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_crypto_random_safe_prime_u64(10, 5, 8, &prime) == CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_crypto_random_safe_prime_u64(5, 10, 0, &prime) == CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_crypto_random_safe_prime_u64(24, 46, 8, &prime) == CRNG_ERR_NOT_FOUND);
+
+    memset(seen, 0, sizeof seen);
+    for (index = 0; index < 2000; ++index) {
+        CHECK(crng_crypto_random_safe_prime_u64(0, 99, 64, &prime) == CRNG_OK);
+        CHECK(prime < 100U);
+        ++seen[prime];
+    }
+    for (index = 0; index < 100; ++index) {
+        const bool safe = safe_index < sizeof(safe_primes) / sizeof(safe_primes[0]) &&
+                          safe_primes[safe_index] == (uint64_t)index;
+
+        CHECK((seen[index] != 0) == safe);
+        safe_index += safe ? 1U : 0U;
+    }
+    for (index = 0; index < 20; ++index) {
+        const uint64_t minimum = UINT64_C(1) << 62;
+        CHECK(crng_crypto_random_safe_prime_u64(
+            minimum, UINT64_MAX, 1000000, &prime) == CRNG_OK);
+        CHECK(prime >= minimum && prime % 12U == 11U);
+        CHECK(crng_crypto_is_prime_u64(prime));
+        CHECK(crng_crypto_is_prime_u64((prime - 1U) / 2U));
+    }
+}
+
+static void test_u128_number_theory(void) {
+    static const crng_u128 primes[] = {
+        {UINT64_C(2), 0},
+        {UINT64_C(18446744073709551557), 0},
+        {UINT64_C(13), 1},
+        {UINT64_MAX, UINT64_C(0x1ffffff)},
+        {UINT64_MAX, UINT64_C(0x7ffffffffff)},
+        {UINT64_MAX, UINT64_C(0x7fffffffffffffff)},
+        {UINT64_C(0xffffffffffffff61), UINT64_MAX}
+    };
+    static const crng_u128 composites[] = {
+        {UINT64_MAX, 0},
+        {0, 1},
+        {1, 1},
+        {15, 1},
+        {UINT64_MAX, UINT64_MAX},
+        {UINT64_C(0xd99), UINT64_C(0xffffffffffffff8a)},
+        /* Strong base-2 pseudoprimes p(2p - 1) and p(4p - 3). */
+        {UINT64_C(0xd3f33c63bd6c0e85), UINT64_C(0xf786)},
+        {UINT64_C(0xac003a4be169f8d5), UINT64_C(0x2f5df7b55f08c67)}
+    };
+    const crng_u128 zero = {0, 0};
+    const crng_u128 low_minimum = {0, UINT64_C(1) << 31};
+    const crng_u128 low_maximum = {UINT64_MAX, UINT32_MAX};
+    crng_u128 value = {7, 7};
+    size_t index;
+
+    for (index = 0; index < sizeof(primes) / sizeof(primes[0]); ++index) {
+        CHECK(crng_crypto_is_prime_u128(primes[index]));
+    }
+    for (index = 0; index < sizeof(composites) / sizeof(composites[0]); ++index) {
+        CHECK(!crng_crypto_is_prime_u128(composites[index]));
+    }
+
+    CHECK(crng_secure_uniform_u128(primes[0], NULL) == CRNG_ERR_NULL);
+    CHECK(crng_secure_uniform_u128(zero, &value) == CRNG_ERR_INVALID_RANGE);
+    CHECK(value.low == 7U && value.high == 7U);
+    CHECK(crng_secure_uniform_u128((crng_u128){1, 0}, &value) == CRNG_OK);
+    CHECK(value.low == 0 && value.high == 0);
+    for (index = 0; index < 256; ++index) {
+        CHECK(crng_secure_uniform_u128((crng_u128){0, 1}, &value) == CRNG_OK);
+        CHECK(value.high == 0);
+        CHECK(crng_secure_uniform_u128((crng_u128){5, 3}, &value) == CRNG_OK);
+        CHECK(value.high < 3U || (value.high == 3U && value.low < 5U));
+    }
+
+    CHECK(crng_crypto_random_prime_u128(zero, primes[3], 8, NULL) == CRNG_ERR_NULL);
+    CHECK(crng_crypto_random_prime_u128(primes[3], primes[2], 8, &value) ==
+          CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_crypto_random_prime_u128(zero, (crng_u128){1, 0}, 8, &value) ==
+          CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_crypto_random_prime_u128(zero, primes[3], 0, &value) ==
+          CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_crypto_random_prime_u128(primes[5], primes[5], 1, &value) == CRNG_OK);
+    CHECK(value.low == primes[5].low && value.high == primes[5].high);
+    CHECK(crng_crypto_random_prime_u128(composites[3], composites[3], 4, &value) ==
+          CRNG_ERR_NOT_FOUND);
+    for (index = 0; index < 20; ++index) {
+        CHECK(crng_crypto_random_prime_u128(
+            low_minimum, low_maximum, 100000, &value) == CRNG_OK);
+        CHECK(value.high >= low_minimum.high && value.high <= low_maximum.high);
+        CHECK(crng_crypto_is_prime_u128(value));
+    }
+}
+
+static void test_stats(void) {
+    crng_game_rng rng;
+    crng_game_rng_stats game;
+    crng_secure_stats secure;
+    crng_secure_stats before;
+    crng_secure_pool pool;
+    unsigned char bytes[13];
+    uint64_t value;
+    size_t index;
+
+    crng_game_rng_seed(&rng, 7);
+    CHECK(crng_game_rng_read_stats(NULL, &game) == CRNG_ERR_NULL);
+    CHECK(crng_game_rng_read_stats(&rng, NULL) == CRNG_ERR_NULL);
+    CHECK(crng_game_rng_reset_stats(NULL) == CRNG_ERR_NULL);
+    CHECK(crng_secure_read_stats(NULL) == CRNG_ERR_NULL);
+#if defined(CRNG_ENABLE_STATS)
+    CHECK(crng_game_rng_read_stats(&rng, &game) == CRNG_OK);
+    CHECK(game.draws == 0 && game.uniform_results == 0 && game.uniform_rejections == 0 &&
+          game.fill_discarded_bytes == 0);
+
+    /* Thirteen bytes take two words and drop three bytes of the second. */
+    CHECK(crng_game_rng_fill(&rng, bytes, sizeof(bytes)) == CRNG_OK);
+    CHECK(crng_game_rng_read_stats(&rng, &game) == CRNG_OK);
+    CHECK(game.draws == 2 && game.fill_discarded_bytes == 3);
+
+    /* Near half of all words are rejected for 2^63 + 1. */
+    for (index = 0; index < 200U; ++index) {
+        CHECK(crng_game_rng_uniform_u64(&rng, (UINT64_C(1) << 63) + 1U, &value) == CRNG_OK);
+    }
+    CHECK(crng_game_rng_read_stats(&rng, &game) == CRNG_OK);
+    CHECK(game.uniform_results == 200U);
+    CHECK(game.uniform_rejections > 40U && game.uniform_rejections < 400U);
+    CHECK(game.draws == 2U + game.uniform_results + game.uniform_rejections);
+    CHECK(crng_game_rng_reset_stats(&rng) == CRNG_OK);
+    CHECK(crng_game_rng_read_stats(&rng, &game) == CRNG_OK);
+    CHECK(game.draws == 0 && game.uniform_results == 0);
+    (void)crng_game_rng_next_u64(&rng);
+    crng_game_rng_seed(&rng, 7);
+    CHECK(crng_game_rng_read_stats(&rng, &game) == CRNG_OK && game.draws == 0);
+
+    CHECK(crng_secure_reset_stats() == CRNG_OK);
+    CHECK(crng_secure_read_stats(&secure) == CRNG_OK);
+    CHECK(secure.entropy_calls == 0 && secure.entropy_bytes == 0 && secure.prime_searches == 0);
+    CHECK(crng_secure_bytes(bytes, sizeof(bytes)) == CRNG_OK);
+    CHECK(crng_secure_bytes(NULL, 0) == CRNG_OK);
+    CHECK(crng_secure_read_stats(&secure) == CRNG_OK);
+    CHECK(secure.entropy_calls == 1 && secure.entropy_bytes == sizeof(bytes));
+    for (index = 0; index < 100U; ++index) {
+        CHECK(crng_secure_uniform_u64((UINT64_C(1) << 63) + 1U, &value) == CRNG_OK);
+    }
+    CHECK(crng_secure_read_stats(&secure) == CRNG_OK);
+    CHECK(secure.uniform_results == 100U);
+    CHECK(secure.entropy_calls == 101U + secure.uniform_rejections);
+
+    /* [24, 28] holds no prime; the sieved walk visits 25 and 27. */
+    before = secure;
+    CHECK(crng_crypto_random_prime_u64_sieved(24, 28, 10, &value) == CRNG_ERR_NOT_FOUND);
+    CHECK(crng_secure_read_stats(&secure) == CRNG_OK);
+    CHECK(secure.prime_searches == before.prime_searches + 1U);
+    CHECK(secure.prime_attempts == before.prime_attempts + 2U);
+    CHECK(secure.prime_not_found == before.prime_not_found + 1U);
+    CHECK(crng_crypto_random_prime_u64(2, 100, 1000, &value) == CRNG_OK);
+    CHECK(crng_secure_read_stats(&secure) == CRNG_OK);
+    CHECK(secure.prime_searches == before.prime_searches + 2U);
+    CHECK(secure.prime_attempts >= before.prime_attempts + 3U);
+
+    CHECK(crng_secure_pool_init(&pool) == CRNG_OK);
+    CHECK(crng_secure_pool_bytes(&pool, bytes, sizeof(bytes)) == CRNG_OK);
+    CHECK(crng_secure_pool_uniform_u64(&pool, 6, &value) == CRNG_OK);
+    CHECK(crng_secure_read_stats(&secure) == CRNG_OK);
+    CHECK(secure.pool_reseeds == 1U);
+    CHECK(secure.pool_uniform_results == 1U);
+    CHECK(secure.pool_bytes == sizeof(bytes) + 8U * (1U + secure.pool_uniform_rejections));
+    crng_secure_pool_wipe(&pool);
+#else
+    /* The counters exist in every build and stay zero without the option. */
+    CHECK(crng_game_rng_uniform_u64(&rng, 6U, &value) == CRNG_OK);
+    CHECK(rng.stats.draws == 0U && rng.stats.uniform_results == 0U);
+    CHECK(crng_game_rng_read_stats(&rng, &game) == CRNG_ERR_UNSUPPORTED);
+    CHECK(crng_game_rng_reset_stats(&rng) == CRNG_ERR_UNSUPPORTED);
+    CHECK(crng_secure_read_stats(&secure) == CRNG_ERR_UNSUPPORTED);
+    CHECK(crng_secure_reset_stats() == CRNG_ERR_UNSUPPORTED);
+    (void)before;
+    (void)pool;
+    (void)bytes;
+    (void)value;
+    (void)index;
+#endif
+}
+
+static void test_prime_table(void) {
+    static const char path[] = "crng_prime_table_test.bin";
+    crng_prime_table table;
+    crng_prime_table mapped;
+    crng_prime_table empty = {0};
+    unsigned char header[24];
+    uint64_t value;
+    FILE *file;
+
+    CHECK(crng_prime_table_build(NULL, 100) == CRNG_ERR_NULL);
+    CHECK(crng_prime_table_build(&table, 0) == CRNG_ERR_INVALID_RANGE);
+    CHECK(table.bits == NULL && table.limit == 0);
+    CHECK(crng_prime_table_build(&table, CRNG_PRIME_TABLE_MAX_LIMIT + 1U) ==
+          CRNG_ERR_INVALID_RANGE);
+
+    /* A limit that is not a multiple of 30 leaves a partial final byte. */
+    CHECK(crng_prime_table_build(&table, 100003) == CRNG_OK);
+    CHECK(table.limit == UINT64_C(100003));
+    for (value = 0; value < 100100U; ++value) {
+        CHECK(crng_prime_table_is_prime(&table, value) == crng_crypto_is_prime_u64(value));
+    }
+    CHECK(crng_prime_table_is_prime(&table, UINT64_C(18446744073709551557)));
+    CHECK(crng_prime_table_is_prime(&empty, UINT64_C(4294967291)));
+    CHECK(crng_prime_table_is_prime(NULL, UINT64_C(97)));
+
+    CHECK(crng_prime_table_save(&empty, path) == CRNG_ERR_NULL);
+    CHECK(crng_prime_table_save(&table, NULL) == CRNG_ERR_NULL);
+    CHECK(crng_prime_table_save(&table, path) == CRNG_OK);
+    CHECK(crng_prime_table_map(&mapped, path) == CRNG_OK);
+    CHECK(mapped.limit == table.limit);
+    CHECK(memcmp(mapped.bits, table.bits, table.storage_size) == 0);
+    crng_prime_table_free(&mapped);
+    CHECK(mapped.bits == NULL && mapped.limit == 0);
+    crng_prime_table_free(&table);
+    crng_prime_table_free(NULL);
+
+    /* A truncated bitmap or a foreign header is rejected. */
+    file = fopen(path, "rb");
+    CHECK(file != NULL);
+    if (file != NULL) {
+        CHECK(fread(header, 1, sizeof(header), file) == sizeof(header));
+        fclose(file);
+    }
+    file = fopen(path, "wb");
+    CHECK(file != NULL);
+    if (file != NULL) {
+        CHECK(fwrite(header, 1, sizeof(header), file) == sizeof(header));
+        fclose(file);
+    }
+    CHECK(crng_prime_table_map(&mapped, path) == CRNG_ERR_FORMAT);
+    CHECK(mapped.bits == NULL);
+    header[0] = 'X';
+    file = fopen(path, "wb");
+    CHECK(file != NULL);
+    if (file != NULL) {
+        CHECK(fwrite(header, 1, 8, file) == 8);
+        fclose(file);
+    }
+    CHECK(crng_prime_table_map(&mapped, path) == CRNG_ERR_FORMAT);
+    CHECK(remove(path) == 0);
+    CHECK(crng_prime_table_map(&mapped, path) == CRNG_ERR_IO);
+    CHECK(crng_prime_table_map(NULL, path) == CRNG_ERR_NULL);
+}
+
+static void test_prime_batches(void) {
+    static const uint64_t values[] = {
+        UINT64_C(0), UINT64_C(1), UINT64_C(2), UINT64_C(131), UINT64_C(1681),
+        UINT64_C(1693), UINT64_C(561), UINT64_C(4294967291), UINT64_C(4294967297),
+        UINT64_C(4294967311), UINT64_C(4759123141), UINT64_C(3825123056546413051),
+        UINT64_C(18446744030759878681), UINT64_C(18446744073709551557),
+        UINT64_C(9223372036854775783), UINT64_C(9223372036854775807)
+    };
+    bool classes[sizeof(values) / sizeof(values[0])];
+    uint64_t window[97];
+    bool window_classes[97];
+    size_t index;
+
+    CHECK(crng_crypto_is_prime_u64_array(NULL, NULL, 0) == CRNG_OK);
+    CHECK(crng_crypto_is_prime_u64_array(NULL, classes, 1) == CRNG_ERR_NULL);
+    CHECK(crng_crypto_is_prime_u64_array(values, NULL, 1) == CRNG_ERR_NULL);
+
+    CHECK(crng_crypto_is_prime_u64_array(
+        values, classes, sizeof(values) / sizeof(values[0])) == CRNG_OK);
+    for (index = 0; index < sizeof(values) / sizeof(values[0]); ++index) {
+        CHECK(classes[index] == crng_crypto_is_prime_u64(values[index]));
+    }
+
+    /* An odd-length run leaves a partial group of interleaved lanes. */
+    for (index = 0; index < 97; ++index) {
+        window[index] = UINT64_C(18446744073709551557) - 2U * (uint64_t)index;
+    }
+    CHECK(crng_crypto_is_prime_u64_array(window, window_classes, 97) == CRNG_OK);
+    for (index = 0; index < 97; ++index) {
+        CHECK(window_classes[index] == crng_crypto_is_prime_u64(window[index]));
+    }
+}
+
 static void test_status_strings(void) {
     CHECK(strcmp(crng_status_string(CRNG_OK), "success") == 0);
     CHECK(strcmp(crng_status_string(CRNG_ERR_INVALID_RANGE), "invalid range") == 0);
     CHECK(strcmp(crng_status_string(CRNG_ERR_NOT_FOUND),
                  "no matching value found within the attempt limit") == 0);
+    CHECK(strcmp(crng_status_string(CRNG_ERR_FORMAT),
+                 "malformed or incompatible data") == 0);
     CHECK(strcmp(crng_status_string((crng_status)99),
                  "unknown classical_rng status") == 0);
 }
@@ -212,8 +1196,23 @@ int main(void) {
     test_unbiased_bounds();
     test_signed_ranges();
     test_floating_point();
+    test_state_records();
+    test_reverse_stepping();
+    test_algorithm_tiers();
     test_operating_system_randomness();
+    test_secure_backend();
+    test_secure_batches();
+    test_secure_token();
+    test_secure_uuid();
+    test_chacha20_blocks();
+    test_secure_pool();
     test_number_theory_layer();
+    test_sieved_prime_search();
+    test_special_prime_search();
+    test_u128_number_theory();
+    test_prime_table();
+    test_stats();
+    test_prime_batches();
     test_status_strings();
 
     if (failures != 0) {
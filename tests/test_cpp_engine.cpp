@@ -0,0 +1,178 @@
+#include "classical_rng.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+static_assert(std::uniform_random_bit_generator<crng::game_engine>);
+static_assert(std::uniform_random_bit_generator<crng::secure_engine>);
+static_assert(std::uniform_random_bit_generator<crng::secure_pool>);
+static_assert(!std::copy_constructible<crng::secure_pool>);
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        ++checks;                                                               \
+        if (!(condition)) {                                                     \
+            std::fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition); \
+            ++failures;                                                         \
+        }                                                                       \
+    } while (0)
+
+static void test_game_engine() {
+    constexpr std::size_t count = 200;
+    crng_game_rng reference;
+    std::vector<std::uint64_t> expected(count);
+    std::vector<std::uint64_t> words(count);
+    std::array<std::byte, 61> bytes{};
+    std::array<unsigned char, 61> reference_bytes{};
+    crng::game_engine engine(17);
+    crng::game_engine copy(17);
+
+    crng_game_rng_seed(&reference, 17);
+    for (std::uint64_t &value : expected) {
+        value = crng_game_rng_next_u64(&reference);
+    }
+
+    /* Mixed single draws, bulk generation, and discard keep one sequence. */
+    CHECK(engine() == expected[0]);
+    CHECK(engine() == expected[1]);
+    engine.generate(std::span<std::uint64_t>(words).first(50));
+    CHECK(std::equal(words.begin(), words.begin() + 50, expected.begin() + 2));
+    engine.discard(3);
+    CHECK(engine() == expected[55]);
+    engine.discard(100);
+    CHECK(engine() == expected[156]);
+    CHECK(engine.rewind(5));
+    CHECK(engine() == expected[152]);
+    CHECK(!engine.rewind(1000));
+
+    /* The C position excludes words still buffered in the engine. */
+    crng_game_rng position = engine.state();
+    CHECK(position.step == 153U);
+    CHECK(crng_game_rng_next_u64(&position) == expected[153]);
+
+    const auto record = engine.serialize();
+    copy.deserialize(record);
+    CHECK(copy == engine);
+    CHECK(copy() == engine());
+
+    /* fill matches crng_game_rng_fill from the same position. */
+    crng_game_rng_seed(&reference, 23);
+    (void)crng_game_rng_next_u64(&reference);
+    CHECK(crng_game_rng_fill(
+        &reference, reference_bytes.data(), reference_bytes.size()) == CRNG_OK);
+    engine.seed(23);
+    (void)engine();
+    engine.fill(bytes);
+    CHECK(std::memcmp(bytes.data(), reference_bytes.data(), bytes.size()) == 0);
+    CHECK(engine() == crng_game_rng_next_u64(&reference));
+
+    std::uniform_int_distribution<int> die(1, 6);
+    for (int roll = 0; roll < 1000; ++roll) {
+        const int face = die(engine);
+        CHECK(face >= 1 && face <= 6);
+    }
+
+    /* Algorithm tiers pass through to the C generator. */
+    crng::game_engine fast(1, CRNG_GAME_RNG_ALGORITHM_XOSHIRO256SS);
+    crng_game_rng_seed_algorithm(&reference, 1, CRNG_GAME_RNG_ALGORITHM_XOSHIRO256SS);
+    for (int draw = 0; draw < 100; ++draw) {
+        CHECK(fast() == crng_game_rng_next_u64(&reference));
+    }
+    CHECK(fast.state().algorithm == CRNG_GAME_RNG_ALGORITHM_XOSHIRO256SS);
+    CHECK(fast != engine);
+    try {
+        fast.seed(1, static_cast<crng_game_rng_algorithm>(0));
+        CHECK(false);
+    } catch (const crng::error &caught) {
+        CHECK(caught.status() == CRNG_ERR_INVALID_RANGE);
+    }
+
+    std::array<unsigned char, CRNG_GAME_RNG_RECORD_BYTES> damaged = record;
+    damaged[10] ^= 1U;
+    try {
+        copy.deserialize(damaged);
+        CHECK(false);
+    } catch (const crng::error &caught) {
+        CHECK(caught.status() == CRNG_ERR_FORMAT);
+    }
+}
+
+static void test_secure_engines() {
+    std::array<std::uint64_t, 100> words{};
+    std::array<std::byte, 33> bytes{};
+    crng::secure_engine secure;
+    crng::secure_pool pool;
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    CHECK(secure() != secure());
+    secure.generate(words);
+    CHECK(std::any_of(words.begin(), words.end(), [](std::uint64_t word) { return word != 0; }));
+    secure.fill(bytes);
+
+    const double value = unit(pool);
+    CHECK(value >= 0.0 && value < 1.0);
+    pool.generate(words);
+    pool.fill(bytes);
+    CHECK(pool() != pool());
+
+    crng::secure_pool moved(std::move(pool));
+    CHECK(moved() != moved());
+    std::uint64_t bounded = 0;
+    CHECK(crng_secure_pool_uniform_u64(moved.native(), 10, &bounded) == CRNG_OK);
+    CHECK(bounded < 10U);
+}
+
+static void test_constant_bounds() {
+    crng_game_rng reference;
+    crng::game_engine engine(52);
+    crng::secure_pool pool;
+    std::uint64_t expected = 0;
+    std::int32_t expected_signed = 0;
+
+    crng_game_rng_seed(&reference, 52);
+    for (int draw = 0; draw < 300; ++draw) {
+        CHECK(crng_game_rng_uniform_u64(&reference, 6, &expected) == CRNG_OK);
+        CHECK(crng::uniform<6>(engine) == expected);
+        CHECK(crng_game_rng_uniform_u64(&reference, 52, &expected) == CRNG_OK);
+        CHECK(crng::uniform<52>(engine) == expected);
+        CHECK(crng_game_rng_uniform_u64(&reference, 1024, &expected) == CRNG_OK);
+        CHECK(crng::uniform<1024>(engine) == expected);
+        CHECK(crng_game_rng_uniform_u64(
+            &reference, (UINT64_C(1) << 63) + 1U, &expected) == CRNG_OK);
+        CHECK(crng::uniform<(UINT64_C(1) << 63) + 1U>(engine) == expected);
+        CHECK(crng_game_rng_range_i32(&reference, -3, 17, &expected_signed) == CRNG_OK);
+        CHECK((crng::uniform<-3, 17>(engine)) == expected_signed);
+        CHECK(crng_game_rng_range_i32(
+            &reference, INT32_MIN, INT32_MAX, &expected_signed) == CRNG_OK);
+        CHECK((crng::uniform<INT32_MIN, INT32_MAX>(engine)) == expected_signed);
+    }
+    CHECK(engine.state().step == reference.step);
+
+    for (int draw = 0; draw < 100; ++draw) {
+        CHECK(crng::uniform<20>(pool) < 20U);
+    }
+}
+
+int main() {
+    test_game_engine();
+    test_secure_engines();
+    test_constant_bounds();
+    if (failures != 0) {
+        std::fprintf(stderr, "classical_rng C++ engines: %d of %d checks failed\n",
+                     failures, checks);
+        return 1;
+    }
+    std::printf("classical_rng C++ engines: %d checks passed\n", checks);
+    return 0;
+}
@@ -0,0 +1,176 @@
+#ifndef CRNG_INLINE_IMPL
+#define CRNG_INLINE_IMPL
+#endif
+#include "classical_rng.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * With CRNG_INLINE_IMPL the plain spellings below draw through the inline
+ * kernel; the parenthesized spellings call the library. Both generators
+ * must stay identical after every call.
+ */
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        ++checks;                                                               \
+        if (!(condition)) {                                                     \
+            fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition); \
+            ++failures;                                                         \
+        }                                                                       \
+    } while (0)
+
+static int same_generator(const crng_game_rng *left, const crng_game_rng *right) {
+    return memcmp(left->state, right->state, sizeof(left->state)) == 0 &&
+           left->step == right->step &&
+           memcmp(&left->last_roundoff, &right->last_roundoff, sizeof(left->last_roundoff)) == 0
+#if defined(CRNG_ENABLE_STATS)
+           && memcmp(&left->stats, &right->stats, sizeof(left->stats)) == 0
+#endif
+        ;
+}
+
+static void test_words(void) {
+    static const uint64_t seeds[] = {0U, 1U, 42U, UINT64_MAX};
+    size_t seed_index;
+
+    for (seed_index = 0; seed_index < sizeof(seeds) / sizeof(seeds[0]); ++seed_index) {
+        crng_game_rng inline_rng;
+        crng_game_rng library_rng;
+        int draw;
+
+        crng_game_rng_seed(&inline_rng, seeds[seed_index]);
+        crng_game_rng_seed(&library_rng, seeds[seed_index]);
+        for (draw = 0; draw < 2000; ++draw) {
+            CHECK(crng_game_rng_next_u64(&inline_rng) == (crng_game_rng_next_u64)(&library_rng));
+        }
+        CHECK(crng_game_rng_next_u32(&inline_rng) == (crng_game_rng_next_u32)(&library_rng));
+        CHECK(crng_game_rng_next_double(&inline_rng) == (crng_game_rng_next_double)(&library_rng));
+        CHECK(same_generator(&inline_rng, &library_rng));
+
+        /* Rewinding works across both paths. */
+        CHECK(crng_game_rng_rewind(&inline_rng, 7U) == CRNG_OK);
+        CHECK(crng_game_rng_prev_u64(&library_rng) != 0U);
+        CHECK(crng_game_rng_rewind(&library_rng, 6U) == CRNG_OK);
+        CHECK(same_generator(&inline_rng, &library_rng));
+        CHECK(crng_game_rng_next_u64(&inline_rng) == (crng_game_rng_next_u64)(&library_rng));
+    }
+}
+
+static void test_bounded(void) {
+    static const uint64_t bounds[] = {
+        1U, 2U, 3U, 6U, 1000U, UINT64_C(0x8000000000000001), UINT64_MAX
+    };
+    crng_game_rng inline_rng;
+    crng_game_rng library_rng;
+    uint64_t inline_value = 0;
+    uint64_t library_value = 0;
+    int32_t inline_signed = 0;
+    int32_t library_signed = 0;
+    size_t bound_index;
+    int draw;
+
+    crng_game_rng_seed(&inline_rng, 9U);
+    crng_game_rng_seed(&library_rng, 9U);
+    for (bound_index = 0; bound_index < sizeof(bounds) / sizeof(bounds[0]); ++bound_index) {
+        for (draw = 0; draw < 200; ++draw) {
+            CHECK(crng_game_rng_uniform_u64(
+                &inline_rng, bounds[bound_index], &inline_value) == CRNG_OK);
+            CHECK((crng_game_rng_uniform_u64)(
+                &library_rng, bounds[bound_index], &library_value) == CRNG_OK);
+            CHECK(inline_value == library_value);
+        }
+    }
+    for (draw = 0; draw < 500; ++draw) {
+        CHECK(crng_game_rng_range_i32(&inline_rng, -3, 17, &inline_signed) == CRNG_OK);
+        CHECK((crng_game_rng_range_i32)(&library_rng, -3, 17, &library_signed) == CRNG_OK);
+        CHECK(inline_signed == library_signed);
+        CHECK(crng_game_rng_range_i32(
+            &inline_rng, INT32_MIN, INT32_MAX, &inline_signed) == CRNG_OK);
+        CHECK((crng_game_rng_range_i32)(
+            &library_rng, INT32_MIN, INT32_MAX, &library_signed) == CRNG_OK);
+        CHECK(inline_signed == library_signed);
+    }
+    CHECK(same_generator(&inline_rng, &library_rng));
+
+    /* Statuses match, and failures leave both outputs and streams alone. */
+    inline_value = 5U;
+    CHECK(crng_game_rng_uniform_u64(&inline_rng, 0U, &inline_value) == CRNG_ERR_INVALID_RANGE);
+    CHECK(inline_value == 5U);
+    CHECK(crng_game_rng_uniform_u64(NULL, 6U, &inline_value) == CRNG_ERR_NULL);
+    CHECK(crng_game_rng_uniform_u64(&inline_rng, 6U, NULL) == CRNG_ERR_NULL);
+    CHECK(crng_game_rng_range_i32(&inline_rng, 4, 3, &inline_signed) == CRNG_ERR_INVALID_RANGE);
+    CHECK(crng_game_rng_range_i32(&inline_rng, 3, 4, NULL) == CRNG_ERR_NULL);
+    CHECK(same_generator(&inline_rng, &library_rng));
+}
+
+static void test_restored_record(void) {
+    unsigned char record[CRNG_GAME_RNG_RECORD_BYTES];
+    crng_game_rng saved;
+    crng_game_rng inline_rng;
+    crng_game_rng library_rng;
+    int draw;
+
+    crng_game_rng_seed(&saved, 77U);
+    for (draw = 0; draw < 13; ++draw) {
+        (void)crng_game_rng_next_u64(&saved);
+    }
+    CHECK(crng_game_rng_serialize(&saved, record) == CRNG_OK);
+    CHECK(crng_game_rng_deserialize(&inline_rng, record) == CRNG_OK);
+    CHECK(crng_game_rng_deserialize(&library_rng, record) == CRNG_OK);
+    for (draw = 0; draw < 100; ++draw) {
+        CHECK(crng_game_rng_next_u64(&inline_rng) == (crng_game_rng_next_u64)(&library_rng));
+    }
+    CHECK(same_generator(&inline_rng, &library_rng));
+}
+
+static void test_constant_bounds(void) {
+    crng_game_rng constant_rng;
+    crng_game_rng library_rng;
+    uint64_t value = 0;
+    int32_t signed_value = 0;
+    int draw;
+
+    crng_game_rng_seed(&constant_rng, 52U);
+    crng_game_rng_seed(&library_rng, 52U);
+    for (draw = 0; draw < 300; ++draw) {
+        CHECK((crng_game_rng_uniform_u64)(&library_rng, 6U, &value) == CRNG_OK);
+        CHECK(CRNG_GAME_RNG_UNIFORM_CONSTANT(&constant_rng, 6) == value);
+        CHECK((crng_game_rng_uniform_u64)(&library_rng, 52U, &value) == CRNG_OK);
+        CHECK(CRNG_GAME_RNG_UNIFORM_CONSTANT(&constant_rng, 52U) == value);
+        CHECK((crng_game_rng_uniform_u64)(&library_rng, 64U, &value) == CRNG_OK);
+        CHECK(CRNG_GAME_RNG_UNIFORM_CONSTANT(&constant_rng, 64U) == value);
+        CHECK((crng_game_rng_uniform_u64)(&library_rng, 1U, &value) == CRNG_OK);
+        CHECK(CRNG_GAME_RNG_UNIFORM_CONSTANT(&constant_rng, 1U) == value);
+        /* Rejects almost half of all outputs. */
+        CHECK((crng_game_rng_uniform_u64)(
+            &library_rng, UINT64_C(0x8000000000000001), &value) == CRNG_OK);
+        CHECK(CRNG_GAME_RNG_UNIFORM_CONSTANT(
+            &constant_rng, UINT64_C(0x8000000000000001)) == value);
+        CHECK((crng_game_rng_range_i32)(&library_rng, 1, 20, &signed_value) == CRNG_OK);
+        CHECK(CRNG_GAME_RNG_RANGE_CONSTANT(&constant_rng, 1, 20) == signed_value);
+        CHECK((crng_game_rng_range_i32)(
+            &library_rng, INT32_MIN, INT32_MAX, &signed_value) == CRNG_OK);
+        CHECK(CRNG_GAME_RNG_RANGE_CONSTANT(&constant_rng, INT32_MIN, INT32_MAX) == signed_value);
+        CHECK((crng_game_rng_range_i32)(&library_rng, -7, -7, &signed_value) == CRNG_OK);
+        CHECK(CRNG_GAME_RNG_RANGE_CONSTANT(&constant_rng, -7, -7) == signed_value);
+    }
+    CHECK(same_generator(&constant_rng, &library_rng));
+}
+
+int main(void) {
+    test_words();
+    test_bounded();
+    test_constant_bounds();
+    test_restored_record();
+    if (failures != 0) {
+        fprintf(stderr, "classical_rng inline kernel: %d of %d checks failed\n", failures, checks);
+        return 1;
+    }
+    printf("classical_rng inline kernel: %d checks passed\n", checks);
+    return 0;
+}
@@ -2,8 +2,43 @@
 #include "test_game_rng.h"
 #include "test_utils/statistical_tests.h"
 
+#include <stdio.h>
 #include <stdlib.h>
 
+/* Deterministic battery run; the seed is fixed, so the p-values are too. */
+static int run_game_rng_battery(void) {
+    enum { BLOCK_WORDS = 4096, BLOCKS = 256 };
+    crng_test_result results[CRNG_TEST_BATTERY_TESTS];
+    crng_test_battery *battery;
+    crng_game_rng rng;
+    uint64_t block[BLOCK_WORDS];
+    size_t index;
+    size_t word;
+    int result = 0;
+
+    battery = (crng_test_battery *)malloc(sizeof(*battery));
+    if (battery == NULL) {
+        return 1;
+    }
+    crng_test_battery_reset(battery);
+    crng_game_rng_seed(&rng, UINT64_C(1));
+    for (index = 0; index < BLOCKS; ++index) {
+        for (word = 0; word < BLOCK_WORDS; ++word) {
+            block[word] = crng_game_rng_next_u64(&rng);
+        }
+        crng_test_battery_update(battery, block, BLOCK_WORDS);
+    }
+    crng_test_battery_finish(battery, results);
+    if (!crng_test_battery_passed(results, 1e-6)) {
+        for (index = 0; index < CRNG_TEST_BATTERY_TESTS; ++index) {
+            fprintf(stderr, "battery %s: p = %g\n", results[index].name, results[index].p_value);
+        }
+        result = 1;
+    }
+    free(battery);
+    return result;
+}
+
 int run_game_rng_tests(void) {
     enum { SAMPLE_COUNT = 32768 };
     crng_test_distribution report;
@@ -35,6 +70,9 @@ int run_game_rng_tests(void) {
     }
     crng_test_print_json("game_rng", &report);
     free(values);
+    if (run_game_rng_battery() != 0) {
+        result = 1;
+    }
     return result;
 }
 
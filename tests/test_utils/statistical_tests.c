@@ -1,23 +1,73 @@
 #include "statistical_tests.h"
 
 #include <inttypes.h>
+#include <math.h>
 #include <stdio.h>
 #include <string.h>
 
+static unsigned int crng_test_popcount(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int)__builtin_popcountll(value);
+#else
+    value -= (value >> 1) & UINT64_C(0x5555555555555555);
+    value = (value & UINT64_C(0x3333333333333333)) +
+            ((value >> 2) & UINT64_C(0x3333333333333333));
+    value = (value + (value >> 4)) & UINT64_C(0x0f0f0f0f0f0f0f0f);
+    return (unsigned int)((value * UINT64_C(0x0101010101010101)) >> 56);
+#endif
+}
+
+/* Byte-value counts per byte lane; eight increments per word instead of 64. */
+static void crng_test_count_bytes(
+    uint64_t counts[8][256],
+    const uint64_t *values,
+    size_t count
+) {
+    size_t index;
+
+    for (index = 0; index < count; ++index) {
+        const uint64_t value = values[index];
+        unsigned int lane;
+
+        for (lane = 0; lane < 8U; ++lane) {
+            ++counts[lane][(value >> (lane * 8U)) & UINT64_C(0xff)];
+        }
+    }
+}
+
+static uint64_t crng_test_lane_bit_ones(const uint64_t counts[256], unsigned int bit) {
+    uint64_t ones = 0;
+    unsigned int value;
+
+    for (value = 0; value < 256U; ++value) {
+        if ((value >> bit) & 1U) {
+            ones += counts[value];
+        }
+    }
+    return ones;
+}
+
 void crng_test_analyze_distribution(
     crng_test_distribution *report,
     const uint64_t *values,
     size_t count
 ) {
-    size_t index;
+    uint64_t counts[8][256];
+    unsigned int lane;
+    unsigned int value;
 
     memset(report, 0, sizeof(*report));
+    memset(counts, 0, sizeof(counts));
     report->sample_count = count;
-    for (index = 0; index < count; ++index) {
+    crng_test_count_bytes(counts, values, count);
+    for (value = 0; value < 256U; ++value) {
+        report->buckets[value & 15U] += counts[0][value];
+    }
+    for (lane = 0; lane < 8U; ++lane) {
         unsigned int bit;
-        ++report->buckets[values[index] & UINT64_C(15)];
-        for (bit = 0; bit < 64U; ++bit) {
-            report->one_bits[bit] += (values[index] >> bit) & UINT64_C(1);
+
+        for (bit = 0; bit < 8U; ++bit) {
+            report->one_bits[lane * 8U + bit] = crng_test_lane_bit_ones(counts[lane], bit);
         }
     }
 }
@@ -54,3 +104,525 @@ void crng_test_print_json(
     }
     printf("]}\n");
 }
+
+/* Regularized upper incomplete gamma Q(a, x), series or continued fraction. */
+static double crng_test_gamma_q(double a, double x) {
+    const double epsilon = 1e-15;
+    const double tiny = 1e-300;
+    double prefix;
+    int iteration;
+
+    if (x <= 0.0) {
+        return 1.0;
+    }
+    prefix = exp(-x + a * log(x) - lgamma(a));
+    if (x < a + 1.0) {
+        double term = 1.0 / a;
+        double sum = term;
+        double denominator = a;
+
+        for (iteration = 0; iteration < 1000000; ++iteration) {
+            denominator += 1.0;
+            term *= x / denominator;
+            sum += term;
+            if (fabs(term) < fabs(sum) * epsilon) {
+                break;
+            }
+        }
+        return 1.0 - sum * prefix;
+    } else {
+        double b = x + 1.0 - a;
+        double c = 1.0 / tiny;
+        double d = 1.0 / b;
+        double h = d;
+
+        for (iteration = 1; iteration < 1000000; ++iteration) {
+            const double an = -iteration * (iteration - a);
+            double delta;
+
+            b += 2.0;
+            d = an * d + b;
+            if (fabs(d) < tiny) {
+                d = tiny;
+            }
+            c = b + an / c;
+            if (fabs(c) < tiny) {
+                c = tiny;
+            }
+            d = 1.0 / d;
+            delta = d * c;
+            h *= delta;
+            if (fabs(delta - 1.0) < epsilon) {
+                break;
+            }
+        }
+        return h * prefix;
+    }
+}
+
+static void crng_test_set_chi_square(
+    crng_test_result *result,
+    const char *name,
+    double statistic,
+    double degrees_of_freedom,
+    uint64_t samples
+) {
+    result->name = name;
+    result->statistic = statistic;
+    result->degrees_of_freedom = degrees_of_freedom;
+    result->samples = samples;
+    result->p_value = crng_test_gamma_q(degrees_of_freedom / 2.0, statistic / 2.0);
+}
+
+/*
+ * Pearson chi-square of `bins` counts against `probabilities`, or against a
+ * uniform distribution when that is NULL. Tests whose smallest expected count
+ * is under five are reported as too short instead.
+ */
+static void crng_test_chi_square(
+    crng_test_result *result,
+    const char *name,
+    const uint64_t *counts,
+    const double *probabilities,
+    size_t bins
+) {
+    double total = 0.0;
+    double statistic = 0.0;
+    double smallest = 1.0;
+    size_t index;
+
+    for (index = 0; index < bins; ++index) {
+        const double probability = probabilities == NULL ? 1.0 / (double)bins
+                                                         : probabilities[index];
+
+        total += (double)counts[index];
+        if (probability < smallest) {
+            smallest = probability;
+        }
+    }
+    if (total * smallest < 5.0) {
+        result->name = name;
+        result->statistic = 0.0;
+        result->degrees_of_freedom = (double)(bins - 1U);
+        result->p_value = -1.0;
+        result->samples = (uint64_t)total;
+        return;
+    }
+    for (index = 0; index < bins; ++index) {
+        const double probability = probabilities == NULL ? 1.0 / (double)bins
+                                                         : probabilities[index];
+        const double expected = total * probability;
+        const double difference = (double)counts[index] - expected;
+
+        statistic += difference * difference / expected;
+    }
+    crng_test_set_chi_square(result, name, statistic, (double)(bins - 1U), (uint64_t)total);
+}
+
+void crng_test_battery_reset(crng_test_battery *battery) {
+    memset(battery, 0, sizeof(*battery));
+}
+
+/* LSD radix sort of 39-bit values in three 13-bit passes. */
+static void crng_test_sort39(uint64_t *values, uint64_t *scratch, size_t count) {
+    size_t offsets[1U << 13];
+    unsigned int pass;
+
+    for (pass = 0; pass < 3U; ++pass) {
+        size_t index;
+        size_t running = 0;
+        const unsigned int shift = pass * 13U;
+
+        memset(offsets, 0, sizeof(offsets));
+        for (index = 0; index < count; ++index) {
+            ++offsets[(values[index] >> shift) & 0x1fffU];
+        }
+        for (index = 0; index < (1U << 13); ++index) {
+            const size_t bucket = offsets[index];
+
+            offsets[index] = running;
+            running += bucket;
+        }
+        for (index = 0; index < count; ++index) {
+            scratch[offsets[(values[index] >> shift) & 0x1fffU]++] = values[index];
+        }
+        memcpy(values, scratch, count * sizeof(*values));
+    }
+}
+
+/*
+ * Birthday spacings: 2^14 birthdays in a 2^39-day year, so the number of
+ * repeated spacings is Poisson with mean 2^42 / (4 * 2^39) = 2. The classic
+ * 512 birthdays in 2^24 days has a year too short for that limit: an ideal
+ * source already fails it at a few hundred thousand samples.
+ */
+static void crng_test_birthday_sample(crng_test_battery *battery) {
+    uint64_t *days = battery->birthdays;
+    size_t index;
+    uint64_t previous = 0;
+    unsigned int repeats = 0;
+
+    crng_test_sort39(days, battery->birthday_scratch, CRNG_TEST_BIRTHDAYS);
+    for (index = 0; index < CRNG_TEST_BIRTHDAYS; ++index) {
+        const uint64_t day = days[index];
+
+        days[index] = day - previous;
+        previous = day;
+    }
+    crng_test_sort39(days, battery->birthday_scratch, CRNG_TEST_BIRTHDAYS);
+    for (index = 1; index < CRNG_TEST_BIRTHDAYS; ++index) {
+        if (days[index] == days[index - 1U]) {
+            ++repeats;
+        }
+    }
+    ++battery->birthday_counts[repeats < CRNG_TEST_BIRTHDAY_BINS - 1U
+                                   ? repeats
+                                   : CRNG_TEST_BIRTHDAY_BINS - 1U];
+}
+
+/*
+ * Berlekamp-Massey over one 512-bit block with packed polynomials. `window`
+ * holds s[n - i] at bit i, so each discrepancy is the parity of C & window.
+ */
+static void crng_test_linear_complexity(crng_test_battery *battery) {
+    enum { WORDS = CRNG_TEST_LC_BITS / 64 + 1 };
+    uint64_t connection[WORDS] = {1U};
+    uint64_t previous[WORDS] = {1U};
+    uint64_t window[WORDS] = {0};
+    size_t complexity = 0;
+    size_t last_update = 0; /* One past the step of the last length change. */
+    size_t n;
+    size_t bin;
+
+    for (n = 0; n < CRNG_TEST_LC_BITS; ++n) {
+        const size_t active = n / 64U + 1U;
+        unsigned int parity = 0;
+        size_t word;
+
+        for (word = active; word-- > 1U;) {
+            window[word] = (window[word] << 1) | (window[word - 1U] >> 63);
+        }
+        window[0] = (window[0] << 1) | ((battery->lc_bits[n / 64U] >> (n % 64U)) & 1U);
+        for (word = 0; word < active; ++word) {
+            parity ^= crng_test_popcount(connection[word] & window[word]);
+        }
+        if ((parity & 1U) != 0) {
+            uint64_t saved[WORDS];
+            const size_t shift = n + 1U - last_update;
+            const size_t word_shift = shift / 64U;
+            const unsigned int bit_shift = (unsigned int)(shift % 64U);
+
+            memcpy(saved, connection, sizeof(saved));
+            for (word = WORDS; word-- > word_shift;) {
+                uint64_t moved = previous[word - word_shift] << bit_shift;
+
+                if (bit_shift != 0 && word > word_shift) {
+                    moved |= previous[word - word_shift - 1U] >> (64U - bit_shift);
+                }
+                connection[word] ^= moved;
+            }
+            if (2U * complexity <= n) {
+                complexity = n + 1U - complexity;
+                last_update = n + 1U;
+                memcpy(previous, saved, sizeof(previous));
+            }
+        }
+    }
+
+    /* M = 512 is even, so NIST's T statistic is complexity - 256. */
+    if (complexity <= 253U) {
+        bin = 0;
+    } else if (complexity >= 259U) {
+        bin = 6;
+    } else {
+        bin = complexity - 253U;
+    }
+    ++battery->lc_counts[bin];
+}
+
+void crng_test_battery_update(
+    crng_test_battery *battery,
+    const uint64_t *words,
+    size_t count
+) {
+    size_t index;
+
+    battery->words += count;
+    crng_test_count_bytes(battery->byte_counts, words, count);
+    for (index = 0; index < count; ++index) {
+        ++battery->word16_counts[words[index] >> 48];
+        ++battery->popcount_counts[crng_test_popcount(words[index])];
+    }
+
+    for (index = 0; index < count; ++index) {
+        const unsigned int high = (unsigned int)(words[index] >> 56);
+
+        if (battery->has_pair) {
+            ++battery->pair_counts[(battery->pair_high << 8) | high];
+            ++battery->pairs;
+        } else {
+            battery->pair_high = high;
+        }
+        battery->has_pair = !battery->has_pair;
+    }
+
+    /* Lag-one products of the upper halves, centered exactly on zero. */
+    {
+        double sum = 0.0;
+        double previous = battery->has_previous
+                              ? ((double)(battery->previous >> 32) - 2147483647.5) / 4294967296.0
+                              : 0.0;
+
+        for (index = 0; index < count; ++index) {
+            const double centered = ((double)(words[index] >> 32) - 2147483647.5) / 4294967296.0;
+
+            sum += previous * centered;
+            previous = centered;
+        }
+        battery->serial_sum += sum;
+        if (count != 0) {
+            battery->serial_terms += count - (battery->has_previous ? 0U : 1U);
+            battery->has_previous = 1;
+            battery->previous = words[count - 1U];
+        }
+    }
+
+    /* Gaps between words whose top three bits are zero (p = 1/8). */
+    for (index = 0; index < count; ++index) {
+        if ((words[index] >> 61) == 0) {
+            ++battery->gap_counts[battery->gap_length < CRNG_TEST_GAP_BINS - 1U
+                                      ? battery->gap_length
+                                      : CRNG_TEST_GAP_BINS - 1U];
+            battery->gap_length = 0;
+        } else {
+            ++battery->gap_length;
+        }
+    }
+
+    /* Runs up, discarding the word that ends each run so lengths are independent. */
+    for (index = 0; index < count; ++index) {
+        const uint64_t word = words[index];
+
+        if (battery->run_length == 0) {
+            battery->run_length = 1;
+        } else if (word > battery->run_previous) {
+            ++battery->run_length;
+        } else {
+            ++battery->run_counts[battery->run_length < CRNG_TEST_RUN_BINS
+                                      ? battery->run_length - 1U
+                                      : CRNG_TEST_RUN_BINS - 1U];
+            battery->run_length = 0;
+        }
+        battery->run_previous = word;
+    }
+
+    for (index = 0; index < count; ++index) {
+        battery->birthdays[battery->birthday_fill++] = words[index] >> 25;
+        if (battery->birthday_fill == CRNG_TEST_BIRTHDAYS) {
+            crng_test_birthday_sample(battery);
+            battery->birthday_fill = 0;
+        }
+    }
+
+    /* Linear complexity of the lowest output bit. */
+    for (index = 0; index < count; ++index) {
+        const size_t fill = battery->lc_fill;
+
+        if (fill % 64U == 0) {
+            battery->lc_bits[fill / 64U] = 0;
+        }
+        battery->lc_bits[fill / 64U] |= (words[index] & 1U) << (fill % 64U);
+        if (++battery->lc_fill == CRNG_TEST_LC_BITS) {
+            crng_test_linear_complexity(battery);
+            battery->lc_fill = 0;
+        }
+    }
+}
+
+void crng_test_battery_merge(crng_test_battery *into, const crng_test_battery *from) {
+    size_t index;
+    size_t lane;
+
+    into->words += from->words;
+    for (lane = 0; lane < 8U; ++lane) {
+        for (index = 0; index < 256U; ++index) {
+            into->byte_counts[lane][index] += from->byte_counts[lane][index];
+        }
+    }
+    for (index = 0; index < 65536U; ++index) {
+        into->word16_counts[index] += from->word16_counts[index];
+        into->pair_counts[index] += from->pair_counts[index];
+    }
+    into->pairs += from->pairs;
+    into->serial_sum += from->serial_sum;
+    into->serial_terms += from->serial_terms;
+    for (index = 0; index < CRNG_TEST_GAP_BINS; ++index) {
+        into->gap_counts[index] += from->gap_counts[index];
+    }
+    for (index = 0; index < CRNG_TEST_RUN_BINS; ++index) {
+        into->run_counts[index] += from->run_counts[index];
+    }
+    for (index = 0; index < CRNG_TEST_BIRTHDAY_BINS; ++index) {
+        into->birthday_counts[index] += from->birthday_counts[index];
+    }
+    for (index = 0; index < 65U; ++index) {
+        into->popcount_counts[index] += from->popcount_counts[index];
+    }
+    for (index = 0; index < CRNG_TEST_LC_BINS; ++index) {
+        into->lc_counts[index] += from->lc_counts[index];
+    }
+}
+
+void crng_test_battery_finish(
+    const crng_test_battery *battery,
+    crng_test_result results[CRNG_TEST_BATTERY_TESTS]
+) {
+    static const double lc_probabilities[CRNG_TEST_LC_BINS] = {
+        1.0 / 96.0, 1.0 / 32.0, 1.0 / 8.0, 1.0 / 2.0, 1.0 / 4.0, 1.0 / 16.0, 1.0 / 48.0
+    };
+    uint64_t pooled[256];
+    uint64_t popcounts[CRNG_TEST_POPCOUNT_BINS];
+    double gap_probabilities[CRNG_TEST_GAP_BINS];
+    double run_probabilities[CRNG_TEST_RUN_BINS];
+    double birthday_probabilities[CRNG_TEST_BIRTHDAY_BINS];
+    double popcount_probabilities[CRNG_TEST_POPCOUNT_BINS];
+    double binomial[65];
+    double tail = 1.0;
+    double factorial = 1.0;
+    double poisson;
+    double statistic = 0.0;
+    double coefficient = 1.0;
+    size_t index;
+    size_t lane;
+
+    memset(pooled, 0, sizeof(pooled));
+    for (lane = 0; lane < 8U; ++lane) {
+        for (index = 0; index < 256U; ++index) {
+            pooled[index] += battery->byte_counts[lane][index];
+        }
+    }
+    crng_test_chi_square(&results[0], "byte_chi_square", pooled, NULL, 256U);
+
+    /* Bit frequency: one squared z-score per bit position, 64 degrees. */
+    for (lane = 0; lane < 8U; ++lane) {
+        unsigned int bit;
+
+        for (bit = 0; bit < 8U; ++bit) {
+            const double ones = (double)crng_test_lane_bit_ones(battery->byte_counts[lane], bit);
+            const double words = (double)battery->words;
+            const double z = words == 0.0 ? 0.0 : (2.0 * ones - words) / sqrt(words);
+
+            statistic += z * z;
+        }
+    }
+    crng_test_set_chi_square(&results[1], "bit_frequency", statistic, 64.0, battery->words);
+    if (battery->words < 100U) {
+        results[1].p_value = -1.0;
+    }
+
+    crng_test_chi_square(&results[2], "word16_chi_square", battery->word16_counts, NULL, 65536U);
+    crng_test_chi_square(&results[3], "pair_chi_square", battery->pair_counts, NULL, 65536U);
+
+    /* Each product of independent U(-1/2, 1/2) values has variance 1/144. */
+    if (battery->serial_terms < 100U) {
+        results[4].name = "serial_correlation";
+        results[4].statistic = 0.0;
+        results[4].degrees_of_freedom = 1.0;
+        results[4].p_value = -1.0;
+        results[4].samples = battery->serial_terms;
+    } else {
+        const double z = 12.0 * battery->serial_sum / sqrt((double)battery->serial_terms);
+
+        crng_test_set_chi_square(&results[4], "serial_correlation", z * z, 1.0,
+                                 battery->serial_terms);
+    }
+
+    for (index = 0; index + 1U < CRNG_TEST_GAP_BINS; ++index) {
+        gap_probabilities[index] = tail / 8.0;
+        tail *= 7.0 / 8.0;
+    }
+    gap_probabilities[CRNG_TEST_GAP_BINS - 1U] = tail;
+    crng_test_chi_square(&results[5], "gap", battery->gap_counts, gap_probabilities,
+                         CRNG_TEST_GAP_BINS);
+
+    /* P(run length k) = 1/k! - 1/(k + 1)!, with the last bin open-ended. */
+    for (index = 0; index + 1U < CRNG_TEST_RUN_BINS; ++index) {
+        const double current = factorial;
+
+        factorial *= (double)(index + 2U);
+        run_probabilities[index] = 1.0 / current - 1.0 / factorial;
+    }
+    run_probabilities[CRNG_TEST_RUN_BINS - 1U] = 1.0 / factorial;
+    crng_test_chi_square(&results[6], "runs_up", battery->run_counts, run_probabilities,
+                         CRNG_TEST_RUN_BINS);
+
+    poisson = exp(-2.0);
+    tail = 1.0;
+    for (index = 0; index + 1U < CRNG_TEST_BIRTHDAY_BINS; ++index) {
+        birthday_probabilities[index] = poisson;
+        tail -= poisson;
+        poisson *= 2.0 / (double)(index + 1U);
+    }
+    birthday_probabilities[CRNG_TEST_BIRTHDAY_BINS - 1U] = tail;
+    crng_test_chi_square(&results[7], "birthday_spacings", battery->birthday_counts,
+                         birthday_probabilities, CRNG_TEST_BIRTHDAY_BINS);
+
+    /* Popcount against Binomial(64, 1/2), tails pooled below 26 and above 38. */
+    for (index = 0; index <= 64U; ++index) {
+        binomial[index] = ldexp(coefficient, -64);
+        coefficient = coefficient * (double)(64U - index) / (double)(index + 1U);
+    }
+    memset(popcounts, 0, sizeof(popcounts));
+    memset(popcount_probabilities, 0, sizeof(popcount_probabilities));
+    for (index = 0; index <= 64U; ++index) {
+        const size_t bin = index <= 25U ? 0U : (index >= 39U ? 14U : index - 25U);
+
+        popcounts[bin] += battery->popcount_counts[index];
+        popcount_probabilities[bin] += binomial[index];
+    }
+    crng_test_chi_square(&results[8], "popcount", popcounts, popcount_probabilities,
+                         CRNG_TEST_POPCOUNT_BINS);
+
+    crng_test_chi_square(&results[9], "linear_complexity", battery->lc_counts, lc_probabilities,
+                         CRNG_TEST_LC_BINS);
+}
+
+int crng_test_battery_passed(
+    const crng_test_result results[CRNG_TEST_BATTERY_TESTS],
+    double alpha
+) {
+    size_t index;
+
+    for (index = 0; index < CRNG_TEST_BATTERY_TESTS; ++index) {
+        const double p = results[index].p_value;
+
+        if (p >= 0.0 && !(p >= alpha && p <= 1.0 - alpha)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+void crng_test_battery_print_json(
+    const crng_test_result results[CRNG_TEST_BATTERY_TESTS],
+    double alpha
+) {
+    size_t index;
+
+    printf("\"alpha\":%g,\"tests\":[", alpha);
+    for (index = 0; index < CRNG_TEST_BATTERY_TESTS; ++index) {
+        const crng_test_result *result = &results[index];
+
+        printf("%s{\"name\":\"%s\",\"samples\":%" PRIu64 ",\"df\":%.0f,",
+               index == 0 ? "" : ",",
+               result->name,
+               result->samples,
+               result->degrees_of_freedom);
+        if (result->p_value < 0.0) {
+            printf("\"statistic\":null,\"p_value\":null}");
+        } else {
+            printf("\"statistic\":%.10g,\"p_value\":%.10g}", result->statistic, result->p_value);
+        }
+    }
+    printf("],\"passed\":%s", crng_test_battery_passed(results, alpha) ? "true" : "false");
+}
@@ -25,4 +25,83 @@ void crng_test_print_json(
     const crng_test_distribution *report
 );
 
+/*
+ * Streaming battery. Words are fed in blocks of any size and only counts are
+ * kept, so memory stays fixed however long the stream runs. Independent
+ * shards each own a battery and are combined with crng_test_battery_merge
+ * before crng_test_battery_finish turns the counts into p-values.
+ */
+#define CRNG_TEST_BATTERY_TESTS 10
+#define CRNG_TEST_GAP_BINS 33
+#define CRNG_TEST_RUN_BINS 6
+#define CRNG_TEST_BIRTHDAYS 16384
+#define CRNG_TEST_BIRTHDAY_BINS 7
+#define CRNG_TEST_POPCOUNT_BINS 15
+#define CRNG_TEST_LC_BITS 512
+#define CRNG_TEST_LC_BINS 7
+
+/* p_value is negative when the stream was too short for the test. */
+typedef struct crng_test_result {
+    const char *name;
+    double statistic;
+    double degrees_of_freedom;
+    double p_value;
+    uint64_t samples;
+} crng_test_result;
+
+typedef struct crng_test_battery {
+    uint64_t words;
+    /* Mergeable counts. */
+    uint64_t byte_counts[8][256];
+    uint64_t word16_counts[65536];
+    uint64_t pair_counts[65536];
+    uint64_t pairs;
+    double serial_sum;
+    uint64_t serial_terms;
+    uint64_t gap_counts[CRNG_TEST_GAP_BINS];
+    uint64_t run_counts[CRNG_TEST_RUN_BINS];
+    uint64_t birthday_counts[CRNG_TEST_BIRTHDAY_BINS];
+    uint64_t popcount_counts[65];
+    uint64_t lc_counts[CRNG_TEST_LC_BINS];
+    /* Per-stream state; not merged. */
+    int has_previous;
+    uint64_t previous;
+    int has_pair;
+    unsigned int pair_high;
+    uint64_t gap_length;
+    uint64_t run_previous;
+    uint64_t run_length;
+    size_t birthday_fill;
+    uint64_t birthdays[CRNG_TEST_BIRTHDAYS];
+    uint64_t birthday_scratch[CRNG_TEST_BIRTHDAYS];
+    size_t lc_fill;
+    uint64_t lc_bits[CRNG_TEST_LC_BITS / 64];
+} crng_test_battery;
+
+void crng_test_battery_reset(crng_test_battery *battery);
+
+void crng_test_battery_update(
+    crng_test_battery *battery,
+    const uint64_t *words,
+    size_t count
+);
+
+void crng_test_battery_merge(crng_test_battery *into, const crng_test_battery *from);
+
+void crng_test_battery_finish(
+    const crng_test_battery *battery,
+    crng_test_result results[CRNG_TEST_BATTERY_TESTS]
+);
+
+/* Nonzero when every p-value lies within [alpha, 1 - alpha]. */
+int crng_test_battery_passed(
+    const crng_test_result results[CRNG_TEST_BATTERY_TESTS],
+    double alpha
+);
+
+void crng_test_battery_print_json(
+    const crng_test_result results[CRNG_TEST_BATTERY_TESTS],
+    double alpha
+);
+
 #endif /* CLASSICAL_RNG_STATISTICAL_TESTS_H */